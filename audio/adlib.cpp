@@ -947,6 +947,7 @@ public:
 	MidiChannel *getPercussionChannel() override { return &_percussion; } // Percussion partially supported
 
 	void setTimerCallback(void *timerParam, Common::TimerManager::TimerProc timerProc) override;
+	bool setRenderRecorder(Audio::MidiRenderRecorder *recorder) override { return _opl && _opl->setRenderRecorder(recorder); }
 
 private:
 	bool _scummSmallHeader; // FIXME: This flag controls a special mode for SCUMM V3 games
@@ -538,6 +538,10 @@ uint32 MidiDriver_ADLIB_Multisource::getBaseTempo() {
 	return _timerRate;
 }
 
+bool MidiDriver_ADLIB_Multisource::setRenderRecorder(Audio::MidiRenderRecorder *recorder) {
+	return _opl && _opl->setRenderRecorder(recorder);
+}
+
 MidiChannel *MidiDriver_ADLIB_Multisource::allocateChannel() {
 	// This driver does not use MidiChannel objects.
 	return nullptr;
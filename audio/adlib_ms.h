@@ -627,6 +627,7 @@ public:
 	void close() override;
 	uint32 property(int prop, uint32 param) override;
 	uint32 getBaseTempo() override;
+	bool setRenderRecorder(Audio::MidiRenderRecorder *recorder) override;
 	/**
 	 * This driver does not use MidiChannel objects, so this function returns nullptr.
 	 * 
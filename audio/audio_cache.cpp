@@ -0,0 +1,283 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/audio_cache.h"
+#include "audio/audiostream.h"
+
+#include "common/array.h"
+#include "common/config-manager.h"
+#include "common/debug.h"
+
+namespace Common {
+DECLARE_SINGLETON(Audio::AudioCache);
+}
+
+namespace Audio {
+
+/**
+ * Decoded samples of a clip, shared by the cache and the streams playing
+ * the clip. The reference count is changed from both the engine and the
+ * audio thread, hence the mutex.
+ */
+struct CachedAudioClip {
+	CachedAudioClip(int16 *samples_, uint32 numSamples_, int rate_, bool stereo_) :
+		samples(samples_), numSamples(numSamples_), rate(rate_), stereo(stereo_), refCount(1) {
+	}
+
+	~CachedAudioClip() {
+		delete[] samples;
+	}
+
+	void incRef() {
+		Common::StackLock lock(mutex);
+		refCount++;
+	}
+
+	void decRef() {
+		mutex.lock();
+		const bool unused = (--refCount == 0);
+		mutex.unlock();
+
+		if (unused)
+			delete this;
+	}
+
+	uint32 getSize() const { return numSamples * sizeof(int16); }
+
+	int16 *const samples;
+	const uint32 numSamples;
+	const int rate;
+	const bool stereo;
+
+	int refCount;
+	Common::Mutex mutex;
+};
+
+class CachedAudioStream : public SeekableAudioStream {
+public:
+	CachedAudioStream(CachedAudioClip *clip) : _clip(clip), _pos(0) {
+		_clip->incRef();
+	}
+
+	~CachedAudioStream() override {
+		_clip->decRef();
+	}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const uint32 count = MIN<uint32>(numSamples, _clip->numSamples - _pos);
+		memcpy(buffer, _clip->samples + _pos, count * sizeof(int16));
+		_pos += count;
+		return count;
+	}
+
+	bool isStereo() const override  { return _clip->stereo; }
+	bool endOfData() const override { return _pos >= _clip->numSamples; }
+
+	int getRate() const override { return _clip->rate; }
+	Timestamp getLength() const override { return Timestamp(0, _clip->numSamples / (_clip->stereo ? 2 : 1), _clip->rate); }
+
+	bool seek(const Timestamp &where) override {
+		const uint32 pos = convertTimeToStreamPos(where, _clip->rate, _clip->stereo).totalNumberOfFrames();
+		if (pos > _clip->numSamples)
+			return false;
+
+		_pos = pos;
+		return true;
+	}
+
+private:
+	CachedAudioClip *_clip;
+	uint32 _pos;
+};
+
+AudioCache::AudioCache() : _size(0), _maxSize(0), _confSize(-1), _accessCounter(0) {
+	memset(&_stats, 0, sizeof(_stats));
+
+	syncMaxSize();
+}
+
+AudioCache::~AudioCache() {
+	clear();
+}
+
+Common::String AudioCache::makeKey(const Common::Path &path, const Common::String &params) {
+	// Archive members are looked up ignoring the case
+	Common::String key = path.toString();
+	key.toLowercase();
+	return key + "|" + params;
+}
+
+SeekableAudioStream *AudioCache::open(const Common::String &key) {
+	syncMaxSize();
+
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it == _entries.end()) {
+		_stats.misses++;
+		return nullptr;
+	}
+
+	_stats.hits++;
+	it->_value.lastAccess = _accessCounter++;
+	return new CachedAudioStream(it->_value.clip);
+}
+
+SeekableAudioStream *AudioCache::add(const Common::String &key, SeekableAudioStream *stream) {
+	syncMaxSize();
+
+	uint32 maxSize;
+	{
+		Common::StackLock lock(_mutex);
+		maxSize = _maxSize;
+	}
+
+	const int rate = stream->getRate();
+	const bool stereo = stream->isStereo();
+	const uint32 channels = stereo ? 2 : 1;
+	const uint32 maxSamples = MIN<uint32>(kMaxClipLength * rate * channels, maxSize / sizeof(int16)) / channels * channels;
+
+	// Streams which know their length can be rejected without decoding them
+	const Timestamp length = stream->getLength();
+	if (!maxSamples || rate <= 0 || length.totalNumberOfFrames() * channels > maxSamples) {
+		Common::StackLock lock(_mutex);
+		_stats.rejected++;
+		return stream;
+	}
+
+	Common::Array<int16> samples;
+	uint32 numSamples = 0;
+	while (!stream->endOfData()) {
+		const uint32 count = MIN<uint32>(4096, maxSamples - numSamples);
+		if (!count) {
+			// Too long, play it from the original stream
+			stream->rewind();
+			Common::StackLock lock(_mutex);
+			_stats.rejected++;
+			return stream;
+		}
+
+		samples.resize(numSamples + count);
+		const int read = stream->readBuffer(samples.data() + numSamples, count);
+		if (read <= 0)
+			break;
+		numSamples += read;
+	}
+
+	delete stream;
+
+	int16 *data = new int16[MAX<uint32>(numSamples, 1)];
+	if (numSamples)
+		memcpy(data, samples.data(), numSamples * sizeof(int16));
+	CachedAudioClip *clip = new CachedAudioClip(data, numSamples, rate, stereo);
+
+	Common::StackLock lock(_mutex);
+
+	EntryMap::iterator it = _entries.find(key);
+	if (it != _entries.end())
+		dropEntry(it);
+
+	SeekableAudioStream *cachedStream = new CachedAudioStream(clip);
+
+	// The maximum size might have been lowered while decoding
+	if (clip->getSize() <= _maxSize) {
+		while (_size + clip->getSize() > _maxSize)
+			dropOldest();
+
+		Entry entry;
+		entry.clip = clip;
+		entry.lastAccess = _accessCounter++;
+		_entries[key] = entry;
+		_size += clip->getSize();
+	} else {
+		clip->decRef();
+	}
+
+	return cachedStream;
+}
+
+void AudioCache::setMaxSize(uint32 size) {
+	Common::StackLock lock(_mutex);
+
+	_maxSize = size;
+	while (_size > _maxSize)
+		dropOldest();
+}
+
+void AudioCache::syncMaxSize() {
+	// The size can be changed in the options while a game is running.
+	// A size set with setMaxSize() is kept until the setting changes.
+	const int confSize = ConfMan.getInt("audio_cache_size");
+
+	Common::StackLock lock(_mutex);
+	if (confSize == _confSize)
+		return;
+
+	_confSize = confSize;
+	_maxSize = MAX(confSize, 0) * 1024;
+	while (_size > _maxSize)
+		dropOldest();
+}
+
+void AudioCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it)
+		it->_value.clip->decRef();
+	_entries.clear();
+	_size = 0;
+}
+
+AudioCache::Stats AudioCache::getStats() const {
+	Common::StackLock lock(_mutex);
+
+	Stats stats = _stats;
+	stats.entries = _entries.size();
+	stats.size = _size;
+	stats.maxSize = _maxSize;
+	return stats;
+}
+
+void AudioCache::resetStats() {
+	Common::StackLock lock(_mutex);
+	memset(&_stats, 0, sizeof(_stats));
+}
+
+void AudioCache::dropOldest() {
+	EntryMap::iterator oldest = _entries.begin();
+	for (EntryMap::iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		if (it->_value.lastAccess < oldest->_value.lastAccess)
+			oldest = it;
+	}
+
+	debug(5, "AudioCache: Dropping %s", oldest->_key.c_str());
+	dropEntry(oldest);
+	_stats.evictions++;
+}
+
+void AudioCache::dropEntry(EntryMap::iterator it) {
+	// Streams still playing the clip keep it alive
+	_size -= it->_value.clip->getSize();
+	it->_value.clip->decRef();
+	_entries.erase(it);
+}
+
+} // End of namespace Audio
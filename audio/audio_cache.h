@@ -0,0 +1,128 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_AUDIO_CACHE_H
+#define AUDIO_AUDIO_CACHE_H
+
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/mutex.h"
+#include "common/path.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+namespace Audio {
+
+class SeekableAudioStream;
+struct CachedAudioClip;
+
+/**
+ * In-memory cache of decoded sound effects.
+ *
+ * Short clips which are played over and over, such as the footsteps or
+ * clicks of a game, are decoded once and kept as PCM. Each playback gets
+ * its own stream over the shared samples, so a clip can play several times
+ * at once, and stays valid when the clip is evicted from the cache.
+ *
+ * The cache holds at most "audio_cache_size" KB of samples, and drops the
+ * least recently used clips when it is full. The setting is checked again
+ * on every lookup, so changing it takes effect while a game is running.
+ * Setting the size to 0 disables it.
+ */
+class AudioCache : public Common::Singleton<AudioCache> {
+public:
+	struct Stats {
+		uint32 hits;       /*!< Number of clips found in the cache */
+		uint32 misses;     /*!< Number of clips not found in the cache */
+		uint32 evictions;  /*!< Number of clips dropped to make room */
+		uint32 rejected;   /*!< Number of clips too long to be cached */
+		uint32 entries;    /*!< Number of clips in the cache */
+		uint32 size;       /*!< Size of the cached samples, in bytes */
+		uint32 maxSize;    /*!< Maximum size of the cache, in bytes */
+	};
+
+	/**
+	 * Compute the cache key for a clip.
+	 *
+	 * @param path    The path of the file, or archive member, holding the clip.
+	 * @param params  Anything else affecting the decoding, such as the
+	 *                decoder or its parameters.
+	 */
+	static Common::String makeKey(const Common::Path &path, const Common::String &params);
+
+	/**
+	 * Open a new stream over a cached clip. Returns nullptr if the clip is
+	 * not in the cache.
+	 */
+	SeekableAudioStream *open(const Common::String &key);
+
+	/**
+	 * Decode a clip and add it to the cache.
+	 *
+	 * Takes ownership of the stream. If the clip can be cached, the stream
+	 * is deleted and a stream over the cached samples is returned. Otherwise,
+	 * e.g. because the clip is too long, the original stream is rewound and
+	 * returned.
+	 */
+	SeekableAudioStream *add(const Common::String &key, SeekableAudioStream *stream);
+
+	/** Set the maximum size of the cache, in bytes, dropping clips if needed. */
+	void setMaxSize(uint32 size);
+
+	/** Drop all clips. Streams over them stay valid. */
+	void clear();
+
+	Stats getStats() const;
+	void resetStats();
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	AudioCache();
+	~AudioCache();
+
+	enum {
+		kMaxClipLength = 10	// Maximum length of a cached clip, in seconds
+	};
+
+	struct Entry {
+		CachedAudioClip *clip;
+		uint32 lastAccess;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	void syncMaxSize();
+	void dropOldest();
+	void dropEntry(EntryMap::iterator it);
+
+	EntryMap _entries;
+	uint32 _size;
+	uint32 _maxSize;
+	int _confSize;
+	uint32 _accessCounter;
+	Stats _stats;
+
+	mutable Common::Mutex _mutex;
+};
+
+} // End of namespace Audio
+
+#endif
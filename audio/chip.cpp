@@ -20,7 +20,9 @@
  */
 
 #include "audio/chip.h"
+#include "audio/midi_render_cache.h"
 #include "audio/mixer.h"
+#include "audio/render_ahead.h"
 
 #include "common/timer.h"
 
@@ -97,7 +99,9 @@ EmulatedChip::EmulatedChip() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) { }
+	_handle(new Audio::SoundHandle()),
+	_renderAhead(nullptr),
+	_recorder(nullptr) { }
 
 EmulatedChip::~EmulatedChip() {
 	// Stop callbacks, just in case. If it's still playing at this
@@ -109,7 +113,21 @@ EmulatedChip::~EmulatedChip() {
 	delete _handle;
 }
 
+bool EmulatedChip::setRenderRecorder(MidiRenderRecorder *recorder) {
+	Common::StackLock lock(_recorderMutex);
+	_recorder = recorder;
+	if (_recorder)
+		_recorder->setFormat(getRate(), isStereo());
+	return true;
+}
+
 int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
+	if (_renderAhead)
+		return _renderAhead->readBuffer(buffer, numSamples);
+	return renderBuffer(buffer, numSamples);
+}
+
+int EmulatedChip::renderBuffer(int16 *buffer, int numSamples) {
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
 	int step;
@@ -121,6 +139,13 @@ int EmulatedChip::readBuffer(int16 *buffer, const int numSamples) {
 
 		generateSamples(buffer, step * stereoFactor);
 
+		// Record before the callback, which may end the recording
+		{
+			Common::StackLock lock(_recorderMutex);
+			if (_recorder)
+				_recorder->writeSamples(buffer, step * stereoFactor);
+		}
+
 		_nextTick -= step << FIXP_SHIFT;
 		if (!(_nextTick >> FIXP_SHIFT)) {
 			if (_callback && _callback->isValid())
@@ -142,11 +167,19 @@ int EmulatedChip::getRate() const {
 
 void EmulatedChip::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
+
+	uint msecs = RenderAhead::getConfiguredLength();
+	if (msecs)
+		_renderAhead = new RenderAhead(new Common::Functor2Mem<int16 *, int, int, EmulatedChip>(this, &EmulatedChip::renderBuffer), getRate(), isStereo(), msecs);
+
 	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedChip::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+
+	delete _renderAhead;
+	_renderAhead = nullptr;
 }
 
 void EmulatedChip::setCallbackFrequency(int timerFrequency) {
@@ -23,11 +23,14 @@
 #define AUDIO_CHIP_H
 
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
 
 #include "audio/audiostream.h"
 
 namespace Audio {
+class MidiRenderRecorder;
+class RenderAhead;
 class SoundHandle;
 
 class Chip {
@@ -55,6 +58,12 @@ public:
 	 */
 	virtual void setCallbackFrequency(int timerFrequency) = 0;
 
+	/**
+	 * Record the audio output of the chip, or stop recording if recorder
+	 * is nullptr. Returns false if the chip is not emulated.
+	 */
+	virtual bool setRenderRecorder(MidiRenderRecorder *recorder) { return false; }
+
 protected:
 	/**
 	 * Start the callbacks.
@@ -119,6 +128,7 @@ public:
 
 	// Chip API
 	void setCallbackFrequency(int timerFrequency) override;
+	bool setRenderRecorder(MidiRenderRecorder *recorder) override;
 
 	// AudioStream API
 	int readBuffer(int16 *buffer, const int numSamples) override;
@@ -143,12 +153,19 @@ protected:
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
 private:
+	/** Run the chip and the timer callbacks to produce samples. */
+	int renderBuffer(int16 *buffer, int numSamples);
+
 	int _baseFreq;
 
 	int _nextTick;
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+	Audio::RenderAhead *_renderAhead;
+
+	MidiRenderRecorder *_recorder;
+	Common::Mutex _recorderMutex;
 };
 
 } // End of namespace Audio
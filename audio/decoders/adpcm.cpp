@@ -20,6 +20,7 @@
  */
 
 #include "common/stream.h"
+#include "common/system.h"
 #include "common/textconsole.h"
 #include "common/util.h"
 
@@ -64,6 +65,34 @@ bool ADPCMStream::rewind() {
 	return true;
 }
 
+uint32 ADPCMStream::readBlock(byte *data) {
+	if (_stream->eos() || _stream->pos() >= _endpos)
+		return 0;
+
+	const uint32 size = MIN<uint32>(_blockAlign, _endpos - _stream->pos());
+	return _stream->read(data, size);
+}
+
+void interleaveStereo(const int16 *left, const int16 *right, int16 *dst, uint32 count) {
+	for (uint32 i = 0; i < count; i++) {
+		*dst++ = left[i];
+		*dst++ = right[i];
+	}
+}
+
+typedef void (*InterleaveStereoFunc)(const int16 *left, const int16 *right, int16 *dst, uint32 count);
+
+// Selected on first use, when the backend is fully set up
+static InterleaveStereoFunc interleaveStereoFunc = nullptr;
+
+void setInterleaveStereoSIMD(bool enable) {
+	interleaveStereoFunc = interleaveStereo;
+#ifdef SCUMMVM_SSE2
+	if (enable)
+		interleaveStereoFunc = interleaveStereoSSE2;
+#endif
+}
+
 
 #pragma mark -
 
@@ -310,43 +339,98 @@ int Apple_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 #pragma mark -
 
 
-int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	// Need to write at least one sample per channel
-	assert((numSamples % _channels) == 0);
+static inline int16 decodeIMANibble(int32 &last, int32 &stepIndex, byte code) {
+	int32 E = (2 * (code & 0x7) + 1) * Ima_ADPCMStream::_imaTable[stepIndex] / 8;
+	int32 diff = (code & 0x08) ? -E : E;
 
-	int samples = 0;
+	last = CLIP<int32>(last + diff, -32768, 32767);
+	stepIndex = CLIP<int32>(stepIndex + ADPCMStream::_stepAdjustTable[code], 0, ARRAYSIZE(Ima_ADPCMStream::_imaTable) - 1);
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
-			for (int i = 0; i < _channels; i++) {
-				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
-			}
+	return last;
+}
 
-			_blockPos[0] = _channels * 4;
-		}
+MSIma_ADPCMStream::MSIma_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
+	: Ima_ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign), _blockSampleCount(0), _blockSamplePos(0) {
+
+	if (blockAlign == 0)
+		error("MSIma_ADPCMStream(): blockAlign isn't specified");
+
+	if (blockAlign % (_channels * 4))
+		error("MSIma_ADPCMStream(): invalid blockAlign");
 
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
+	// Each byte after the header holds two samples
+	const uint32 channelSamples = (blockAlign / _channels - 4) * 2;
+
+	_blockData.resize(blockAlign);
+	_blockSamples.resize(channelSamples * _channels);
+	if (_channels == 2) {
+		_channelSamples[0].resize(channelSamples);
+		_channelSamples[1].resize(channelSamples);
+	}
+}
+
+bool MSIma_ADPCMStream::decodeBlock() {
+	_blockSampleCount = 0;
+	_blockSamplePos = 0;
+
+	const uint32 headerSize = _channels * 4;
+	const uint32 size = readBlock(_blockData.data());
+	if (size <= headerSize)
+		return false;
+
+	// The data is made of groups of four bytes per channel. A group cut
+	// short by the end of the data is completed with zero bytes, as the
+	// byte by byte reader did when reading past the end. Note that these
+	// still decode to non-zero deltas, they are not silence.
+	const uint32 groupSize = _channels * 4;
+	const uint32 groups = (size - headerSize + groupSize - 1) / groupSize;
+	memset(_blockData.data() + size, 0, headerSize + groups * groupSize - size);
+
+	const uint32 channelSamples = groups * 8;
+
+	for (int i = 0; i < _channels; i++) {
+		const byte *header = _blockData.data() + i * 4;
+		int32 last = (int16)READ_LE_UINT16(header);
+		int32 stepIndex = CLIP<int32>((int16)READ_LE_UINT16(header + 2), 0, ARRAYSIZE(_imaTable) - 1);
+
+		int16 *dst = (_channels == 2) ? _channelSamples[i].data() : _blockSamples.data();
+		const byte *src = _blockData.data() + headerSize + i * 4;
+
+		for (uint32 group = 0; group < groups; group++, src += groupSize) {
 			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
+				*dst++ = decodeIMANibble(last, stepIndex, src[j] & 0x0f);
+				*dst++ = decodeIMANibble(last, stepIndex, src[j] >> 4);
 			}
 		}
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
-			}
+		_status.ima_ch[i].last = last;
+		_status.ima_ch[i].stepIndex = stepIndex;
+	}
 
-			samples += _channels;
-		}
+	if (_channels == 2) {
+		if (!interleaveStereoFunc)
+			setInterleaveStereoSIMD(g_system->hasFeature(OSystem::kFeatureCpuSSE2));
+		interleaveStereoFunc(_channelSamples[0].data(), _channelSamples[1].data(), _blockSamples.data(), channelSamples);
+	}
+
+	_blockSampleCount = channelSamples * _channels;
+	return true;
+}
+
+int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	// Need to write at least one sample per channel
+	assert((numSamples % _channels) == 0);
+
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount && !decodeBlock())
+			break;
+
+		const uint32 count = MIN<uint32>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -387,46 +471,77 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 	return (int16)predictor;
 }
 
-int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
+MS_ADPCMStream::MS_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
+	: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign), _blockSampleCount(0), _blockSamplePos(0) {
+
+	if (blockAlign == 0)
+		error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
+
+	if (blockAlign < (uint32)_channels * 7)
+		error("MS_ADPCMStream(): invalid blockAlign");
+
+	memset(&_status, 0, sizeof(_status));
+
+	// Two samples per channel in the header, then two samples per byte
+	_blockData.resize(blockAlign);
+	_blockSamples.resize(_channels * 2 + (blockAlign - _channels * 7) * 2);
+}
+
+bool MS_ADPCMStream::decodeBlock() {
+	_blockSampleCount = 0;
+	_blockSamplePos = 0;
+
+	const uint32 headerSize = _channels * 7;
+	const uint32 size = readBlock(_blockData.data());
+	if (size < headerSize)
+		return false;
+
+	const byte *src = _blockData.data();
+	int16 *dst = _blockSamples.data();
 	int i;
 
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
+	for (i = 0; i < _channels; i++) {
+		_status.ch[i].predictor = CLIP(*src++, (byte)0, (byte)6);
+		_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
+		_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
+	}
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, src += 2)
+		_status.ch[i].delta = (int16)READ_LE_UINT16(src);
 
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, src += 2)
+		_status.ch[i].sample1 = (int16)READ_LE_UINT16(src);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
+	for (i = 0; i < _channels; i++, src += 2)
+		*dst++ = _status.ch[i].sample2 = (int16)READ_LE_UINT16(src);
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
+	for (i = 0; i < _channels; i++)
+		*dst++ = _status.ch[i].sample1;
 
-				_blockPos[0] = _channels * 7;
-			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
-			}
-			_decodedSampleIndex = 0;
-		}
+	// The high nibble belongs to the left channel, the low one to the right
+	// channel, or both to the only channel of mono streams
+	ADPCMChannelStatus *left = &_status.ch[0];
+	ADPCMChannelStatus *right = &_status.ch[_channels - 1];
+	for (const byte *end = _blockData.data() + size; src != end; src++) {
+		*dst++ = decodeMS(left, (*src >> 4) & 0x0f);
+		*dst++ = decodeMS(right, *src & 0x0f);
+	}
 
-		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
-		_decodedSampleCount--;
+	_blockSampleCount = dst - _blockSamples.data();
+	return true;
+}
+
+int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (_blockSamplePos == _blockSampleCount && !decodeBlock())
+			break;
+
+		const uint32 count = MIN<uint32>(numSamples - samples, _blockSampleCount - _blockSamplePos);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSamplePos, count * sizeof(int16));
+		_blockSamplePos += count;
+		samples += count;
 	}
 
 	return samples;
@@ -546,15 +661,7 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 };
 
 int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
-	int32 E = (2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex] / 8;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
-
-	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
-
-	return samp;
+	return decodeIMANibble(_status.ima_ch[channel].last, _status.ima_ch[channel].stepIndex, code);
 }
 
 SeekableAudioStream *makeADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
@@ -31,6 +31,7 @@
 #define AUDIO_ADPCM_INTERN_H
 
 #include "audio/audiostream.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/ptr.h"
 #include "common/stream.h"
@@ -38,6 +39,21 @@
 
 namespace Audio {
 
+/**
+ * Interleave the samples of two channels into a stereo buffer.
+ */
+void interleaveStereo(const int16 *left, const int16 *right, int16 *dst, uint32 count);
+
+#ifdef SCUMMVM_SSE2
+void interleaveStereoSSE2(const int16 *left, const int16 *right, int16 *dst, uint32 count);
+#endif
+
+/**
+ * Select the stereo interleaving used by the block decoders. By default
+ * the CPU features are queried from the backend on first use.
+ */
+void setInterleaveStereoSIMD(bool enable);
+
 class ADPCMStream : public SeekableAudioStream {
 protected:
 	Common::DisposablePtr<Common::SeekableReadStream> _stream;
@@ -59,6 +75,14 @@ protected:
 
 	virtual void reset();
 
+	/**
+	 * Read the next block of at most _blockAlign bytes into data, without
+	 * going past the end of the audio data.
+	 *
+	 * @return The number of bytes read.
+	 */
+	uint32 readBlock(byte *data);
+
 public:
 	ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
@@ -171,32 +195,31 @@ public:
 
 };
 
+/**
+ * Microsoft IMA ADPCM, decoded a whole block at a time.
+ */
 class MSIma_ADPCMStream : public Ima_ADPCMStream {
 public:
-	MSIma_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
-		: Ima_ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {
-
-		if (blockAlign == 0)
-			error("MSIma_ADPCMStream(): blockAlign isn't specified");
+	MSIma_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
-		if (blockAlign % (_channels * 4))
-			error("MSIma_ADPCMStream(): invalid blockAlign");
-
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
-	}
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && _blockSamplePos == _blockSampleCount; }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 	void reset() {
 		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
 	}
 
 private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	bool decodeBlock();
+
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _channelSamples[2]; // Planar samples of a stereo block
+	Common::Array<int16> _blockSamples;      // Interleaved samples of the block
+	uint32 _blockSampleCount;
+	uint32 _blockSamplePos;
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -218,19 +241,14 @@ protected:
 	void reset() {
 		ADPCMStream::reset();
 		memset(&_status, 0, sizeof(_status));
+		_blockSampleCount = 0;
+		_blockSamplePos = 0;
 	}
 
 public:
-	MS_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
-		: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {
-		if (blockAlign == 0)
-			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
-		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
-		_decodedSampleIndex = 0;
-	}
+	MS_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && _blockSamplePos == _blockSampleCount; }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
@@ -238,9 +256,12 @@ protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
 
 private:
-	uint8 _decodedSampleCount;
-	uint8 _decodedSampleIndex;
-	int16 _decodedSamples[4];
+	bool decodeBlock();
+
+	Common::Array<byte> _blockData;
+	Common::Array<int16> _blockSamples;
+	uint32 _blockSampleCount;
+	uint32 _blockSamplePos;
 };
 
 // Duck DK3 IMA ADPCM Decoder
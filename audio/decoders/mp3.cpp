@@ -23,6 +23,7 @@
 
 #ifdef USE_MAD
 
+#include "common/array.h"
 #include "common/debug.h"
 #include "common/mutex.h"
 #include "common/ptr.h"
@@ -90,6 +91,11 @@ protected:
 
 	// This buffer contains a slab of input data
 	byte _buf[BUFFER_SIZE + MAD_BUFFER_GUARD];
+
+	/** Return the position in the stream of the frame decoded last. */
+	uint32 getFramePos(Common::SeekableReadStream &stream) const {
+		return stream.pos() - (_stream.bufend - _stream.this_frame);
+	}
 };
 
 class MP3Stream : private BaseMP3Stream, public SeekableAudioStream {
@@ -108,6 +114,23 @@ protected:
 
 private:
 	static Common::SeekableReadStream *skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose);
+
+	enum {
+		kSeekIndexInterval = 16	// Number of frames between two seek points
+	};
+
+	struct SeekPoint {
+		mad_timer_t time;	///< Start time of the frame
+		uint32 pos;			///< Position of the frame in the stream
+	};
+
+	/**
+	 * Start times and positions of every kSeekIndexInterval-th frame,
+	 * collected while calculating the length of the stream.
+	 */
+	Common::Array<SeekPoint> _seekIndex;
+
+	const SeekPoint *findSeekPoint(const mad_timer_t &destination) const;
 };
 
 class PacketizedMP3Stream : private BaseMP3Stream, public PacketizedAudioStream {
@@ -336,10 +359,22 @@ MP3Stream::MP3Stream(Common::SeekableReadStream *inStream, DisposeAfterUse::Flag
 	_channels = MAD_NCHANNELS(&_frame.header);
 	_rate = _frame.header.samplerate;
 
-	// Calculate the length of the stream
-	while (_state != MP3_STATE_EOS)
+	// Calculate the length of the stream, and build the seek index. The
+	// first frame has already been decoded, and starts at the beginning.
+	SeekPoint start = { mad_timer_zero, 0 };
+	_seekIndex.push_back(start);
+
+	uint32 frame = 1;
+	while (_state != MP3_STATE_EOS) {
+		mad_timer_t frameTime = _curTime;
 		readHeader(*_inStream);
 
+		if (_state != MP3_STATE_EOS && (frame++ % kSeekIndexInterval) == 0) {
+			SeekPoint point = { frameTime, getFramePos(*_inStream) };
+			_seekIndex.push_back(point);
+		}
+	}
+
 	// To rule out any invalid sample rate to be encountered here, say in case the
 	// MP3 stream is invalid, we just check the MAD error code here.
 	// We need to assure this, since else we might trigger an assertion in Timestamp
@@ -376,9 +411,15 @@ bool MP3Stream::seek(const Timestamp &where) {
 	mad_timer_t destination;
 	mad_timer_set(&destination, time / 1000, time % 1000, 1000);
 
-	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0) {
-		_inStream->seek(0);
+	// Restart at the closest seek point before the destination, unless the
+	// current position is closer
+	const SeekPoint *point = findSeekPoint(destination);
+	if (_state != MP3_STATE_READY || mad_timer_compare(destination, _curTime) < 0 ||
+	    (point && mad_timer_compare(point->time, _curTime) > 0)) {
+		_inStream->seek(point ? point->pos : 0);
 		initStream(*_inStream);
+		if (point)
+			_curTime = point->time;
 	}
 
 	while (mad_timer_compare(destination, _curTime) > 0 && _state != MP3_STATE_EOS)
@@ -389,6 +430,23 @@ bool MP3Stream::seek(const Timestamp &where) {
 	return (_state != MP3_STATE_EOS);
 }
 
+const MP3Stream::SeekPoint *MP3Stream::findSeekPoint(const mad_timer_t &destination) const {
+	if (_seekIndex.empty() || mad_timer_compare(_seekIndex[0].time, destination) > 0)
+		return nullptr;
+
+	// Binary search for the last seek point not after the destination
+	uint first = 0, last = _seekIndex.size() - 1;
+	while (first < last) {
+		uint mid = (first + last + 1) / 2;
+		if (mad_timer_compare(_seekIndex[mid].time, destination) <= 0)
+			first = mid;
+		else
+			last = mid - 1;
+	}
+
+	return &_seekIndex[first];
+}
+
 Common::SeekableReadStream *MP3Stream::skipID3(Common::SeekableReadStream *stream, DisposeAfterUse::Flag dispose) {
 	// Skip ID3 TAG if any
 	// ID3v1 (beginning with with 'TAG') is located at the end of files. So we can ignore those.
@@ -0,0 +1,395 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/midi_render_cache.h"
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/decoders/raw.h"
+
+#include "common/config-manager.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "common/md5.h"
+#include "common/substream.h"
+#include "common/system.h"
+#include "common/singleton.h"
+#include "common/timer.h"
+#include "common/compression/deflate.h"
+
+namespace Audio {
+
+enum {
+	kCacheHeaderSize = 17,
+	kCacheVersion = 2
+};
+
+/**
+ * Does the background work of the recorders from a timer callback: topping
+ * up the spare chunks of recordings in progress, and writing complete ones
+ * to the cache. The timer proc removes itself once there is nothing left
+ * to do, so nobody ever waits in removeTimerProc().
+ */
+class MidiRenderWorker : public Common::Singleton<MidiRenderWorker> {
+public:
+	void addRecorder(MidiRenderRecorder *recorder);
+	void removeRecorder(MidiRenderRecorder *recorder);
+	/** Queue a recording to be saved. The worker deletes it afterwards. */
+	void queueSave(MidiRenderRecorder *recorder);
+
+private:
+	friend class Common::Singleton<SingletonBaseType>;
+	MidiRenderWorker() : _timerInstalled(false) {}
+
+	enum {
+		kTimerInterval = 100000,	// 100 ms
+		kSaveBudget = 10			// Time spent writing recordings per call, in ms
+	};
+
+	static void timerProc(void *refCon);
+	void run();
+	void startTimer();
+
+	/** Recordings in progress, whose spare chunks are topped up. */
+	Common::Array<MidiRenderRecorder *> _recorders;
+	/** Complete recordings waiting to be written, owned by the worker. */
+	Common::Array<MidiRenderRecorder *> _saves;
+	bool _timerInstalled;
+	Common::Mutex _mutex;
+};
+
+} // End of namespace Audio
+
+namespace Common {
+DECLARE_SINGLETON(Audio::MidiRenderWorker);
+}
+
+namespace Audio {
+
+void MidiRenderWorker::addRecorder(MidiRenderRecorder *recorder) {
+	{
+		Common::StackLock lock(_mutex);
+		_recorders.push_back(recorder);
+	}
+	startTimer();
+}
+
+void MidiRenderWorker::removeRecorder(MidiRenderRecorder *recorder) {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _recorders.size(); i++) {
+		if (_recorders[i] == recorder) {
+			_recorders.remove_at(i);
+			break;
+		}
+	}
+}
+
+void MidiRenderWorker::queueSave(MidiRenderRecorder *recorder) {
+	removeRecorder(recorder);
+	{
+		Common::StackLock lock(_mutex);
+		_saves.push_back(recorder);
+	}
+	startTimer();
+}
+
+void MidiRenderWorker::startTimer() {
+	{
+		Common::StackLock lock(_mutex);
+		if (_timerInstalled)
+			return;
+		_timerInstalled = true;
+	}
+
+	// Installing takes the timer mutex, which the timer thread holds while
+	// waiting for ours
+	g_system->getTimerManager()->installTimerProc(&timerProc, kTimerInterval, nullptr, "MidiRenderRecorder");
+}
+
+void MidiRenderWorker::timerProc(void *refCon) {
+	instance().run();
+}
+
+void MidiRenderWorker::run() {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _recorders.size(); i++)
+		_recorders[i]->allocateChunks();
+
+	const uint32 deadline = g_system->getMillis() + kSaveBudget;
+	while (!_saves.empty() && _saves.front()->writeChunks(deadline)) {
+		delete _saves.front();
+		_saves.remove_at(0);
+	}
+
+	if (_recorders.empty() && _saves.empty()) {
+		_recorders.clear();
+		_saves.clear();
+
+		// This is the timer thread, which already holds the timer mutex
+		_timerInstalled = false;
+		g_system->getTimerManager()->removeTimerProc(&timerProc);
+	}
+}
+
+bool MidiRenderCache::isEnabled() {
+	return ConfMan.getBool("midi_render_cache") && !ConfMan.getPath("cachepath").empty();
+}
+
+Common::String MidiRenderCache::makeKey(const byte *data, uint32 size, const Common::String &settings) {
+	// Everything which changes the output of the synth is part of the key
+	Common::String config = settings;
+	static const char *const keys[] = {
+		"music_driver", "gm_device", "mt32_device", "opl_driver", "native_mt32",
+		"enable_gs", "midi_gain", "soundfont", "extrapath", nullptr
+	};
+	for (const char *const *k = keys; *k; k++) {
+		config += Common::String::format(";%s=%s", *k, ConfMan.hasKey(*k) ? ConfMan.get(*k).c_str() : "");
+	}
+	config += Common::String::format(";rate=%u", g_system->getMixer()->getOutputRate());
+
+	Common::MemoryReadStream dataStream(data, size);
+	Common::String dataHash = Common::computeStreamMD5AsString(dataStream);
+
+	Common::MemoryReadStream configStream((const byte *)config.c_str(), config.size());
+	return dataHash + Common::computeStreamMD5AsString(configStream);
+}
+
+Common::FSNode MidiRenderCache::getFile(const Common::String &key) {
+	return Common::FSNode(ConfMan.getPath("cachepath").join("midi")).getChild("midicache-" + key + ".pcm");
+}
+
+SeekableAudioStream *MidiRenderCache::openTrack(const Common::String &key) {
+	Common::FSNode node = getFile(key);
+	if (!node.exists())
+		return nullptr;
+
+	Common::SeekableReadStream *in = Common::wrapCompressedReadStream(node.createReadStream());
+	if (!in)
+		return nullptr;
+
+	uint32 tag = in->readUint32BE();
+	uint32 version = in->readUint32LE();
+	uint32 rate = in->readUint32LE();
+	byte stereo = in->readByte();
+	uint32 length = in->readUint32LE();
+
+	// A file which was not written completely is ignored
+	if (in->err() || tag != MKTAG('M', 'R', 'C', 'H') || version != kCacheVersion || !rate ||
+		in->size() != kCacheHeaderSize + (int64)length * 2) {
+		delete in;
+		return nullptr;
+	}
+
+	Common::SeekableReadStream *pcm = new Common::SeekableSubReadStream(in, kCacheHeaderSize, in->size(), DisposeAfterUse::YES);
+	return makeRawStream(pcm, rate, FLAG_16BITS | FLAG_LITTLE_ENDIAN | (stereo ? FLAG_STEREO : 0));
+}
+
+MidiRenderRecorder::MidiRenderRecorder(const Common::String &key) :
+	_key(key), _rate(0), _stereo(false), _lastChunkSize(0), _length(0),
+	_state(kStateRecording), _valid(true), _tailLength(0), _silenceLength(0),
+	_out(nullptr), _savedChunks(0) {
+
+	for (uint i = 0; i < kSpareChunks; i++)
+		_spareChunks.push_back(new int16[kChunkSize]);
+
+	MidiRenderWorker::instance().addRecorder(this);
+}
+
+MidiRenderRecorder::~MidiRenderRecorder() {
+	MidiRenderWorker::instance().removeRecorder(this);
+
+	delete _out;
+
+	for (uint i = 0; i < _chunks.size(); i++)
+		delete[] _chunks[i];
+	for (uint i = 0; i < _spareChunks.size(); i++)
+		delete[] _spareChunks[i];
+}
+
+void MidiRenderRecorder::allocateChunks() {
+	uint missing;
+	{
+		Common::StackLock lock(_mutex);
+		if (_state == kStateComplete || !_valid || _spareChunks.size() >= kSpareChunks)
+			return;
+		missing = kSpareChunks - _spareChunks.size();
+	}
+
+	while (missing--) {
+		int16 *chunk = new int16[kChunkSize];
+
+		Common::StackLock lock(_mutex);
+		_spareChunks.push_back(chunk);
+	}
+}
+
+void MidiRenderRecorder::setFormat(int rate, bool stereo) {
+	Common::StackLock lock(_mutex);
+
+	// The format must not change during a recording
+	if (_rate && (_rate != rate || _stereo != stereo))
+		_valid = false;
+
+	_rate = rate;
+	_stereo = stereo;
+
+	// Make sure that adding chunks never reallocates the array
+	_chunks.reserve(((uint32)kMaxLength + kMaxTailLength) * _rate * (_stereo ? 2 : 1) / kChunkSize + 1);
+}
+
+int MidiRenderRecorder::findTailEnd(const int16 *data, int numSamples) {
+	const uint32 silence = (uint32)_rate * (_stereo ? 2 : 1) * kTailSilence / 1000;
+	const uint32 maxTail = (uint32)_rate * (_stereo ? 2 : 1) * kMaxTailLength;
+
+	for (int i = 0; i < numSamples; i++) {
+		if (ABS(data[i]) <= kSilenceThreshold)
+			_silenceLength++;
+		else
+			_silenceLength = 0;
+
+		if (_silenceLength >= silence || ++_tailLength >= maxTail) {
+			_state = kStateComplete;
+			return i + 1;
+		}
+	}
+
+	return numSamples;
+}
+
+void MidiRenderRecorder::writeSamples(const int16 *data, int numSamples) {
+	Common::StackLock lock(_mutex);
+
+	if (_state == kStateComplete || !_valid || !_rate)
+		return;
+
+	if (_state == kStateTail)
+		numSamples = findTailEnd(data, numSamples);
+	else if (_length + numSamples > (uint32)kMaxLength * _rate * (_stereo ? 2 : 1))
+		_valid = false;
+
+	while (_valid && numSamples > 0) {
+		if (_chunks.empty() || _lastChunkSize == kChunkSize) {
+			// Never allocate here, this is the audio thread
+			if (_spareChunks.empty()) {
+				_valid = false;
+				break;
+			}
+
+			_chunks.push_back(_spareChunks.back());
+			_spareChunks.pop_back();
+			_lastChunkSize = 0;
+		}
+
+		const uint len = MIN<uint>(numSamples, kChunkSize - _lastChunkSize);
+		memcpy(_chunks.back() + _lastChunkSize, data, len * sizeof(int16));
+
+		_lastChunkSize += len;
+		_length += len;
+		data += len;
+		numSamples -= len;
+	}
+}
+
+void MidiRenderRecorder::complete(bool recordTail) {
+	Common::StackLock lock(_mutex);
+
+	if (_state == kStateRecording)
+		_state = recordTail ? kStateTail : kStateComplete;
+}
+
+void MidiRenderRecorder::invalidate() {
+	Common::StackLock lock(_mutex);
+	_valid = false;
+}
+
+bool MidiRenderRecorder::isComplete() const {
+	Common::StackLock lock(_mutex);
+	return _state != kStateRecording && _valid;
+}
+
+void MidiRenderRecorder::save(MidiRenderRecorder *recorder) {
+	{
+		Common::StackLock lock(recorder->_mutex);
+
+		// A release tail which is still being recorded is cut here
+		if (recorder->_state == kStateRecording || !recorder->_valid || !recorder->_length) {
+			delete recorder;
+			return;
+		}
+	}
+
+	MidiRenderWorker::instance().queueSave(recorder);
+}
+
+bool MidiRenderRecorder::writeChunks(uint32 deadline) {
+	Common::StackLock lock(_mutex);
+
+	if (!_out) {
+		Common::FSNode dir(ConfMan.getPath("cachepath").join("midi"));
+		if (!dir.exists() && !dir.createDirectory())
+			return true;
+
+		_out = Common::wrapCompressedWriteStream(MidiRenderCache::getFile(_key).createWriteStream());
+		if (!_out)
+			return true;
+
+		_out->writeUint32BE(MKTAG('M', 'R', 'C', 'H'));
+		_out->writeUint32LE(kCacheVersion);
+		_out->writeUint32LE(_rate);
+		_out->writeByte(_stereo ? 1 : 0);
+		_out->writeUint32LE(_length);
+	}
+
+	// Write at least one chunk per call, so that the recording is finished
+	// even if every call overruns the deadline
+	do {
+		if (_savedChunks == _chunks.size() || _out->err())
+			break;
+
+		int16 *chunk = _chunks[_savedChunks];
+		const uint size = (_savedChunks == _chunks.size() - 1) ? _lastChunkSize : (uint)kChunkSize;
+
+#ifndef SCUMM_LITTLE_ENDIAN
+		// The chunk is not needed after this, so it is swapped in place
+		for (uint i = 0; i < size; i++)
+			chunk[i] = TO_LE_16(chunk[i]);
+#endif
+		_out->write(chunk, size * sizeof(int16));
+
+		// Release the memory as soon as possible
+		delete[] chunk;
+		_chunks[_savedChunks++] = nullptr;
+	} while (g_system->getMillis() < deadline);
+
+	if (_savedChunks < _chunks.size() && !_out->err())
+		return false;
+
+	_out->finalize();
+	delete _out;
+	_out = nullptr;
+
+	// The samples are not needed anymore
+	_valid = false;
+	return true;
+}
+
+} // End of namespace Audio
@@ -0,0 +1,187 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_MIDI_RENDER_CACHE_H
+#define AUDIO_MIDI_RENDER_CACHE_H
+
+#include "common/array.h"
+#include "common/fs.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+namespace Common {
+class WriteStream;
+}
+
+namespace Audio {
+
+class SeekableAudioStream;
+
+/**
+ * Cache of MIDI tracks rendered by emulated synths.
+ *
+ * Emulated synths are deterministic, so a track played with the same
+ * driver and settings always produces the same audio. The output of the
+ * first complete, unmodified playback of a track is recorded and stored
+ * as compressed PCM in the "midi" directory of the cache path, and later
+ * playbacks can stream it instead of running the synth.
+ *
+ * The cache is disabled unless the "midi_render_cache" setting is enabled
+ * and a cache path is available.
+ */
+class MidiRenderCache {
+public:
+	/** Return whether the render cache is enabled in the configuration. */
+	static bool isEnabled();
+
+	/**
+	 * Compute the cache key for a track, from its MIDI data and the
+	 * settings affecting the output of the synth.
+	 *
+	 * @param data      The MIDI data of the track.
+	 * @param size      The size of the MIDI data.
+	 * @param settings  Any additional state affecting the rendering, such as
+	 *                  the master volume.
+	 */
+	static Common::String makeKey(const byte *data, uint32 size, const Common::String &settings);
+
+	/**
+	 * Open a cached rendering of a track. Returns nullptr if the track has
+	 * not been cached.
+	 */
+	static SeekableAudioStream *openTrack(const Common::String &key);
+
+	/** Return the node of the file a track is cached in. */
+	static Common::FSNode getFile(const Common::String &key);
+};
+
+/**
+ * Records the output of an emulated synth, to be stored in the
+ * MidiRenderCache.
+ *
+ * Samples are passed in from the thread rendering the synth, and kept in
+ * memory until the recording is saved. They are stored in fixed size
+ * chunks, which are allocated ahead of time from a timer callback, so the
+ * rendering thread never allocates memory. A recording which is
+ * invalidated, exceeds the maximum length, or runs out of allocated
+ * chunks, is never saved.
+ *
+ * Complete recordings are written to the cache from the same timer
+ * callback, so the engine never waits for the file to be written. The
+ * timer callback is only installed while there are recorders.
+ */
+class MidiRenderRecorder {
+public:
+	MidiRenderRecorder(const Common::String &key);
+	~MidiRenderRecorder();
+
+	/** Set the format of the recorded samples. Called by the driver. */
+	void setFormat(int rate, bool stereo);
+
+	/**
+	 * Append samples to the recording. Called by the driver, between the
+	 * timer callbacks, so that complete() cuts the recording at the exact
+	 * sample.
+	 */
+	void writeSamples(const int16 *data, int numSamples);
+
+	/**
+	 * Mark the recording as complete. This may be called from the audio
+	 * thread.
+	 *
+	 * @param recordTail  Whether to keep recording until the synth falls
+	 *                    silent, so that the release of the last notes is
+	 *                    not cut. This must be false for looping tracks,
+	 *                    whose start follows the end immediately.
+	 */
+	void complete(bool recordTail);
+
+	/**
+	 * Discard the recording, e.g. because the playback of the track was
+	 * modified at runtime.
+	 */
+	void invalidate();
+
+	bool isComplete() const;
+
+	/**
+	 * Store a complete recording in the cache and delete the recorder.
+	 * The recording is written in the background, and an incomplete or
+	 * invalid one is deleted right away. The recorder must already be
+	 * detached from the driver.
+	 */
+	static void save(MidiRenderRecorder *recorder);
+
+private:
+	friend class MidiRenderWorker;
+
+	enum {
+		kMaxLength = 5 * 60,		// Maximum length of a recording, in seconds
+		kMaxTailLength = 5,			// Maximum length of the release tail, in seconds
+		kTailSilence = 50,			// Silence ending the release tail, in ms
+		kSilenceThreshold = 4,		// Samples this close to zero count as silence
+		kChunkSize = 64 * 1024,		// Samples per chunk
+		kSpareChunks = 4			// Chunks allocated ahead of the recording
+	};
+
+	enum State {
+		kStateRecording,
+		kStateTail,
+		kStateComplete
+	};
+
+	/** Top up the spare chunks. Called from the timer callback. */
+	void allocateChunks();
+	/**
+	 * Write recorded chunks to the cache until the deadline has passed.
+	 * Called from the timer callback. Returns false while there are chunks
+	 * left to write.
+	 */
+	bool writeChunks(uint32 deadline);
+	/** Return the number of samples of data belonging to the release tail. */
+	int findTailEnd(const int16 *data, int numSamples);
+
+	Common::String _key;
+	int _rate;
+	bool _stereo;
+
+	/** The recorded chunks. All but the last one are full. */
+	Common::Array<int16 *> _chunks;
+	/** Chunks allocated for the recording to continue into. */
+	Common::Array<int16 *> _spareChunks;
+	uint _lastChunkSize;
+	uint32 _length;
+
+	State _state;
+	bool _valid;
+	uint32 _tailLength;
+	uint32 _silenceLength;
+
+	Common::WriteStream *_out;
+	/** Number of chunks written to _out so far. */
+	uint _savedChunks;
+
+	mutable Common::Mutex _mutex;
+};
+
+} // End of namespace Audio
+
+#endif
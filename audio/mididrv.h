@@ -30,6 +30,10 @@
 
 class MidiChannel;
 
+namespace Audio {
+class MidiRenderRecorder;
+}
+
 /**
  * @defgroup audio_mididrv MIDI drivers
  * @ingroup audio
@@ -506,6 +510,15 @@ public:
 	/** The time in microseconds between invocations of the timer callback. */
 	virtual uint32 getBaseTempo() = 0;
 
+	/**
+	 * Record the audio output of the driver, or stop recording if recorder
+	 * is nullptr. The driver does not take ownership of the recorder.
+	 *
+	 * @return False if the output of the driver cannot be recorded, e.g.
+	 *         because it is not emulated.
+	 */
+	virtual bool setRenderRecorder(Audio::MidiRenderRecorder *recorder) { return false; }
+
 	// Channel allocation functions
 	virtual MidiChannel *allocateChannel() = 0;
 	virtual MidiChannel *getPercussionChannel() = 0;
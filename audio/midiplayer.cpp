@@ -21,8 +21,11 @@
 
 #include "audio/midiplayer.h"
 #include "audio/midiparser.h"
+#include "audio/midi_render_cache.h"
+#include "audio/audiostream.h"
 
 #include "common/config-manager.h"
+#include "common/system.h"
 
 namespace Audio {
 
@@ -33,7 +36,11 @@ MidiPlayer::MidiPlayer() :
 	_isLooping(false),
 	_isPlaying(false),
 	_masterVolume(0),
-	_nativeMT32(false) {
+	_nativeMT32(false),
+	_cacheRecorder(nullptr),
+	_isPlayingCached(false),
+	_cacheVolume(0),
+	_isParsing(false) {
 
 	memset(_channelsTable, 0, sizeof(_channelsTable));
 	memset(_channelsVolume, 127, sizeof(_channelsVolume));
@@ -47,6 +54,7 @@ MidiPlayer::~MidiPlayer() {
 	// Hopefully, this make no real difference, but we should
 	// watch out for regressions.
 	stop();
+	saveCachedTrack();
 
 	// Unhook & unload the driver
 	if (_driver) {
@@ -67,6 +75,65 @@ void MidiPlayer::createDriver(int flags) {
 		_driver->property(MidiDriver::PROP_CHANNEL_MASK, 0x03FE);
 }
 
+bool MidiPlayer::playCachedTrack(const byte *data, uint32 size) {
+	saveCachedTrack();
+
+	// A track rendered at zero volume is not worth caching
+	if (!_driver || !data || !_masterVolume || !MidiRenderCache::isEnabled())
+		return false;
+
+	// Looping tracks are recorded without the release of their last notes
+	Common::String key = MidiRenderCache::makeKey(data, size, Common::String::format("volume=%d;loop=%d", _masterVolume, _isLooping));
+
+	SeekableAudioStream *stream = MidiRenderCache::openTrack(key);
+	if (stream) {
+		Common::StackLock lock(_mutex);
+
+		Mixer *mixer = g_system->getMixer();
+		mixer->stopHandle(_cacheHandle);
+		mixer->playStream(Mixer::kPlainSoundType, &_cacheHandle, makeLoopingAudioStream(stream, _isLooping ? 0 : 1), -1, Mixer::kMaxChannelVolume);
+
+		_cacheVolume = _masterVolume;
+		_isPlayingCached = true;
+		_isPlaying = true;
+		return true;
+	}
+
+	MidiRenderRecorder *recorder = new MidiRenderRecorder(key);
+	if (!_driver->setRenderRecorder(recorder)) {
+		delete recorder;
+		return false;
+	}
+
+	Common::StackLock lock(_mutex);
+	_cacheRecorder = recorder;
+	return false;
+}
+
+void MidiPlayer::invalidateCachedTrack() {
+	Common::StackLock lock(_mutex);
+
+	if (_cacheRecorder) {
+		_driver->setRenderRecorder(nullptr);
+		delete _cacheRecorder;
+		_cacheRecorder = nullptr;
+	}
+}
+
+void MidiPlayer::saveCachedTrack() {
+	MidiRenderRecorder *recorder;
+	{
+		Common::StackLock lock(_mutex);
+		recorder = _cacheRecorder;
+		_cacheRecorder = nullptr;
+	}
+
+	if (recorder) {
+		_driver->setRenderRecorder(nullptr);
+		MidiRenderRecorder::save(recorder);
+	}
+}
+
 
 void MidiPlayer::setVolume(int volume) {
 	volume = CLIP(volume, 0, 255);
@@ -76,6 +143,13 @@ void MidiPlayer::setVolume(int volume) {
 	Common::StackLock lock(_mutex);
 
 	_masterVolume = volume;
+
+	// The volume of a cached track is part of its rendering
+	if (_isPlayingCached)
+		g_system->getMixer()->setChannelVolume(_cacheHandle, MIN(volume * Mixer::kMaxChannelVolume / _cacheVolume, (int)Mixer::kMaxChannelVolume));
+	else if (_cacheRecorder && !_cacheRecorder->isComplete())
+		_cacheRecorder->invalidate();
+
 	for (int i = 0; i < kNumChannels; ++i) {
 		if (_channelsTable[i]) {
 			_channelsTable[i]->volume(_channelsVolume[i] * _masterVolume / 255);
@@ -93,6 +167,11 @@ void MidiPlayer::syncVolume() {
 
 
 void MidiPlayer::send(uint32 b) {
+	// Events which do not come from the track, e.g. sound effects, would
+	// end up in its recording
+	if (_cacheRecorder && !_isParsing && !_cacheRecorder->isComplete())
+		_cacheRecorder->invalidate();
+
 	byte ch = (byte)(b & 0x0F);
 	if ((b & 0xFFF0) == 0x07B0) {
 		// Adjust volume changes by master volume
@@ -125,6 +204,9 @@ void MidiPlayer::sendToChannel(byte ch, uint32 b) {
 void MidiPlayer::metaEvent(byte type, byte *data, uint16 length) {
 	switch (type) {
 	case 0x2F:	// End of Track
+		// The track has been played completely, so it can be cached
+		if (_cacheRecorder)
+			_cacheRecorder->complete(!_isLooping);
 		endOfTrack();
 		break;
 	default:
@@ -153,7 +235,21 @@ void MidiPlayer::onTimer() {
 	// by a simple check for "_parser != 0" ?
 
 	if (_isPlaying && _parser) {
+		uint32 tick = _parser->getTick();
+
+		_isParsing = true;
 		_parser->onTimer();
+		_isParsing = false;
+
+		// Parsers looping by themselves jump back to the start without
+		// sending an End of Track event
+		if (_cacheRecorder && _parser && _parser->getTick() < tick)
+			_cacheRecorder->complete(false);
+	}
+
+	if (_isPlayingCached && !g_system->getMixer()->isSoundHandleActive(_cacheHandle)) {
+		_isPlayingCached = false;
+		_isPlaying = false;
 	}
 }
 
@@ -162,6 +258,20 @@ void MidiPlayer::stop() {
 	Common::StackLock lock(_mutex);
 
 	_isPlaying = false;
+
+	if (_isPlayingCached) {
+		g_system->getMixer()->stopHandle(_cacheHandle);
+		_isPlayingCached = false;
+	}
+
+	// An incomplete recording is of no use. A complete one is kept until
+	// saveCachedTrack() is called outside of the audio thread.
+	if (_cacheRecorder && !_cacheRecorder->isComplete()) {
+		_driver->setRenderRecorder(nullptr);
+		delete _cacheRecorder;
+		_cacheRecorder = nullptr;
+	}
+
 	if (_parser) {
 		_parser->unloadMusic();
 
@@ -182,12 +292,18 @@ void MidiPlayer::stop() {
 void MidiPlayer::pause() {
 //	debugC(2, kDraciSoundDebugLevel, "Pausing track %d", _track);
 	_isPlaying = false;
+	if (_isPlayingCached)
+		g_system->getMixer()->pauseHandle(_cacheHandle, true);
+	else
+		invalidateCachedTrack();
 	setVolume(-1);	// FIXME: This should be 0, shouldn't it?
 }
 
 void MidiPlayer::resume() {
 //	debugC(2, kDraciSoundDebugLevel, "Resuming track %d", _track);
 	syncVolume();
+	if (_isPlayingCached)
+		g_system->getMixer()->pauseHandle(_cacheHandle, false);
 	_isPlaying = true;
 }
 
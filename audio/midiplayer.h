@@ -25,11 +25,14 @@
 #include "common/scummsys.h"
 #include "common/mutex.h"
 #include "audio/mididrv.h"
+#include "audio/mixer.h"
 
 class MidiParser;
 
 namespace Audio {
 
+class MidiRenderRecorder;
+
 /**
  * @defgroup audio_midiplayer MIDI player
  * @ingroup audio
@@ -148,6 +151,37 @@ protected:
 
 	void createDriver(int flags = MDT_MIDI | MDT_ADLIB | MDT_PREFER_GM);
 
+	/**
+	 * Play a track from the MIDI render cache, if the cache is enabled and
+	 * holds a rendering of the track for the current driver and settings.
+	 * Otherwise, the output of the driver is recorded, and cached once the
+	 * track reaches its end without its playback having been modified.
+	 *
+	 * Subclasses call this after setting _isLooping and the volume, and
+	 * start the parser as usual only if it returns false. Events sent to
+	 * the player from outside of the parser invalidate the recording, but
+	 * events sent to the driver directly are recorded as well, so the
+	 * driver must not be used for anything else, such as sound effects.
+	 *
+	 * @param data  The MIDI data of the track.
+	 * @param size  The size of the MIDI data.
+	 */
+	bool playCachedTrack(const byte *data, uint32 size);
+
+	/**
+	 * Discard the recording of the current track. This must be called when
+	 * the playback of the track is changed at runtime, e.g. by a script
+	 * changing the tempo or sending additional MIDI events, so that the
+	 * changed output does not end up in the cache.
+	 */
+	void invalidateCachedTrack();
+
+	/**
+	 * Store the recording of the previous track in the render cache, if it
+	 * played until its end.
+	 */
+	void saveCachedTrack();
+
 protected:
 	enum {
 		/**
@@ -187,6 +221,16 @@ protected:
 	int _masterVolume;	// FIXME: byte or int ?
 
 	bool _nativeMT32;
+
+	/** The recording of the current track, if it is not cached yet. */
+	MidiRenderRecorder *_cacheRecorder;
+	/** The handle of the current track, if it is played from the cache. */
+	SoundHandle _cacheHandle;
+	bool _isPlayingCached;
+	/** The master volume the cached track was rendered with. */
+	int _cacheVolume;
+	/** Whether the parser is sending the events of the track. */
+	bool _isParsing;
 };
 
 /** @} */
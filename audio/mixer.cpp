@@ -21,6 +21,7 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -46,15 +47,15 @@ public:
 	~Channel();
 
 	/**
-	 * Mixes the channel's samples into the given buffer.
+	 * Mixes the channel's samples into the given mixing bus. The volume
+	 * of the channel's sound type is not applied.
 	 *
-	 * @param data buffer where to mix the data
+	 * @param data bus where to mix the data
 	 * @param len  number of sample *pairs*. So a value of
-	 *             10 means that the buffer contains twice 10 sample, each
-	 *             16 bits, for a total of 40 bytes.
+	 *             10 means that the bus contains twice 10 samples.
 	 * @return number of sample pairs processed (which can still be silence!)
 	 */
-	int mix(int16 *data, uint len);
+	int mix(int32 *data, uint len);
 
 	/**
 	 * Queries whether the channel is still playing or not.
@@ -197,7 +198,8 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, bool stereo, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _stereo(stereo), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _limiterGain(kLimiterUnityGain), _ditherState(1) {
 
 	assert(sampleRate > 0);
 
@@ -301,6 +303,8 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	PROFILE_ZONE_TRACK("MixerImpl::mixCallback", "audio");
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -308,10 +312,8 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
-	//  zero the buf
-	memset(buf, 0, len);
-
 	// we store 16-bit samples
+	const uint numSamples = len >> 1;
 	if (_stereo) {
 		assert(len % 4 == 0);
 		len >>= 2;
@@ -320,6 +322,9 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 		len >>= 1;
 	}
 
+	// Only the buses which are used are cleared and mixed
+	bool busUsed[NUM_SOUND_TYPES] = { false, false, false, false };
+
 	// mix all channels
 	int res = 0, tmp;
 	for (int i = 0; i != NUM_CHANNELS; i++)
@@ -328,16 +333,121 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 				delete _channels[i];
 				_channels[i] = nullptr;
 			} else if (!_channels[i]->isPaused()) {
-				tmp = _channels[i]->mix(buf, len);
+				const int type = _channels[i]->getType();
+				Common::Array<int32> &bus = _soundTypeBus[type];
+				if (!busUsed[type]) {
+					if (bus.size() < numSamples)
+						bus.resize(numSamples);
+					memset(bus.data(), 0, numSamples * sizeof(int32));
+					busUsed[type] = true;
+				}
+
+				tmp = _channels[i]->mix(bus.data(), len);
 
 				if (tmp > res)
 					res = tmp;
 			}
 		}
 
+	// Apply the volume of each sound type, and sum up the buses
+	if (_outputBus.size() < numSamples)
+		_outputBus.resize(numSamples);
+	int32 *out = _outputBus.data();
+	memset(out, 0, numSamples * sizeof(int32));
+
+	for (int type = 0; type < NUM_SOUND_TYPES; type++) {
+		if (!busUsed[type] || _soundTypeSettings[type].mute)
+			continue;
+
+		const int32 *in = _soundTypeBus[type].data();
+		const int32 volume = _soundTypeSettings[type].volume;
+		if (volume == kMaxMixerVolume) {
+			for (uint i = 0; i < numSamples; i++)
+				out[i] += in[i];
+		} else {
+			for (uint i = 0; i < numSamples; i++)
+				out[i] += (in[i] * volume) / kMaxMixerVolume;
+		}
+	}
+
+	limitOutput(buf, out, numSamples);
+
 	return res;
 }
 
+void MixerImpl::limitOutput(int16 *dst, const int32 *src, uint numSamples) {
+	const uint channels = _stereo ? 2 : 1;
+	const uint numFrames = numSamples / channels;
+
+	// The whole buffer is known before it is output, which gives the
+	// limiter a look-ahead of one buffer
+	int32 peak = 0;
+	uint firstOver = numFrames;
+	for (uint i = 0; i < numSamples; i++) {
+		const int32 sample = ABS(src[i]);
+		if (sample > peak)
+			peak = sample;
+		if (firstOver == numFrames && (((int64)sample * _limiterGain) >> 16) > ST_SAMPLE_MAX)
+			firstOver = i / channels;
+	}
+
+	int32 target = kLimiterUnityGain;
+	if (peak > ST_SAMPLE_MAX)
+		target = (int32)(((int64)ST_SAMPLE_MAX << 16) / peak);
+
+	int32 gain = _limiterGain;
+	int32 step = 0;
+	if (target < gain) {
+		// Fade down to the target by the first frame which would clip, so
+		// that the attenuation does not click
+		step = -(int32)((gain - target + firstOver) / (firstOver + 1));
+	} else if (gain < target && numFrames) {
+		// Release towards the target gain
+		const int32 maxStep = MAX<int32>(kLimiterUnityGain / (int32)(_sampleRate * kLimiterReleaseTime / 1000), 1);
+		step = MIN<int32>((target - gain + numFrames - 1) / numFrames, maxStep);
+	}
+
+	if (gain == kLimiterUnityGain && !step) {
+		for (uint i = 0; i < numSamples; i++) {
+			int32 val = CLIP<int32>(src[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+			dst[i] = ((int16)val) ^ 0x8000;
+#else
+			dst[i] = val;
+#endif
+		}
+	} else {
+		// Applying a gain leaves a fraction of a sample which would be
+		// truncated. Triangular dither of one step turns the truncation
+		// error into noise. The buses are integer until here, so this is
+		// the only place where precision is lost.
+		uint32 state = _ditherState;
+		for (uint i = 0; i < numFrames; i++) {
+			// Each step is clamped, so that the gain never passes the target
+			gain = (step < 0) ? MAX(gain + step, target) : MIN(gain + step, target);
+
+			for (uint j = 0; j < channels; j++) {
+				// Only the high bits of the generator are random enough
+				state = state * 1664525 + 1013904223;
+				int32 dither = state >> 16;
+				state = state * 1664525 + 1013904223;
+				dither -= state >> 16;
+
+				int32 val = (int32)(((int64)src[i * channels + j] * gain + dither + 0x8000) >> 16);
+				val = CLIP<int32>(val, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+#ifdef OUTPUT_UNSIGNED_AUDIO
+				dst[i * channels + j] = ((int16)val) ^ 0x8000;
+#else
+				dst[i * channels + j] = val;
+#endif
+			}
+		}
+		_ditherState = state;
+	}
+
+	_limiterGain = gain;
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -626,16 +736,16 @@ void Channel::resetRate() {
 }
 
 void Channel::updateChannelVolumes() {
-	// From the channel balance/volume and the global volume, we compute
-	// the effective volume for the left and right channel. Note the
-	// slightly odd divisor: the 255 reflects the fact that the maximal
-	// value for _volume is 255, while the 127 is there because the
-	// balance value ranges from -127 to 127.  The mixer (music/sound)
-	// volume is in the range 0 - kMaxMixerVolume.
-	// Hence, the vol_l/vol_r values will be in that range, too
+	// From the channel balance/volume we compute the effective volume for
+	// the left and right channel. Note the slightly odd divisor: the 255
+	// reflects the fact that the maximal value for _volume is 255, while
+	// the 127 is there because the balance value ranges from -127 to 127.
+	// The vol_l/vol_r values will be in the range 0 - kMaxMixerVolume.
+	// The volume of the sound type is applied to the mixing bus of the
+	// sound type instead.
 
 	if (!_mixer->isSoundTypeMuted(_type)) {
-		int vol = _mixer->getVolumeForSoundType(_type) * _volume;
+		int vol = Mixer::kMaxMixerVolume * _volume;
 
 		if (_balance == 0) {
 			_volL = vol / Mixer::kMaxChannelVolume;
@@ -707,7 +817,7 @@ void Channel::loop() {
 	}
 }
 
-int Channel::mix(int16 *data, uint len) {
+int Channel::mix(int32 *data, uint len) {
 	assert(_stream);
 	assert(_converter);
 
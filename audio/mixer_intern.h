@@ -23,6 +23,7 @@
 #define AUDIO_MIXER_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "common/mutex.h"
 #include "audio/mixer.h"
 
@@ -58,7 +59,13 @@ namespace Audio {
 class MixerImpl : public Mixer {
 private:
 	enum {
-		NUM_CHANNELS = 32
+		NUM_CHANNELS = 32,
+		NUM_SOUND_TYPES = 4
+	};
+
+	enum {
+		kLimiterUnityGain = 1 << 16,	// Gain of the output limiter, in 16.16 fixed point
+		kLimiterReleaseTime = 250		// Time to recover from full attenuation, in ms
 	};
 
 	Common::Mutex _mutex;
@@ -76,9 +83,30 @@ private:
 		int volume;
 	};
 
-	SoundTypeSettings _soundTypeSettings[4];
+	SoundTypeSettings _soundTypeSettings[NUM_SOUND_TYPES];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * The 32-bit mixing buses. Channels are mixed into the bus of their
+	 * sound type, and the buses are mixed into the output bus, applying the
+	 * volume of the sound type once per bus.
+	 */
+	Common::Array<int32> _soundTypeBus[NUM_SOUND_TYPES];
+	Common::Array<int32> _outputBus;
+
+	/** The current gain of the output limiter. */
+	int32 _limiterGain;
+	/** State of the random number generator used for dithering. */
+	uint32 _ditherState;
+
+	/**
+	 * Convert the output bus to 16-bit samples. Peaks which would clip are
+	 * attenuated instead: the gain fades down ahead of them within the
+	 * buffer, and is then restored smoothly. Samples are dithered while a
+	 * gain is applied.
+	 */
+	void limitOutput(int16 *dst, const int32 *src, uint numSamples);
+
 
 public:
 
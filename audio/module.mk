@@ -3,12 +3,14 @@ MODULE := audio
 MODULE_OBJS := \
 	adlib.o \
 	adlib_ms.o \
+	audio_cache.o \
 	audiostream.o \
 	casio.o \
 	chip.o \
 	cms.o \
 	fmopl.o \
 	mac_plugin.o \
+	midi_render_cache.o \
 	mididrv.o \
 	mididrv_ms.o \
 	midiparser_qt.o \
@@ -24,6 +26,7 @@ MODULE_OBJS := \
 	musicplugin.o \
 	null.o \
 	rate.o \
+	render_ahead.o \
 	timestamp.o \
 	decoders/3do.o \
 	decoders/aac.o \
@@ -96,6 +99,11 @@ MODULE_OBJS += \
 	decoders/ac3.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	decoders/adpcm-sse2.o
+endif
+
 ifdef USE_ALSA
 MODULE_OBJS += \
 	alsa_opl.o
@@ -90,6 +90,15 @@ public:
 	 */
 	virtual int convert(AudioStream &input, st_sample_t *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
 
+	/**
+	 * Convert the provided AudioStream to the target sample rate, and add
+	 * it to a 32-bit mixing buffer. Unlike the 16-bit variant, the samples
+	 * are not clipped.
+	 *
+	 * @see convert(AudioStream &, st_sample_t *, st_size_t, st_volume_t, st_volume_t)
+	 */
+	virtual int convert(AudioStream &input, int32 *outBuffer, st_size_t numSamples, st_volume_t vol_l, st_volume_t vol_r) = 0;
+
 	virtual void setInputRate(st_rate_t inputRate) = 0;
 	virtual void setOutputRate(st_rate_t outputRate) = 0;
 
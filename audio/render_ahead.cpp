@@ -0,0 +1,110 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/render_ahead.h"
+
+#include "common/config-manager.h"
+#include "common/system.h"
+
+#include "audio/mixer.h"
+
+namespace Audio {
+
+RenderAhead::RenderAhead(RenderCallback *render, int rate, bool stereo, uint msecs) :
+	_render(render), _rate(rate), _channels(stereo ? 2 : 1),
+	_readPos(0), _writePos(0), _count(0), _underruns(0), _mutex(g_system->getMixer()->mutex()) {
+
+	msecs = MAX<uint>(msecs, kMinLength);
+
+	// Keep the buffer a multiple of the frame size, so that a frame never
+	// wraps around the end
+	_bufferSize = (uint)((uint64)rate * msecs / 1000) * _channels;
+	_buffer = new int16[_bufferSize];
+	_minBuffered = _bufferSize;
+}
+
+RenderAhead::~RenderAhead() {
+	delete[] _buffer;
+}
+
+uint RenderAhead::getConfiguredLength() {
+	if (!ConfMan.hasKey("synth_render_ahead"))
+		return 0;
+	return MAX(ConfMan.getInt("synth_render_ahead"), 0);
+}
+
+void RenderAhead::fill(uint32 start, uint32 budget) {
+	while (_count < _bufferSize && g_system->getMillis() - start < budget) {
+		uint len = MIN(_bufferSize - _count, _bufferSize - _writePos);
+		len = MIN<uint>(len, kChunkSize);
+		len -= len % _channels;
+		if (!len)
+			break;
+
+		(*_render)(_buffer + _writePos, len);
+
+		_writePos = (_writePos + len) % _bufferSize;
+		_count += len;
+	}
+}
+
+int RenderAhead::copyOut(int16 *buffer, int numSamples) {
+	const uint count = MIN<uint>(_count, numSamples);
+	const uint first = MIN(count, _bufferSize - _readPos);
+	memcpy(buffer, _buffer + _readPos, first * sizeof(int16));
+	memcpy(buffer + first, _buffer, (count - first) * sizeof(int16));
+
+	_readPos = (_readPos + count) % _bufferSize;
+	_count -= count;
+	return count;
+}
+
+int RenderAhead::readBuffer(int16 *buffer, const int numSamples) {
+	const uint32 start = g_system->getMillis();
+
+	_minBuffered = MIN<uint32>(_minBuffered, _count);
+
+	int copied = copyOut(buffer, numSamples);
+	if (copied < numSamples) {
+		(*_render)(buffer + copied, numSamples - copied);
+		_underruns++;
+	}
+
+	// Spend at most half the duration of the audio read on rendering,
+	// leaving the rest of the callback to the mixer and the other channels
+	fill(start, (uint32)((uint64)numSamples * 500 / (_rate * _channels)));
+
+	return numSamples;
+}
+
+RenderAhead::Stats RenderAhead::getStats() const {
+	Common::StackLock lock(_mutex);
+
+	Stats stats;
+	stats.bufferSize = _bufferSize;
+	stats.buffered = _count;
+	stats.minBuffered = _minBuffered;
+	stats.latency = (uint32)((uint64)_count * 1000 / (_rate * _channels));
+	stats.underruns = _underruns;
+	return stats;
+}
+
+} // End of namespace Audio
@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_RENDER_AHEAD_H
+#define AUDIO_RENDER_AHEAD_H
+
+#include "common/func.h"
+#include "common/mutex.h"
+#include "common/ptr.h"
+
+namespace Audio {
+
+/**
+ * Renders the output of an emulated synth ahead of the mixer.
+ *
+ * The synth, including the timer callbacks interleaved with its samples,
+ * is rendered into a ring buffer from the mixer callback. After serving a
+ * read, the buffer is topped up as long as the callback has used less than
+ * half the duration of the audio it read, so that cheap passages of the
+ * synth pay for the expensive ones. Reads are served from the buffer, and
+ * when it runs empty the missing samples are rendered directly and an
+ * underrun is counted.
+ *
+ * Everything is done from the mixer callback, with the mixer mutex held,
+ * since the synth and its drivers rely on that mutex to synchronize with
+ * the engine. No other thread ever waits for the synth.
+ *
+ * The buffer adds its length to the latency of the synth, so this is
+ * disabled unless the "synth_render_ahead" setting is set to the amount
+ * of audio to buffer, in milliseconds.
+ */
+class RenderAhead {
+public:
+	/**
+	 * The type of the render callback. It has the same semantics as
+	 * AudioStream::readBuffer.
+	 */
+	typedef Common::Functor2<int16 *, int, int> RenderCallback;
+
+	struct Stats {
+		uint32 bufferSize;	///< Size of the buffer, in samples
+		uint32 buffered;	///< Samples currently in the buffer
+		uint32 minBuffered;	///< Lowest amount of buffered samples seen by the mixer
+		uint32 latency;		///< Length of the buffered audio, in milliseconds
+		uint32 underruns;	///< Number of mixer reads which had to render samples
+	};
+
+	/**
+	 * Create a render-ahead buffer. It is filled by the reads from the mixer.
+	 *
+	 * @param render  Callback producing the samples. The buffer takes ownership.
+	 * @param rate    Sample rate of the rendered audio.
+	 * @param stereo  Whether the rendered audio is stereo.
+	 * @param msecs   Amount of audio to render ahead.
+	 */
+	RenderAhead(RenderCallback *render, int rate, bool stereo, uint msecs);
+
+	~RenderAhead();
+
+	/**
+	 * Read samples from the buffer, rendering them directly if the buffer
+	 * does not hold enough, then render ahead within the time budget of the
+	 * read. To be called from the mixer callback, with the mixer mutex held.
+	 */
+	int readBuffer(int16 *buffer, const int numSamples);
+
+	Stats getStats() const;
+
+	/**
+	 * Return the configured render-ahead length in milliseconds, or 0 if
+	 * the synths should be rendered from the mixer callback.
+	 */
+	static uint getConfiguredLength();
+
+private:
+	enum {
+		kMinLength = 20,		// Minimum buffer length, in ms
+		kChunkSize = 512		// Samples rendered at once
+	};
+
+	void fill(uint32 start, uint32 budget);
+	int copyOut(int16 *buffer, int numSamples);
+
+	Common::ScopedPtr<RenderCallback> _render;
+	int _rate;
+	uint _channels;
+
+	int16 *_buffer;
+	uint _bufferSize;
+	uint _readPos;
+	uint _writePos;
+	uint _count;
+
+	uint32 _minBuffered;
+	uint32 _underruns;
+
+	/** The mixer mutex, protecting the synth, the buffer and the statistics. */
+	Common::Mutex &_mutex;
+};
+
+} // End of namespace Audio
+
+#endif
@@ -24,7 +24,11 @@
 
 #include "audio/audiostream.h"
 #include "audio/mididrv.h"
+#include "audio/midi_render_cache.h"
 #include "audio/mixer.h"
+#include "audio/render_ahead.h"
+
+#include "common/mutex.h"
 
 class MidiDriver_Emulated : public Audio::AudioStream, public MidiDriver {
 protected:
@@ -43,12 +47,73 @@ private:
 	int _nextTick;
 	int _samplesPerTick;
 
+	Audio::RenderAhead *_renderAhead;
+
+	Audio::MidiRenderRecorder *_recorder;
+	Common::Mutex _recorderMutex;
+
 protected:
 	int _baseFreq;
 
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
+	/**
+	 * Start rendering the synth ahead of the mixer, if enabled in the
+	 * configuration. Must be called before the stream is passed to the mixer.
+	 */
+	void startRenderAhead() {
+		uint msecs = Audio::RenderAhead::getConfiguredLength();
+		if (msecs && !_renderAhead)
+			_renderAhead = new Audio::RenderAhead(new Common::Functor2Mem<int16 *, int, int, MidiDriver_Emulated>(this, &MidiDriver_Emulated::renderBuffer), getRate(), isStereo(), msecs);
+	}
+
+	/**
+	 * Stop rendering ahead of the mixer. Must be called after the stream
+	 * has been stopped, and before the synth is destroyed.
+	 */
+	void stopRenderAhead() {
+		delete _renderAhead;
+		_renderAhead = nullptr;
+	}
+
+	/** Run the synth and the timer callbacks to produce samples. */
+	int renderBuffer(int16 *data, int numSamples) {
+		const int stereoFactor = isStereo() ? 2 : 1;
+		int len = numSamples / stereoFactor;
+		int step;
+
+		do {
+			step = len;
+			if (step > (_nextTick >> FIXP_SHIFT))
+				step = (_nextTick >> FIXP_SHIFT);
+
+			generateSamples(data, step);
+
+			// Record before the timer callbacks, which may end the recording
+			{
+				Common::StackLock lock(_recorderMutex);
+				if (_recorder)
+					_recorder->writeSamples(data, step * stereoFactor);
+			}
+
+			_nextTick -= step << FIXP_SHIFT;
+			if (!(_nextTick >> FIXP_SHIFT)) {
+				if (_timerProc)
+					(*_timerProc)(_timerParam);
+
+				onTimer();
+
+				_nextTick += _samplesPerTick;
+			}
+
+			data += step * stereoFactor;
+			len -= step;
+		} while (len);
+
+		return numSamples;
+	}
+
 public:
 	MidiDriver_Emulated(Audio::Mixer *mixer) :
 		_mixer(mixer),
@@ -57,9 +122,15 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_renderAhead(nullptr),
+		_recorder(nullptr),
 		_baseFreq(250) {
 	}
 
+	~MidiDriver_Emulated() {
+		stopRenderAhead();
+	}
+
 	// MidiDriver API
 	virtual int open() {
 		_isOpen = true;
@@ -86,34 +157,30 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
-	// AudioStream API
-	virtual int readBuffer(int16 *data, const int numSamples) {
-		const int stereoFactor = isStereo() ? 2 : 1;
-		int len = numSamples / stereoFactor;
-		int step;
-
-		do {
-			step = len;
-			if (step > (_nextTick >> FIXP_SHIFT))
-				step = (_nextTick >> FIXP_SHIFT);
-
-			generateSamples(data, step);
-
-			_nextTick -= step << FIXP_SHIFT;
-			if (!(_nextTick >> FIXP_SHIFT)) {
-				if (_timerProc)
-					(*_timerProc)(_timerParam);
-
-				onTimer();
-
-				_nextTick += _samplesPerTick;
-			}
+	bool setRenderRecorder(Audio::MidiRenderRecorder *recorder) override {
+		Common::StackLock lock(_recorderMutex);
+		_recorder = recorder;
+		if (_recorder)
+			_recorder->setFormat(getRate(), isStereo());
+		return true;
+	}
 
-			data += step * stereoFactor;
-			len -= step;
-		} while (len);
+	/**
+	 * Return the statistics of the render-ahead buffer. Returns false if
+	 * the synth is rendered from the mixer callback.
+	 */
+	bool getRenderAheadStats(Audio::RenderAhead::Stats &stats) const {
+		if (!_renderAhead)
+			return false;
+		stats = _renderAhead->getStats();
+		return true;
+	}
 
-		return numSamples;
+	// AudioStream API
+	virtual int readBuffer(int16 *data, const int numSamples) {
+		if (_renderAhead)
+			return _renderAhead->readBuffer(data, numSamples);
+		return renderBuffer(data, numSamples);
 	}
 
 	virtual bool endOfData() const {
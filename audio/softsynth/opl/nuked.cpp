@@ -1121,15 +1121,84 @@ static void OPL3_ProcessSlot(opl3_slot *slot)
     OPL3_SlotGenerate(slot);
 }
 
+static void OPL3_ProcessTimers(opl3_chip *chip)
+{
+    opl3_writebuf *writebuf;
+    uint8_t shift = 0;
+
+    if ((chip->timer & 0x3f) == 0x3f)
+    {
+        chip->tremolopos = (chip->tremolopos + 1) % 210;
+    }
+    if (chip->tremolopos < 105)
+    {
+        chip->tremolo = chip->tremolopos >> chip->tremoloshift;
+    }
+    else
+    {
+        chip->tremolo = (210 - chip->tremolopos) >> chip->tremoloshift;
+    }
+
+    if ((chip->timer & 0x3ff) == 0x3ff)
+    {
+        chip->vibpos = (chip->vibpos + 1) & 7;
+    }
+
+    chip->timer++;
+
+    chip->eg_add = 0;
+    if (chip->eg_timer)
+    {
+        while (shift < 36 && ((chip->eg_timer >> shift) & 1) == 0)
+        {
+            shift++;
+        }
+        if (shift > 12)
+        {
+            chip->eg_add = 0;
+        }
+        else
+        {
+            chip->eg_add = shift + 1;
+        }
+    }
+
+    if (chip->eg_timerrem || chip->eg_state)
+    {
+        if (chip->eg_timer == UINT64_C(0xfffffffff))
+        {
+            chip->eg_timer = 0;
+            chip->eg_timerrem = 1;
+        }
+        else
+        {
+            chip->eg_timer++;
+            chip->eg_timerrem = 0;
+        }
+    }
+
+    chip->eg_state ^= 1;
+
+    while ((writebuf = &chip->writebuf[chip->writebuf_cur]), writebuf->time <= chip->writebuf_samplecnt)
+    {
+        if (!(writebuf->reg & 0x200))
+        {
+            break;
+        }
+        writebuf->reg &= 0x1ff;
+        OPL3_WriteReg(chip, writebuf->reg, writebuf->data);
+        chip->writebuf_cur = (chip->writebuf_cur + 1) % OPL_WRITEBUF_SIZE;
+    }
+    chip->writebuf_samplecnt++;
+}
+
 inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
 {
     opl3_channel *channel;
-    opl3_writebuf *writebuf;
     int16_t **out;
     int32_t mix[2];
     uint8_t ii;
     int16_t accm;
-    uint8_t shift = 0;
 
     buf4[1] = OPL3_ClipSample(chip->mixbuff[1]);
     buf4[3] = OPL3_ClipSample(chip->mixbuff[3]);
@@ -1199,70 +1268,7 @@ inline void OPL3_Generate4Ch(opl3_chip *chip, int16_t *buf4)
     }
 #endif
 
-    if ((chip->timer & 0x3f) == 0x3f)
-    {
-        chip->tremolopos = (chip->tremolopos + 1) % 210;
-    }
-    if (chip->tremolopos < 105)
-    {
-        chip->tremolo = chip->tremolopos >> chip->tremoloshift;
-    }
-    else
-    {
-        chip->tremolo = (210 - chip->tremolopos) >> chip->tremoloshift;
-    }
-
-    if ((chip->timer & 0x3ff) == 0x3ff)
-    {
-        chip->vibpos = (chip->vibpos + 1) & 7;
-    }
-
-    chip->timer++;
-
-    chip->eg_add = 0;
-    if (chip->eg_timer)
-    {
-        while (shift < 36 && ((chip->eg_timer >> shift) & 1) == 0)
-        {
-            shift++;
-        }
-        if (shift > 12)
-        {
-            chip->eg_add = 0;
-        }
-        else
-        {
-            chip->eg_add = shift + 1;
-        }
-    }
-
-    if (chip->eg_timerrem || chip->eg_state)
-    {
-        if (chip->eg_timer == UINT64_C(0xfffffffff))
-        {
-            chip->eg_timer = 0;
-            chip->eg_timerrem = 1;
-        }
-        else
-        {
-            chip->eg_timer++;
-            chip->eg_timerrem = 0;
-        }
-    }
-
-    chip->eg_state ^= 1;
-
-    while ((writebuf = &chip->writebuf[chip->writebuf_cur]), writebuf->time <= chip->writebuf_samplecnt)
-    {
-        if (!(writebuf->reg & 0x200))
-        {
-            break;
-        }
-        writebuf->reg &= 0x1ff;
-        OPL3_WriteReg(chip, writebuf->reg, writebuf->data);
-        chip->writebuf_cur = (chip->writebuf_cur + 1) % OPL_WRITEBUF_SIZE;
-    }
-    chip->writebuf_samplecnt++;
+    OPL3_ProcessTimers(chip);
 }
 
 void OPL3_Generate(opl3_chip *chip, int16_t *buf)
@@ -1548,6 +1554,175 @@ void OPL3_GenerateStream(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples)
     }
 }
 
+/*
+    Block mode
+
+    Produces the same output as OPL3_GenerateStream, but generates the
+    samples at the chip rate in blocks before resampling them. Released
+    slots at maximum attenuation skip the envelope generator, and only
+    the two channels which are output are mixed.
+*/
+
+static void OPL3_ProcessSlotBlock(opl3_slot *slot)
+{
+    OPL3_SlotCalcFB(slot);
+    /*
+        A released slot at maximum attenuation stays there until it is
+        keyed on, so its envelope state does not change. Its eg_out is
+        left over from a level of at least 0x1f7, which gives the same
+        output as the current one.
+    */
+    if (slot->key || slot->eg_gen != envelope_gen_num_release || slot->eg_rout != 0x1ff)
+    {
+        OPL3_EnvelopeCalc(slot);
+    }
+    OPL3_PhaseGenerate(slot);
+    OPL3_SlotGenerate(slot);
+}
+
+static void OPL3_Generate2ChBlock(opl3_chip *chip, int16_t *buf, uint32_t numsamples)
+{
+    opl3_channel *channel;
+    int16_t **out;
+    int32_t mix;
+    uint8_t ii;
+    int16_t accm;
+    uint_fast32_t i;
+
+    for (i = 0; i < numsamples; i++)
+    {
+        buf[1] = OPL3_ClipSample(chip->mixbuff[1]);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+        for (ii = 0; ii < 15; ii++)
+#else
+        for (ii = 0; ii < 36; ii++)
+#endif
+        {
+            OPL3_ProcessSlotBlock(&chip->slot[ii]);
+        }
+
+        mix = 0;
+        for (ii = 0; ii < 18; ii++)
+        {
+            channel = &chip->channel[ii];
+            out = channel->out;
+            accm = *out[0] + *out[1] + *out[2] + *out[3];
+#if OPL_ENABLE_STEREOEXT
+            mix += (int16_t)((accm * channel->leftpan) >> 16);
+#else
+            mix += (int16_t)(accm & channel->cha);
+#endif
+        }
+        chip->mixbuff[0] = mix;
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+        for (ii = 15; ii < 18; ii++)
+        {
+            OPL3_ProcessSlotBlock(&chip->slot[ii]);
+        }
+#endif
+
+        buf[0] = OPL3_ClipSample(chip->mixbuff[0]);
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+        for (ii = 18; ii < 33; ii++)
+        {
+            OPL3_ProcessSlotBlock(&chip->slot[ii]);
+        }
+#endif
+
+        mix = 0;
+        for (ii = 0; ii < 18; ii++)
+        {
+            channel = &chip->channel[ii];
+            out = channel->out;
+            accm = *out[0] + *out[1] + *out[2] + *out[3];
+#if OPL_ENABLE_STEREOEXT
+            mix += (int16_t)((accm * channel->rightpan) >> 16);
+#else
+            mix += (int16_t)(accm & channel->chb);
+#endif
+        }
+        chip->mixbuff[1] = mix;
+
+#if OPL_QUIRK_CHANNELSAMPLEDELAY
+        for (ii = 33; ii < 36; ii++)
+        {
+            OPL3_ProcessSlotBlock(&chip->slot[ii]);
+        }
+#endif
+
+        OPL3_ProcessTimers(chip);
+        buf += 2;
+    }
+}
+
+void OPL3_GenerateStreamBlock(opl3_chip *chip, int16_t *sndptr, uint32_t numsamples)
+{
+    int16_t block[OPL_BLOCK_SIZE * 2];
+    uint32_t count, needed, i, j;
+    int32_t samplecnt;
+
+    while (numsamples)
+    {
+        /*
+            Find out how many output samples can be produced from one
+            block. Generating more chip samples than the scalar path would
+            delay the buffered register writes.
+        */
+        samplecnt = chip->samplecnt;
+        needed = 0;
+        for (count = 0; count < numsamples; count++)
+        {
+            uint32_t n = 0;
+            int32_t cnt = samplecnt;
+            while (cnt >= chip->rateratio)
+            {
+                cnt -= chip->rateratio;
+                n++;
+            }
+            if (needed + n > OPL_BLOCK_SIZE)
+            {
+                break;
+            }
+            needed += n;
+            samplecnt = cnt + (1 << RSM_FRAC);
+        }
+
+        if (count == 0)
+        {
+            /* The output rate is too low to fit a sample into one block */
+            OPL3_GenerateStream(chip, sndptr, numsamples);
+            return;
+        }
+
+        OPL3_Generate2ChBlock(chip, block, needed);
+
+        j = 0;
+        for (i = 0; i < count; i++)
+        {
+            while (chip->samplecnt >= chip->rateratio)
+            {
+                chip->oldsamples[0] = chip->samples[0];
+                chip->oldsamples[1] = chip->samples[1];
+                chip->samples[0] = block[j * 2];
+                chip->samples[1] = block[j * 2 + 1];
+                chip->samplecnt -= chip->rateratio;
+                j++;
+            }
+            sndptr[0] = (int16_t)((chip->oldsamples[0] * (chip->rateratio - chip->samplecnt)
+                                 + chip->samples[0] * chip->samplecnt) / chip->rateratio);
+            sndptr[1] = (int16_t)((chip->oldsamples[1] * (chip->rateratio - chip->samplecnt)
+                                 + chip->samples[1] * chip->samplecnt) / chip->rateratio);
+            chip->samplecnt += 1 << RSM_FRAC;
+            sndptr += 2;
+        }
+
+        numsamples -= count;
+    }
+}
+
 OPL::OPL(Config::OplType type) : _type(type), _rate(0) {
 }
 
@@ -1647,7 +1822,7 @@ byte OPL::read(int port) {
 }
 
 void OPL::generateSamples(int16*buffer, int length) {
-	OPL3_GenerateStream(&chip, (int16_t*)buffer, (uint16_t)length / 2);
+	OPL3_GenerateStreamBlock(&chip, (int16_t*)buffer, (uint16_t)length / 2);
 }
 
 }
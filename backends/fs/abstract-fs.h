@@ -172,6 +172,16 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Returns the size and the last modification time of the file referred
+	 * by this path, if the backend can determine them.
+	 *
+	 * @param size          set to the size of the file in bytes
+	 * @param modification  set to the modification time, in seconds
+	 * @return bool true if both values were set, false otherwise.
+	 */
+	virtual bool getFileInfo(int64 &size, int64 &modification) const { return false; }
+
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
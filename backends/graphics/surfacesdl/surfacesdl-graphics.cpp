@@ -23,6 +23,7 @@
 
 #if defined(SDL_BACKEND)
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
 #include "backends/events/sdl/sdl-events.h"
 #include "common/config-manager.h"
 #include "common/mutex.h"
@@ -78,6 +79,70 @@ const OSystem::GraphicsMode s_supportedStretchModes[] = {
 };
 #endif
 
+static inline int rectArea(const SDL_Rect &r) {
+	return r.w * r.h;
+}
+
+static inline bool rectsOverlap(const SDL_Rect &a, const SDL_Rect &b) {
+	return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+static SDL_Rect uniteRects(const SDL_Rect &a, const SDL_Rect &b) {
+	const int left = MIN(a.x, b.x);
+	const int top = MIN(a.y, b.y);
+	const int right = MAX(a.x + a.w, b.x + b.w);
+	const int bottom = MAX(a.y + a.h, b.y + b.h);
+
+	SDL_Rect r;
+	r.x = left;
+	r.y = top;
+	r.w = right - left;
+	r.h = bottom - top;
+	return r;
+}
+
+/**
+ * Add a rect to a dirty rect list.
+ *
+ * The rect is merged with the rects it overlaps, so that the list never
+ * contains overlapping rects, and with those it can be merged with without
+ * covering any additional area. Once the list is full, it is merged with
+ * the rect that grows the least instead.
+ *
+ * @return The rect which ended up in the list.
+ */
+static SDL_Rect addCoalescedRect(SDL_Rect *list, int &count, int maxCount, SDL_Rect rect) {
+	for (;;) {
+		int merge = -1;
+		for (int i = 0; i < count; i++) {
+			if (rectsOverlap(list[i], rect) || rectArea(uniteRects(list[i], rect)) <= rectArea(list[i]) + rectArea(rect)) {
+				merge = i;
+				break;
+			}
+		}
+
+		if (merge < 0) {
+			if (count < maxCount) {
+				list[count++] = rect;
+				return rect;
+			}
+
+			int bestGrowth = 0;
+			for (int i = 0; i < count; i++) {
+				const int growth = rectArea(uniteRects(list[i], rect)) - rectArea(list[i]);
+				if (merge < 0 || growth < bestGrowth) {
+					merge = i;
+					bestGrowth = growth;
+				}
+			}
+		}
+
+		// The merged rect may now overlap other rects, so add it again
+		rect = uniteRects(list[merge], rect);
+		list[merge] = list[--count];
+	}
+}
+
 SurfaceSdlGraphicsManager::AspectRatio::AspectRatio(int w, int h) {
 	// TODO : Validation and so on...
 	// Currently, we just ensure the program don't instantiate non-supported aspect ratios
@@ -135,7 +200,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 	_enableFocusRectDebugCode(false), _enableFocusRect(false), _focusRect(),
 #endif
 	_transactionMode(kTransactionNone),
-	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr),
+	_scalerPlugins(ScalerMan.getPlugins()), _scalerPlugin(nullptr), _scaler(nullptr), _scalerPool(nullptr),
 	_needRestoreAfterOverlay(false), _isInOverlayPalette(false), _isDoubleBuf(false), _prevForceRedraw(false), _numPrevDirtyRects(0),
 	_prevCursorNeedsRedraw(false),
 	_mouseKeyColor(0), _disableMouseKeyColor(false) {
@@ -172,6 +237,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 	_scaler = nullptr;
 	_maxExtraPixels = ScalerMan.getMaxExtraPixels();
+	_scalerPool = SurfaceSdlScalerPool::create();
 
 	_videoMode.fullscreen = ConfMan.getBool("fullscreen");
 	_videoMode.filtering = ConfMan.getBool("filtering");
@@ -186,6 +252,7 @@ SurfaceSdlGraphicsManager::SurfaceSdlGraphicsManager(SdlEventSource *sdlEventSou
 
 SurfaceSdlGraphicsManager::~SurfaceSdlGraphicsManager() {
 	unloadGFXMode();
+	delete _scalerPool;
 	delete _scaler;
 	delete _mouseScaler;
 	if (_mouseOrigSurface) {
@@ -1337,6 +1404,14 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		_numPrevDirtyRects = _numDirtyRects;
 	}
 
+	// The rects of the previous frame may overlap the current ones
+	if (!doRedraw && actualDirtyRects > _numDirtyRects) {
+		int count = _numDirtyRects;
+		for (int i = _numDirtyRects; i < actualDirtyRects; i++)
+			addCoalescedRect(_dirtyRectList, count, ARRAYSIZE(_dirtyRectList), _dirtyRectList[i]);
+		actualDirtyRects = count;
+	}
+
 	// Only draw anything if necessary
 	if (actualDirtyRects > 0 || _cursorNeedsRedraw) {
 		SDL_Rect *r;
@@ -1360,6 +1435,14 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 		srcPitch = srcSurf->pitch;
 		dstPitch = _hwScreen->pitch;
 
+		// The dirty rects do not overlap, so they can be scaled in parallel
+		// unless the scaler keeps track of the previous frame
+		SurfaceSdlScalerPool *scalerPool = _useOldSrc ? nullptr : _scalerPool;
+
+#ifdef USE_ASPECT
+		int origDstY[ARRAYSIZE(_dirtyRectList)];
+#endif
+
 		for (r = _dirtyRectList; r != lastRect; ++r) {
 			int src_x = r->x;
 			int src_y = r->y;
@@ -1368,7 +1451,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 			int dst_w = r->w;
 			int dst_h = r->h;
 #ifdef USE_ASPECT
-			int orig_dst_y = 0;
+			origDstY[r - _dirtyRectList] = -1;
 #endif
 			dst_x += _currentShakeXOffset;
 			if (dst_x < 0) {
@@ -1396,7 +1479,7 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 					dst_h = height - src_y;
 
 #ifdef USE_ASPECT
-				orig_dst_y = dst_y;
+				origDstY[r - _dirtyRectList] = dst_y;
 #endif
 				dst_x *= scale1;
 				dst_y *= scale1;
@@ -1404,20 +1487,34 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				if (_videoMode.aspectRatioCorrection && !_overlayInGUI)
 					dst_y = real2Aspect(dst_y);
 
-				_scaler->scale((byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch, srcPitch,
-						(byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch, dstPitch, dst_w, dst_h, src_x, src_y);
+				const byte *srcPtr = (const byte *)srcSurf->pixels + (src_x + _maxExtraPixels) * bpp + (src_y + _maxExtraPixels) * srcPitch;
+				byte *dstPtr = (byte *)_hwScreen->pixels + dst_x * bpp + dst_y * dstPitch;
+				if (scalerPool)
+					scalerPool->addRect(srcPtr, srcPitch, dstPtr, dstPitch, dst_w, dst_h, src_x, src_y);
+				else
+					_scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, dst_w, dst_h, src_x, src_y);
 
 				r->x = dst_x;
 				r->y = dst_y;
 				r->w = dst_w * scale1;
 				r->h = dst_h * scale1;
+			}
+		}
+
+		if (scalerPool)
+			scalerPool->run(_scaler, scale1);
 
 #ifdef USE_ASPECT
-				if (_videoMode.aspectRatioCorrection && orig_dst_y < height && !_overlayInGUI)
+		// The aspect ratio correction works in place on the scaled rows, so
+		// it has to wait until all the rects have been scaled
+		if (_videoMode.aspectRatioCorrection && !_overlayInGUI) {
+			for (r = _dirtyRectList; r != lastRect; ++r) {
+				const int orig_dst_y = origDstY[r - _dirtyRectList];
+				if (orig_dst_y >= 0 && orig_dst_y < height)
 					r->h = stretch200To240((uint8 *) _hwScreen->pixels, dstPitch, r->w, r->h, r->x, r->y, orig_dst_y * scale1, _videoMode.filtering, 	convertSDLPixelFormat(_hwScreen->format));
-#endif
 			}
 		}
+#endif
 		SDL_UnlockSurface(srcSurf);
 		SDL_UnlockSurface(_hwScreen);
 
@@ -1729,11 +1826,6 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	if (_forceRedraw)
 		return;
 
-	if (_numDirtyRects == NUM_DIRTY_RECT) {
-		_forceRedraw = true;
-		return;
-	}
-
 	int height, width;
 
 	if (!inOverlay && !realCoordinates) {
@@ -1785,12 +1877,15 @@ void SurfaceSdlGraphicsManager::addDirtyRect(int x, int y, int w, int h, bool in
 	}
 
 	if (w > 0 && h > 0) {
-		SDL_Rect *r = &_dirtyRectList[_numDirtyRects++];
-
-		r->x = x;
-		r->y = y;
-		r->w = w;
-		r->h = h;
+		SDL_Rect r;
+		r.x = x;
+		r.y = y;
+		r.w = w;
+		r.h = h;
+
+		r = addCoalescedRect(_dirtyRectList, _numDirtyRects, NUM_DIRTY_RECT, r);
+		if (r.w == width && r.h == height)
+			_forceRedraw = true;
 	}
 }
 
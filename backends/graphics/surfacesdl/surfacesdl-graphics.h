@@ -34,6 +34,8 @@
 
 #include "backends/platform/sdl/sdl-sys.h"
 
+class SurfaceSdlScalerPool;
+
 #ifndef RELEASE_BUILD
 // Define this to allow for focus rectangle debugging
 #define USE_SDL_DEBUG_FOCUSRECT
@@ -334,6 +336,7 @@ protected:
 	const PluginList &_scalerPlugins;
 	ScalerPluginObject *_scalerPlugin;
 	Scaler *_scaler, *_mouseScaler;
+	SurfaceSdlScalerPool *_scalerPool;
 	uint _maxExtraPixels;
 	uint _extraPixels;
 
@@ -348,6 +351,9 @@ protected:
 	};
 
 	// Dirty rect management
+	// The rects in the list never overlap: new rects are merged with
+	// the ones they intersect, and with the closest one once the list
+	// is full.
 	// When double-buffering we need to redraw both updates from
 	// current frame and previous frame. For convenience we copy
 	// them here before traversing the list.
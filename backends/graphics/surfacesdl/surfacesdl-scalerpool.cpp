@@ -0,0 +1,176 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/graphics/surfacesdl/surfacesdl-scalerpool.h"
+
+#include "common/textconsole.h"
+#include "graphics/scalerplugin.h"
+
+SurfaceSdlScalerPool *SurfaceSdlScalerPool::create() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const int count = MIN<int>(SDL_GetCPUCount() - 1, kMaxWorkers);
+	if (count <= 0)
+		return nullptr;
+
+	SurfaceSdlScalerPool *pool = new SurfaceSdlScalerPool();
+	if (!pool->startWorkers(count)) {
+		delete pool;
+		return nullptr;
+	}
+	return pool;
+#else
+	return nullptr;
+#endif
+}
+
+SurfaceSdlScalerPool::SurfaceSdlScalerPool() : _nextJob(0), _scaler(nullptr), _quit(false) {
+	_startSem = SDL_CreateSemaphore(0);
+	_doneSem = SDL_CreateSemaphore(0);
+}
+
+SurfaceSdlScalerPool::~SurfaceSdlScalerPool() {
+	_quit = true;
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_SemPost(_startSem);
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_WaitThread(_workers[i], nullptr);
+
+	if (_startSem)
+		SDL_DestroySemaphore(_startSem);
+	if (_doneSem)
+		SDL_DestroySemaphore(_doneSem);
+}
+
+bool SurfaceSdlScalerPool::startWorkers(int count) {
+	if (!_startSem || !_doneSem)
+		return false;
+
+	for (int i = 0; i < count; i++) {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		SDL_Thread *thread = SDL_CreateThread(workerProc, "ScummVM scaler", this);
+#else
+		SDL_Thread *thread = SDL_CreateThread(workerProc, this);
+#endif
+		if (!thread) {
+			warning("Could not create scaler thread: %s", SDL_GetError());
+			break;
+		}
+		_workers.push_back(thread);
+	}
+
+	return !_workers.empty();
+}
+
+void SurfaceSdlScalerPool::addRect(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
+                                   int width, int height, int x, int y) {
+	Rect rect;
+	rect.srcPtr = srcPtr;
+	rect.srcPitch = srcPitch;
+	rect.dstPtr = dstPtr;
+	rect.dstPitch = dstPitch;
+	rect.width = width;
+	rect.height = height;
+	rect.x = x;
+	rect.y = y;
+	_rects.push_back(rect);
+}
+
+void SurfaceSdlScalerPool::run(Scaler *scaler, uint factor) {
+	uint pixels = 0;
+	for (uint i = 0; i < _rects.size(); i++)
+		pixels += _rects[i].width * _rects[i].height * factor * factor;
+
+	// Waking up the workers costs more than scaling a few small rects
+	if (pixels < kMinThreadedPixels) {
+		for (uint i = 0; i < _rects.size(); i++) {
+			const Rect &r = _rects[i];
+			scaler->scale(r.srcPtr, r.srcPitch, r.dstPtr, r.dstPitch, r.width, r.height, r.x, r.y);
+		}
+		_rects.clear();
+		return;
+	}
+
+	// Split the rects into bands, aiming for a couple of jobs per thread
+	// so that uneven rects still balance out
+	const int threads = _workers.size() + 1;
+	_jobs.clear();
+	for (uint i = 0; i < _rects.size(); i++) {
+		const Rect &r = _rects[i];
+		const int bandHeight = MAX<int>(kMinBandHeight, (r.height + threads * 2 - 1) / (threads * 2));
+
+		for (int band = 0; band < r.height; band += bandHeight) {
+			Rect job = r;
+			job.srcPtr += band * r.srcPitch;
+			job.dstPtr += band * factor * r.dstPitch;
+			job.height = MIN(bandHeight, r.height - band);
+			job.y += band;
+			_jobs.push_back(job);
+		}
+	}
+	_rects.clear();
+
+	_scaler = scaler;
+	_nextJob = 0;
+
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_SemPost(_startSem);
+
+	processJobs();
+
+	for (uint i = 0; i < _workers.size(); i++)
+		SDL_SemWait(_doneSem);
+}
+
+void SurfaceSdlScalerPool::processJobs() {
+	for (;;) {
+		uint job;
+		{
+			Common::StackLock lock(_jobMutex);
+			if (_nextJob >= _jobs.size())
+				return;
+			job = _nextJob++;
+		}
+
+		const Rect &r = _jobs[job];
+		_scaler->scale(r.srcPtr, r.srcPitch, r.dstPtr, r.dstPitch, r.width, r.height, r.x, r.y);
+	}
+}
+
+int SDLCALL SurfaceSdlScalerPool::workerProc(void *data) {
+	SurfaceSdlScalerPool *pool = (SurfaceSdlScalerPool *)data;
+
+	for (;;) {
+		SDL_SemWait(pool->_startSem);
+		if (pool->_quit)
+			break;
+
+		pool->processJobs();
+		SDL_SemPost(pool->_doneSem);
+	}
+
+	return 0;
+}
+
+#endif
@@ -0,0 +1,95 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+#define BACKENDS_GRAPHICS_SURFACESDL_SCALERPOOL_H
+
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/array.h"
+#include "common/mutex.h"
+
+class Scaler;
+
+/**
+ * Runs the scaler on several threads.
+ *
+ * Each queued rect is split into horizontal bands, which are distributed
+ * between the worker threads and the calling thread. The bands write to
+ * disjoint parts of the destination, so the queued rects must not overlap.
+ *
+ * Only scalers which do not keep state between calls, i.e. which do not use
+ * the old source, can be run this way.
+ */
+class SurfaceSdlScalerPool {
+public:
+	/**
+	 * Create a pool with one worker per additional CPU core, up to
+	 * kMaxWorkers. Returns nullptr if there is only one core or if threads
+	 * cannot be created.
+	 */
+	static SurfaceSdlScalerPool *create();
+
+	~SurfaceSdlScalerPool();
+
+	enum {
+		kMaxWorkers = 7,
+		kMinBandHeight = 16,      /*!< Minimum number of source lines per job */
+		kMinThreadedPixels = 32768 /*!< Smaller updates are scaled on the calling thread */
+	};
+
+	/** Queue a rect for scaling. The parameters are the same as for Scaler::scale(). */
+	void addRect(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr, uint32 dstPitch,
+	             int width, int height, int x, int y);
+
+	/** Scale all queued rects with the given scaler and wait until they are done. */
+	void run(Scaler *scaler, uint factor);
+
+private:
+	struct Rect {
+		const uint8 *srcPtr;
+		uint32 srcPitch;
+		uint8 *dstPtr;
+		uint32 dstPitch;
+		int width, height;
+		int x, y;
+	};
+
+	SurfaceSdlScalerPool();
+	bool startWorkers(int count);
+
+	void processJobs();
+	static int SDLCALL workerProc(void *data);
+
+	Common::Array<Rect> _rects;
+	Common::Array<Rect> _jobs;
+	Common::Array<SDL_Thread *> _workers;
+
+	Common::Mutex _jobMutex;
+	uint _nextJob;
+	Scaler *_scaler;
+	bool _quit;
+
+	SDL_sem *_startSem;
+	SDL_sem *_doneSem;
+};
+
+#endif
@@ -26,6 +26,7 @@
 #include "backends/mixer/mixer.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 
@@ -190,7 +191,10 @@ void ModularGraphicsBackend::updateScreen() {
 	g_eventRec.preDrawOverlayGui();
 #endif
 
-	_graphicsManager->updateScreen();
+	{
+		PROFILE_ZONE("GraphicsManager::updateScreen");
+		_graphicsManager->updateScreen();
+	}
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.postDrawOverlayGui();
@@ -272,6 +272,20 @@ Common::Path OSystem_MacOSX::getDefaultDLCsPath() {
 	return defaultDLCsPath;
 }
 
+Common::Path OSystem_MacOSX::getDefaultCachePath() {
+	const char *prefix = getenv("HOME");
+	if (prefix == nullptr) {
+		return Common::Path();
+	}
+
+	const Common::String cachePath = Common::String("Library/Caches/") + getMacBundleName();
+	if (!Posix::assureDirectoryExists(cachePath, prefix)) {
+		return Common::Path();
+	}
+
+	return Common::Path(prefix).join(cachePath);
+}
+
 Common::Path OSystem_MacOSX::getScreenshotsPath() {
 	// If the user has configured a screenshots path, use it
 	const Common::Path path = OSystem_SDL::getScreenshotsPath();
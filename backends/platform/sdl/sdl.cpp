@@ -333,6 +333,7 @@ void OSystem_SDL::initBackend() {
 
 	ConfMan.registerDefault("iconspath", this->getDefaultIconsPath());
 	ConfMan.registerDefault("dlcspath", this->getDefaultDLCsPath());
+	ConfMan.registerDefault("cachepath", this->getDefaultCachePath());
 
 	_inited = true;
 
@@ -734,6 +735,16 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -810,6 +821,14 @@ Common::Path OSystem_SDL::getDefaultDLCsPath() {
 	return path;
 }
 
+// Not specified in base class
+Common::Path OSystem_SDL::getDefaultCachePath() {
+	// There is no portable location for this. Platforms without their own
+	// default only get a cache path when the user sets one, and the caches
+	// are kept in memory or disabled until then.
+	return Common::Path();
+}
+
 //Not specified in base class
 Common::Path OSystem_SDL::getScreenshotsPath() {
 	return ConfMan.getPath("screenshotpath");
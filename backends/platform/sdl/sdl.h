@@ -84,6 +84,7 @@ public:
 	void addSysArchivesToSearchSet(Common::SearchSet &s, int priority = 0) override;
 	Common::MutexInternal *createMutex() override;
 	uint32 getMillis(bool skipRecord = false) override;
+	uint64 getMicros() override;
 	void delayMillis(uint msecs) override;
 	void getTimeAndDate(TimeDate &td, bool skipRecord = false) const override;
 	MixerManager *getMixerManager() override;
@@ -94,6 +95,7 @@ public:
 	// Default paths
 	virtual Common::Path getDefaultIconsPath();
 	virtual Common::Path getDefaultDLCsPath();
+	virtual Common::Path getDefaultCachePath();
 	virtual Common::Path getScreenshotsPath();
 
 #if defined(USE_OPENGL_GAME) || defined(USE_OPENGL_SHADERS)
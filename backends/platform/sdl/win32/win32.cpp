@@ -292,6 +292,24 @@ Common::Path OSystem_Win32::getDefaultDLCsPath() {
 	return Common::Path(Win32::tcharToString(dlcsPath));
 }
 
+Common::Path OSystem_Win32::getDefaultCachePath() {
+	TCHAR cachePath[MAX_PATH];
+
+	if (_isPortable) {
+		Win32::getProcessDirectory(cachePath, MAX_PATH);
+		_tcscat(cachePath, TEXT("\\Cache\\"));
+	} else {
+		// Use the Application Data directory of the user profile
+		if (!Win32::getApplicationDataDirectory(cachePath)) {
+			return Common::Path();
+		}
+		_tcscat(cachePath, TEXT("\\Cache\\"));
+		CreateDirectory(cachePath, nullptr);
+	}
+
+	return Common::Path(Win32::tcharToString(cachePath), Common::Path::kNativeSeparator);
+}
+
 Common::Path OSystem_Win32::getScreenshotsPath() {
 	// If the user has configured a screenshots path, use it
 	Common::Path screenshotsPath = ConfMan.getPath("screenshotpath");
@@ -51,6 +51,7 @@ public:
 	// Default paths
 	Common::Path getDefaultIconsPath() override;
 	Common::Path getDefaultDLCsPath() override;
+	Common::Path getDefaultCachePath() override;
 	Common::Path getScreenshotsPath() override;
 
 protected:
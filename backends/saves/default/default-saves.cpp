@@ -37,6 +37,8 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/compression/deflate.h"
+#include "common/endian.h"
+#include "common/ptr.h"
 
 #include <errno.h>	// for removeSavefile()
 
@@ -64,6 +66,13 @@ void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 }
 
 void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFiles) {
+	// The locked files are being replaced by the cloud sync, so whatever
+	// we know about them is about to become stale.
+	for (Common::StringArray::const_iterator i = lockedFiles.begin(), end = lockedFiles.end(); i != end; ++i)
+		invalidateSavefileMetadata(*i);
+	flushSavefileMetadata();
+	_saveIndexes.clear();
+
 	//make it refresh the cache next time it lists the saves
 	_cachedDirectory = "";
 
@@ -84,7 +93,7 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 
 	Common::StringArray results;
 	for (SaveFileCache::const_iterator file = _saveFileCache.begin(), end = _saveFileCache.end(); file != end; ++file) {
-		if (!locked.contains(file->_key) && file->_key.matchString(pattern, true)) {
+		if (!locked.contains(file->_key) && !isSaveIndexFile(file->_key) && file->_key.matchString(pattern, true)) {
 			results.push_back(file->_key);
 		}
 	}
@@ -149,6 +158,8 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	saveTimestamps(timestamps);
 #endif
 
+	invalidateSavefileMetadata(filename);
+
 	// Obtain node.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	Common::FSNode fileNode;
@@ -189,6 +200,8 @@ bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
 	}
 #endif
 
+	invalidateSavefileMetadata(filename);
+
 	// Obtain node if exists.
 	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
 	if (file == _saveFileCache.end()) {
@@ -266,6 +279,7 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 	}
 
 	_saveFileCache.clear();
+	_saveIndexes.clear();
 	_cachedDirectory.clear();
 
 	if (getError().getCode() != Common::kNoError) {
@@ -296,6 +310,121 @@ void DefaultSaveFileManager::assureCached(const Common::Path &savePathName) {
 	_cachedDirectory = savePathName;
 }
 
+#define SAVE_INDEX_PREFIX "saveindex-"
+
+Common::String DefaultSaveFileManager::getSaveIndexName(const Common::String &filename) {
+	// Group by the name without its extension, which usually is the target
+	size_t dot = filename.findLastOf('.');
+	Common::String stem = (dot == Common::String::npos) ? filename : filename.substr(0, dot);
+	return SAVE_INDEX_PREFIX + stem;
+}
+
+bool DefaultSaveFileManager::isSaveIndexFile(const Common::String &filename) {
+	return filename.hasPrefixIgnoreCase(SAVE_INDEX_PREFIX);
+}
+
+SaveIndex &DefaultSaveFileManager::loadSaveIndex(const Common::String &indexName) {
+	SaveIndexCache::iterator it = _saveIndexes.find(indexName);
+	if (it != _saveIndexes.end())
+		return it->_value;
+
+	SaveIndex &index = _saveIndexes[indexName];
+
+	Common::ScopedPtr<Common::InSaveFile> in(openRawFile(indexName));
+	if (in)
+		index.load(*in);
+
+	return index;
+}
+
+void DefaultSaveFileManager::writeSaveIndex(const Common::String &indexName, SaveIndex &index) {
+	SaveFileCache::const_iterator file = _saveFileCache.find(indexName);
+
+	if (index.empty()) {
+		if (file != _saveFileCache.end()) {
+			const Common::FSNode fileNode = file->_value;
+			_saveFileCache.erase(file);
+			removeFile(fileNode);
+		}
+		return;
+	}
+
+	// Bypass openForSaving(), the index must neither be compressed nor
+	// invalidate itself.
+	Common::FSNode fileNode;
+	if (file == _saveFileCache.end())
+		fileNode = Common::FSNode(getSavePath()).getChild(indexName);
+	else
+		fileNode = file->_value;
+
+	Common::ScopedPtr<Common::SeekableWriteStream> out(fileNode.createWriteStream());
+	if (!out)
+		return;
+
+	index.save(*out);
+	out->finalize();
+
+	_saveFileCache[indexName] = Common::FSNode(fileNode.getPath());
+}
+
+bool DefaultSaveFileManager::getSavefileInfo(const Common::String &filename, int64 &size, int64 &modification) const {
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	return file != _saveFileCache.end() && file->_value.getFileInfo(size, modification);
+}
+
+bool DefaultSaveFileManager::getSavefileMetadata(const Common::String &filename, Common::Array<byte> &metadata) {
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError || isSaveIndexFile(filename))
+		return false;
+
+	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
+		if (filename == *i)
+			return false;
+	}
+
+	// Without a way to tell whether the file changed, nothing is trusted
+	int64 size, modification;
+	if (!getSavefileInfo(filename, size, modification))
+		return false;
+
+	return loadSaveIndex(getSaveIndexName(filename)).get(filename, size, modification, metadata);
+}
+
+void DefaultSaveFileManager::setSavefileMetadata(const Common::String &filename, const Common::Array<byte> &metadata) {
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError || isSaveIndexFile(filename))
+		return;
+
+	// Only describe files which actually exist
+	int64 size, modification;
+	if (!getSavefileInfo(filename, size, modification))
+		return;
+
+	loadSaveIndex(getSaveIndexName(filename)).set(filename, size, modification, metadata);
+}
+
+void DefaultSaveFileManager::flushSavefileMetadata() {
+	for (SaveIndexCache::iterator it = _saveIndexes.begin(); it != _saveIndexes.end(); ++it) {
+		if (it->_value.isDirty())
+			writeSaveIndex(it->_key, it->_value);
+	}
+}
+
+void DefaultSaveFileManager::invalidateSavefileMetadata(const Common::String &filename) {
+	if (isSaveIndexFile(filename))
+		return;
+
+	const Common::String indexName = getSaveIndexName(filename);
+
+	// Nothing to do when there is no index for this group yet
+	if (!_saveIndexes.contains(indexName) && !_saveFileCache.contains(indexName))
+		return;
+
+	SaveIndex &index = loadSaveIndex(indexName);
+	if (index.remove(filename))
+		writeSaveIndex(indexName, index);
+}
+
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 
 Common::HashMap<Common::String, uint32> DefaultSaveFileManager::loadTimestamps() {
@@ -28,6 +28,8 @@
 #include "common/fs.h"
 #include "common/hash-str.h"
 
+#include "backends/saves/default/save-index.h"
+
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
@@ -44,6 +46,10 @@ public:
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
 
+	bool getSavefileMetadata(const Common::String &filename, Common::Array<byte> &metadata) override;
+	void setSavefileMetadata(const Common::String &filename, const Common::Array<byte> &metadata) override;
+	void flushSavefileMetadata() override;
+
 #ifdef USE_LIBCURL
 
 	static const uint32 INVALID_TIMESTAMP = UINT_MAX;
@@ -99,6 +105,33 @@ protected:
 	 */
 	Common::StringArray _lockedFiles;
 
+	typedef Common::HashMap<Common::String, SaveIndex, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SaveIndexCache;
+
+	/**
+	 * Metadata indexes loaded so far, keyed by index file name. Save files
+	 * are grouped into one index per file name stem, which in practice
+	 * means one index per target.
+	 */
+	SaveIndexCache _saveIndexes;
+
+	static Common::String getSaveIndexName(const Common::String &filename);
+	static bool isSaveIndexFile(const Common::String &filename);
+
+	SaveIndex &loadSaveIndex(const Common::String &indexName);
+	void writeSaveIndex(const Common::String &indexName, SaveIndex &index);
+
+	/**
+	 * Get the size and modification time of a save file, which the index
+	 * uses to tell whether its metadata is still current.
+	 */
+	bool getSavefileInfo(const Common::String &filename, int64 &size, int64 &modification) const;
+
+	/**
+	 * Drop the cached metadata of the given save file.
+	 * This is called whenever the file is written to or removed.
+	 */
+	void invalidateSavefileMetadata(const Common::String &filename);
+
 private:
 	/**
 	 * The currently cached directory.
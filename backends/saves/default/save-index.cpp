@@ -0,0 +1,109 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "backends/saves/default/save-index.h"
+
+#include "common/endian.h"
+#include "common/stream.h"
+
+#define SAVE_INDEX_VERSION 2
+
+bool SaveIndex::load(Common::SeekableReadStream &in) {
+	_entries.clear();
+	_dirty = false;
+
+	if (in.readUint32BE() != MKTAG('S', 'I', 'D', 'X') || in.readUint16LE() != SAVE_INDEX_VERSION || in.err() || in.eos())
+		return false;
+
+	uint32 count = in.readUint32LE();
+	for (uint32 i = 0; i < count && !in.eos() && !in.err(); i++) {
+		Common::String name = in.readPascalString();
+		int64 size = in.readSint64LE();
+		int64 modification = in.readSint64LE();
+		uint32 metadataSize = in.readUint32LE();
+		if (metadataSize > (uint32)(in.size() - in.pos()))
+			break;
+
+		Entry &entry = _entries[name];
+		entry.size = size;
+		entry.modification = modification;
+		entry.metadata.resize(metadataSize);
+		if (metadataSize)
+			in.read(entry.metadata.data(), metadataSize);
+	}
+
+	// A truncated index is simply rebuilt on the next listing
+	if (in.err() || in.eos() || _entries.size() != count) {
+		_entries.clear();
+		return false;
+	}
+
+	return true;
+}
+
+void SaveIndex::save(Common::WriteStream &out) {
+	_dirty = false;
+
+	out.writeUint32BE(MKTAG('S', 'I', 'D', 'X'));
+	out.writeUint16LE(SAVE_INDEX_VERSION);
+	out.writeUint32LE(_entries.size());
+
+	for (EntryMap::const_iterator it = _entries.begin(); it != _entries.end(); ++it) {
+		out.writeByte(it->_key.size());
+		out.writeString(it->_key);
+		out.writeSint64LE(it->_value.size);
+		out.writeSint64LE(it->_value.modification);
+		out.writeUint32LE(it->_value.metadata.size());
+		if (!it->_value.metadata.empty())
+			out.write(it->_value.metadata.data(), it->_value.metadata.size());
+	}
+}
+
+bool SaveIndex::get(const Common::String &filename, int64 size, int64 modification, Common::Array<byte> &metadata) const {
+	EntryMap::const_iterator it = _entries.find(filename);
+	if (it == _entries.end() || it->_value.size != size || it->_value.modification != modification)
+		return false;
+
+	metadata = it->_value.metadata;
+	return true;
+}
+
+void SaveIndex::set(const Common::String &filename, int64 size, int64 modification, const Common::Array<byte> &metadata) {
+	// Names are stored with a single length byte
+	if (filename.size() > 0xFF)
+		return;
+
+	Entry &entry = _entries[filename];
+	entry.size = size;
+	entry.modification = modification;
+	entry.metadata = metadata;
+	_dirty = true;
+}
+
+bool SaveIndex::remove(const Common::String &filename) {
+	EntryMap::iterator it = _entries.find(filename);
+	if (it == _entries.end())
+		return false;
+
+	_entries.erase(it);
+	_dirty = true;
+	return true;
+}
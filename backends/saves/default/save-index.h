@@ -0,0 +1,90 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKEND_SAVES_SAVE_INDEX_H
+#define BACKEND_SAVES_SAVE_INDEX_H
+
+#include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/str.h"
+
+namespace Common {
+class SeekableReadStream;
+class WriteStream;
+}
+
+/**
+ * Metadata of a group of save files, as stored in one index file.
+ *
+ * Every entry remembers the size and the modification time its save file
+ * had when the metadata was stored. Entries are only handed out while the
+ * file still matches them, so saves copied in or edited by other tools are
+ * read again.
+ */
+class SaveIndex {
+public:
+	SaveIndex() : _dirty(false) {}
+
+	/**
+	 * Read the entries of an index file, replacing the current ones.
+	 * A missing, outdated or truncated index leaves the index empty.
+	 */
+	bool load(Common::SeekableReadStream &in);
+
+	/**
+	 * Write the entries to an index file.
+	 */
+	void save(Common::WriteStream &out);
+
+	/**
+	 * Get the metadata stored for a save file which now has the given size
+	 * and modification time.
+	 */
+	bool get(const Common::String &filename, int64 size, int64 modification, Common::Array<byte> &metadata) const;
+
+	void set(const Common::String &filename, int64 size, int64 modification, const Common::Array<byte> &metadata);
+
+	/**
+	 * Drop the entry of the given save file.
+	 * @return true if there was an entry to drop.
+	 */
+	bool remove(const Common::String &filename);
+
+	bool empty() const { return _entries.empty(); }
+
+	/** Whether entries changed since the index was last loaded or saved. */
+	bool isDirty() const { return _dirty; }
+
+private:
+	struct Entry {
+		int64 size;
+		int64 modification;
+		Common::Array<byte> metadata;
+	};
+
+	typedef Common::HashMap<Common::String, Entry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> EntryMap;
+
+	EntryMap _entries;
+	bool _dirty;
+};
+
+#endif
@@ -162,6 +162,7 @@ static const char HELP_STRING4[] =
 	"  --savepath=PATH          Path to where saved games are stored\n"
 	"  --extrapath=PATH         Extra path to additional game data\n"
 	"  --iconspath=PATH         Path to additional icons for the launcher grid view\n"
+	"  --cachepath=PATH         Path to where rendered music is cached\n"
 	"  --soundfont=FILE         Select the SoundFont for MIDI playback (only\n"
 	"                           supported by some MIDI drivers)\n"
 	"  --multi-midi             Enable combination AdLib and native MIDI\n"
@@ -194,13 +195,19 @@ static const char HELP_STRING4[] =
 	"                           atari, macintosh, macintoshbw, vgaGray)\n"
 #ifdef ENABLE_EVENTRECORDER
 	"  --record-mode=MODE       Specify record mode for event recorder (record, playback,\n"
-	"                           info, update, passthrough [default])\n"
+	"                           benchmark, info, update, passthrough [default])\n"
 	"  --record-file-name=FILE  Specify record file name\n"
+	"  --benchmark-file=FILE    When benchmarking, write the frame timings as JSON to\n"
+	"                           FILE (default: record file name with .json appended)\n"
 	"  --disable-display        Disable any gfx output. Used for headless events\n"
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
 	"                           (default: 60000)\n"
 	"  --list-records           Display a list of recordings for the target specified\n"
+#endif
+#ifdef ENABLE_PROFILER
+	"  --profile-trace=FILE     Write a timeline of the profiling zones to FILE in the\n"
+	"                           Chrome trace event format\n"
 #endif
 	"\n"
 #if defined(ENABLE_SKY) || defined(ENABLE_QUEEN)
@@ -318,6 +325,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("synth_render_ahead", 0);
+	ConfMan.registerDefault("midi_render_cache", false);
+	ConfMan.registerDefault("audio_cache_size", 4096);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -373,6 +383,8 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("benchmark_file", "");
+	ConfMan.registerDefault("profile_trace", "");
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -787,6 +799,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("record-file-name")
 			END_OPTION
 
+			DO_LONG_OPTION("benchmark-file")
+			END_OPTION
+
 			DO_LONG_COMMAND("list-records")
 			END_COMMAND
 
@@ -794,6 +809,11 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			END_OPTION
 #endif
 
+#ifdef ENABLE_PROFILER
+			DO_LONG_OPTION("profile-trace")
+			END_OPTION
+#endif
+
 			DO_LONG_OPTION("opl-driver")
 			END_OPTION
 
@@ -917,6 +937,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_PATH("iconspath")
 			END_OPTION
 
+			DO_LONG_OPTION_PATH("cachepath")
+			END_OPTION
+
 			DO_LONG_OPTION("md5-path")
 				// While the --md5 command expect a file name, the --md5mac may take a base name.
 				// Thus we do not check that the file exists here.
@@ -2102,6 +2125,7 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 		"savepath",
 		"extrapath",
 		"iconspath",
+		"cachepath",
 		"screenshotpath",
 		"soundfont",
 		"multi-midi",
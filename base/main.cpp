@@ -52,6 +52,7 @@
 #include "common/translation.h"
 #include "common/text-to-speech.h"
 #include "common/osd_message_queue.h"
+#include "common/profiler.h"
 
 #include "gui/gui-manager.h"
 #include "gui/error.h"
@@ -779,6 +780,12 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderUpdate);
 			} else if (recordMode == "playback") {
 				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
+			} else if (recordMode == "benchmark") {
+				Common::String reportFileName = ConfMan.get("benchmark_file");
+				if (reportFileName.empty())
+					reportFileName = recordFileName + ".json";
+				g_eventRec.enableBenchmark(reportFileName);
+				g_eventRec.init(recordFileName, GUI::EventRecorder::kRecorderPlayback);
 			} else if ((recordMode == "info") && (!recordFileName.empty())) {
 				Common::PlaybackFile record;
 				record.openRead(recordFileName);
@@ -787,6 +794,13 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 				DebugMan.removeAllDebugChannels();
 				break;
 			}
+#endif
+#ifdef ENABLE_PROFILER
+			// Instantiate the profiler before any zone can be entered from
+			// another thread
+			Common::Profiler &profiler = Common::Profiler::instance();
+			if (!ConfMan.get("profile_trace").empty())
+				profiler.startTrace(ConfMan.get("profile_trace"));
 #endif
 			Common::TextToSpeechManager *ttsMan = g_system->getTextToSpeechManager();
 			if (ttsMan != nullptr) {
@@ -797,6 +811,10 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			if (ttsMan != nullptr) {
 				ttsMan->popState();
 			}
+#ifdef ENABLE_PROFILER
+			if (profiler.isTracing())
+				profiler.stopTrace();
+#endif
 
 			DebugMan.removeAllDebugChannels();
 
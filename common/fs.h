@@ -252,6 +252,18 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Get the size and the last modification time of the file referred by
+	 * this node. The modification time is in seconds, and is only meant to
+	 * be compared with other values returned by this function.
+	 *
+	 * @param size          Set to the size of the file in bytes.
+	 * @param modification  Set to the modification time of the file.
+	 *
+	 * @return True if both values could be determined, false otherwise.
+	 */
+	bool getFileInfo(int64 &size, int64 &modification) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
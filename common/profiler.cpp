@@ -0,0 +1,171 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+
+#ifdef ENABLE_PROFILER
+
+#include "common/file.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+Profiler::Profiler() : _tracing(false), _droppedTraceEvents(0) {
+}
+
+void Profiler::recordZone(ProfileZoneSite &site, uint64 start, uint64 end) {
+	const uint32 duration = (uint32)MIN<uint64>(end - start, 0xFFFFFFFF);
+
+	StackLock lock(_mutex);
+
+	if (site.id < 0) {
+		ZoneCounters zone;
+		zone.name = site.name;
+		zone.track = site.track;
+		zone.calls = 0;
+		zone.totalTime = 0;
+		zone.lastTime = 0;
+		zone.maxTime = 0;
+
+		site.id = _zones.size();
+		_zones.push_back(zone);
+	}
+
+	ZoneCounters &zone = _zones[site.id];
+	zone.calls++;
+	zone.totalTime += duration;
+	zone.lastTime = duration;
+	zone.maxTime = MAX(zone.maxTime, duration);
+
+	if (_tracing) {
+		if (_traceEvents.size() < kMaxTraceEvents) {
+			TraceEvent event;
+			event.start = start;
+			event.duration = duration;
+			event.zone = site.id;
+			_traceEvents.push_back(event);
+		} else {
+			_droppedTraceEvents++;
+		}
+	}
+}
+
+void Profiler::getCounters(Array<ZoneCounters> &counters) {
+	StackLock lock(_mutex);
+	counters = _zones;
+}
+
+void Profiler::resetCounters() {
+	StackLock lock(_mutex);
+
+	for (uint i = 0; i < _zones.size(); i++) {
+		_zones[i].calls = 0;
+		_zones[i].totalTime = 0;
+		_zones[i].lastTime = 0;
+		_zones[i].maxTime = 0;
+	}
+}
+
+void Profiler::startTrace(const String &fileName) {
+	StackLock lock(_mutex);
+
+	_tracing = true;
+	_traceFileName = fileName;
+	_traceEvents.clear();
+	_droppedTraceEvents = 0;
+}
+
+bool Profiler::stopTrace() {
+	Array<TraceEvent> events;
+	Array<ZoneCounters> zones;
+	String fileName;
+	uint32 dropped;
+
+	// Take the events out so that zones on other threads are not blocked
+	// while writing the file
+	{
+		StackLock lock(_mutex);
+		if (!_tracing)
+			return false;
+
+		_tracing = false;
+		SWAP(events, _traceEvents);
+		zones = _zones;
+		fileName = _traceFileName;
+		dropped = _droppedTraceEvents;
+	}
+
+	if (dropped)
+		warning("Profiler: %u zone calls did not fit in the trace", dropped);
+
+	DumpFile trace;
+	if (!trace.open(Path(fileName, Path::kNativeSeparator))) {
+		warning("Profiler: Could not open '%s' for writing", fileName.c_str());
+		return false;
+	}
+
+	// Zones of the same track share a thread id in the timeline
+	Array<const char *> tracks;
+	Array<uint> trackIds;
+	for (uint i = 0; i < zones.size(); i++) {
+		uint id = 0;
+		while (id < tracks.size() && strcmp(tracks[id], zones[i].track))
+			id++;
+		if (id == tracks.size())
+			tracks.push_back(zones[i].track);
+		trackIds.push_back(id);
+	}
+
+	trace.writeString("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	for (uint i = 0; i < tracks.size(); i++) {
+		trace.writeString(String::format("%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+			i ? ",\n" : "", i, tracks[i]));
+	}
+
+	// Timestamps are made relative to the earliest zone to keep them short.
+	// Events are stored in the order the zones ended, so this is not
+	// necessarily the first one.
+	uint64 base = events.empty() ? 0 : events[0].start;
+	for (uint i = 1; i < events.size(); i++)
+		base = MIN(base, events[i].start);
+
+	for (uint i = 0; i < events.size(); i++) {
+		const TraceEvent &event = events[i];
+		trace.writeString(String::format(",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%llu,\"dur\":%u}",
+			zones[event.zone].name, trackIds[event.zone], (unsigned long long)(event.start - base), event.duration));
+	}
+
+	trace.writeString("\n]}\n");
+	trace.finalize();
+
+	if (trace.err()) {
+		warning("Profiler: Could not write '%s'", fileName.c_str());
+		return false;
+	}
+	return true;
+}
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief Scoped zone profiling of hot code paths.
+ *
+ * A zone measures the time spent between its declaration and the end of the
+ * enclosing scope:
+ *
+ * @code
+ * void Foo::drawFrame() {
+ *     PROFILE_ZONE("Foo::drawFrame");
+ *     ...
+ * }
+ * @endcode
+ *
+ * Zones running on a thread other than the main one should be declared with
+ * PROFILE_ZONE_TRACK() so that they end up on their own line of the timeline.
+ *
+ * The zones are only compiled in when configured with --enable-profiler;
+ * otherwise the macros expand to nothing.
+ * @{
+ */
+
+#ifdef ENABLE_PROFILER
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/singleton.h"
+#include "common/str.h"
+#include "common/system.h"
+
+namespace Common {
+
+/**
+ * Static description of a profiling zone.
+ *
+ * Every PROFILE_ZONE() instantiates one of these, which is constant
+ * initialized and registered with the profiler on first use.
+ */
+struct ProfileZoneSite {
+	const char *name;  /*!< Name of the zone */
+	const char *track; /*!< Timeline track the zone is displayed on */
+	int id;            /*!< Index assigned by the profiler, -1 until registered */
+};
+
+class Profiler : public Singleton<Profiler> {
+public:
+	/** Counters accumulated for a zone since the last reset. */
+	struct ZoneCounters {
+		const char *name;
+		const char *track;
+		uint32 calls;
+		uint64 totalTime; /*!< Total time spent in the zone, in microseconds */
+		uint32 lastTime;  /*!< Duration of the last call, in microseconds */
+		uint32 maxTime;   /*!< Duration of the longest call, in microseconds */
+	};
+
+	enum {
+		kMaxTraceEvents = 1 << 20 /*!< Maximum number of zone calls kept in a trace */
+	};
+
+	Profiler();
+
+	/** Record a call of a zone. Can be called from any thread. */
+	void recordZone(ProfileZoneSite &site, uint64 start, uint64 end);
+
+	/** Get a copy of the counters of all zones which have been entered so far. */
+	void getCounters(Array<ZoneCounters> &counters);
+
+	/** Reset the counters of all zones. */
+	void resetCounters();
+
+	/**
+	 * Start recording every zone call for a timeline.
+	 *
+	 * The timeline is written in the Chrome trace event format, which can be
+	 * opened in chrome://tracing or Perfetto, when stopTrace() is called.
+	 */
+	void startTrace(const String &fileName);
+
+	/** Stop recording the timeline and write it. Returns false on failure. */
+	bool stopTrace();
+
+	bool isTracing() const { return _tracing; }
+
+private:
+	struct TraceEvent {
+		uint64 start;
+		uint32 duration;
+		uint16 zone;
+	};
+
+	Mutex _mutex;
+	Array<ZoneCounters> _zones;
+
+	bool _tracing;
+	String _traceFileName;
+	Array<TraceEvent> _traceEvents;
+	uint32 _droppedTraceEvents;
+};
+
+/**
+ * Measures the lifetime of the object as a call of the given zone.
+ */
+class ProfileZone {
+public:
+	ProfileZone(ProfileZoneSite &site) : _site(site), _start(g_system->getMicros()) {}
+	~ProfileZone() { Profiler::instance().recordZone(_site, _start, g_system->getMicros()); }
+
+private:
+	ProfileZoneSite &_site;
+	uint64 _start;
+};
+
+} // End of namespace Common
+
+#define PROFILE_ZONE_CONCAT_(a, b) a ## b
+#define PROFILE_ZONE_CONCAT(a, b) PROFILE_ZONE_CONCAT_(a, b)
+
+/** Profile the rest of the enclosing scope as a zone of the given track. */
+#define PROFILE_ZONE_TRACK(name, track) \
+	static Common::ProfileZoneSite PROFILE_ZONE_CONCAT(profileZoneSite, __LINE__) = { name, track, -1 }; \
+	Common::ProfileZone PROFILE_ZONE_CONCAT(profileZone, __LINE__)(PROFILE_ZONE_CONCAT(profileZoneSite, __LINE__))
+
+#else
+
+#define PROFILE_ZONE_TRACK(name, track)
+
+#endif
+
+/** Profile the rest of the enclosing scope as a zone of the main thread. */
+#define PROFILE_ZONE(name) PROFILE_ZONE_TRACK(name, "main")
+
+/** @} */
+
+#endif
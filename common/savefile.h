@@ -276,6 +276,37 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Retrieve the metadata cached for the given save file.
+	 *
+	 * The metadata is an opaque blob previously stored with setSavefileMetadata().
+	 * Implementations drop it whenever the save file is written to or removed,
+	 * so a cached blob always describes the current content of the file.
+	 *
+	 * @param name      Name of the save file.
+	 * @param metadata  Array receiving the cached metadata.
+	 *
+	 * @return true if metadata was cached for this file, false otherwise.
+	 */
+	virtual bool getSavefileMetadata(const String &name, Array<byte> &metadata) { return false; }
+
+	/**
+	 * Cache metadata for the given save file.
+	 *
+	 * The metadata is kept in a small index next to the save files, so that
+	 * listing saves does not require opening and parsing each one of them.
+	 * Call flushSavefileMetadata() to write the changes to disk.
+	 *
+	 * @param name      Name of the save file.
+	 * @param metadata  Metadata to store.
+	 */
+	virtual void setSavefileMetadata(const String &name, const Array<byte> &metadata) {}
+
+	/**
+	 * Write the metadata cached by setSavefileMetadata() to disk.
+	 */
+	virtual void flushSavefileMetadata() {}
 };
 
 /** @} */
@@ -255,6 +255,10 @@ bool OSystem::isConnectionLimited() {
 	return false;
 }
 
+uint64 OSystem::getMicros() {
+	return (uint64)getMillis(true) * 1000;
+}
+
 Common::TimerManager *OSystem::getTimerManager() {
 	return _timerManager;
 }
@@ -1510,6 +1510,15 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get the number of microseconds since an arbitrary point in time.
+	 *
+	 * This is meant for measuring short intervals, such as by the profiler,
+	 * and is never recorded by the event recorder. The default implementation
+	 * only has the resolution of getMillis().
+	 */
+	virtual uint64 getMicros();
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -33,8 +33,10 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_debug_groups_list",   WRAP_METHOD(AGSConsole, Cmd_listDebugGroups));
 	registerCmd("ags_debug_groups_set",  WRAP_METHOD(AGSConsole, Cmd_setDebugGroupLevel));
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
+	registerCmd("ags_show_dirty_rects", WRAP_METHOD(AGSConsole, Cmd_ShowDirtyRects));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_sprite_cache_stats",  WRAP_METHOD(AGSConsole, Cmd_spriteCacheStats));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -184,6 +186,17 @@ bool AGSConsole::Cmd_SetScriptDump(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_ShowDirtyRects(int argc, const char **argv) {
+	if (argc != 2) {
+		debugPrintf("Usage: %s [on|off]\n", argv[0]);
+		debugPrintf("Outlines the screen regions redrawn on each frame by the software renderer\n");
+		return true;
+	}
+
+	_G(debugDirtyRects) = strcmp(argv[1], "on") == 0 || strcmp(argv[1], "true") == 0;
+	return true;
+}
+
 bool AGSConsole::Cmd_getSpriteInfo(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Usage: %s SpriteNumber\n", argv[0]);
@@ -244,6 +257,28 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCacheStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	if (argc == 2) {
+		_GP(spriteset).ResetStats();
+		return true;
+	}
+
+	const AGS3::AGS::Shared::SpriteCache::Stats &stats = _GP(spriteset).GetStats();
+	debugPrintf("Cache size: %u KB of %u KB, %u KB locked\n", (uint)(_GP(spriteset).GetCacheSize() / 1024),
+		(uint)(_GP(spriteset).GetMaxCacheSize() / 1024), (uint)(_GP(spriteset).GetLockedSize() / 1024));
+	debugPrintf("Hits: %u, of which %u preloaded\n", stats.Hits, stats.PreloadHits);
+	debugPrintf("Misses: %u, loaded in %u ms\n", stats.Misses, stats.MissTime);
+	debugPrintf("Preloaded: %u, loaded in %u ms, %u still queued\n", stats.Preloaded, stats.PreloadTime,
+		(uint)_GP(spriteset).GetPreloadQueueSize());
+	debugPrintf("Evictions: %u\n", stats.Evictions);
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/profiler.h"
 #include "common/std/algorithm.h"
 #include "ags/lib/aastr-0.1.1/aastr.h"
 #include "ags/shared/core/platform.h"
@@ -1787,7 +1788,10 @@ void prepare_room_sprites() {
 void draw_preroom_background() {
 	if (_G(gfxDriver)->RequiresFullRedrawEachFrame())
 		return;
-	update_black_invreg_and_reset(_G(gfxDriver)->GetMemoryBackBuffer());
+	// NOTE: we use the stage buffer, which is the virtual screen outside of the render pass,
+	// and report the painted area ourselves; the memory backbuffer would be presented whole.
+	const Rect painted = update_black_invreg_and_reset(_G(gfxDriver)->GetStageBackBuffer(false));
+	_G(gfxDriver)->MarkBackBufferDirty(painted);
 }
 
 // Draws the room background on the given surface.
@@ -1807,7 +1811,8 @@ PBitmap draw_room_background(Viewport *view) {
 	// 32-bit virtual screen).
 	// Also see comment to ALSoftwareGraphicsDriver::RenderToBackBuffer().
 	const int view_index = view->GetID();
-	Bitmap *ds = _G(gfxDriver)->GetMemoryBackBuffer();
+	// NOTE: see draw_preroom_background() for why the stage buffer is used here
+	Bitmap *ds = _G(gfxDriver)->GetStageBackBuffer(false);
 	// If separate bitmap was prepared for this view/camera pair then use it, draw untransformed
 	// and blit transformed whole surface later.
 	const bool draw_to_camsurf = _GP(CameraDrawData)[view_index].Frame != nullptr;
@@ -1824,7 +1829,10 @@ PBitmap draw_room_background(Viewport *view) {
 		// the following line takes up to 50% of the game CPU time at
 		// high resolutions and colour depths - if we can optimise it
 		// somehow, significant performance gains to be had
-		update_room_invreg_and_reset(view_index, roomcam_surface, _GP(thisroom).BgFrames[_GP(play).bg_frame].Graphic.get(), draw_to_camsurf);
+		const Rect painted = update_room_invreg_and_reset(view_index, roomcam_surface, _GP(thisroom).BgFrames[_GP(play).bg_frame].Graphic.get(), draw_to_camsurf);
+		// The separate camera surface is not tracked by the renderer
+		if (!draw_to_camsurf)
+			_G(gfxDriver)->MarkBackBufferDirty(painted);
 	}
 
 	return _GP(CameraDrawData)[view_index].Frame;
@@ -2394,6 +2402,8 @@ void update_room_debug() {
 
 // Draw everything
 void render_graphics(IDriverDependantBitmap *extraBitmap, int extraX, int extraY) {
+	PROFILE_ZONE("AGS::render_graphics");
+
 	// Don't render if skipping cutscene
 	if (_GP(play).fast_forward)
 		return;
@@ -311,9 +311,9 @@ void invalidate_rect_global(int x1, int y1, int x2, int y2) {
 // while room background was 16-bit and Allegro lib does not support stretching between colour depths.
 // The no_transform flag here means essentially "no offset", and indicates that the function
 // must blit src on ds at 0;0. Otherwise, actual Viewport offset is used.
-void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, bool no_transform) {
+Rect update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, bool no_transform) {
 	if (rects.NumDirtyRegions == 0)
-		return;
+		return Rect();
 
 	if (!no_transform)
 		ds->SetClip(rects.Viewport);
@@ -323,11 +323,20 @@ void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, boo
 	const int dst_x = no_transform ? 0 : rects.Viewport.Left;
 	const int dst_y = no_transform ? 0 : rects.Viewport.Top;
 
+	Rect painted;
 	if (rects.NumDirtyRegions == WHOLESCREENDIRTY) {
 		ds->Blit(src, src_x, src_y, dst_x, dst_y, rects.SurfaceSize.Width, rects.SurfaceSize.Height);
+		painted = RectWH(dst_x, dst_y, rects.SurfaceSize.Width, rects.SurfaceSize.Height);
 	} else {
 		const std::vector<IRRow> &dirtyRow = rects.DirtyRows;
 		const int surf_height = rects.SurfaceSize.Height;
+		// Bounds of the painted area, for the renderer to know what to present
+		for (int i = 0; i < surf_height; i++) {
+			for (int k = 0; k < dirtyRow[i].numSpans; k++) {
+				const Rect span(dirtyRow[i].span[k].x1 + dst_x, i + dst_y, dirtyRow[i].span[k].x2 + dst_x, i + dst_y);
+				painted = painted.IsEmpty() ? span : SumRects(painted, span);
+			}
+		}
 		// TODO: is this IsMemoryBitmap check is still relevant?
 		// If bitmaps properties match and no transform required other than linear offset
 		if (src->GetColorDepth() == ds->GetColorDepth()) {
@@ -362,13 +371,16 @@ void update_invalid_region(Bitmap *ds, Bitmap *src, const DirtyRects &rects, boo
 			}
 		}
 	}
+	return painted;
 }
 
-void update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rects) {
+Rect update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rects) {
 	ds->SetClip(rects.Viewport);
 
+	Rect painted;
 	if (rects.NumDirtyRegions == WHOLESCREENDIRTY) {
 		ds->FillRect(rects.Viewport, fill_color);
+		painted = rects.Viewport;
 	} else {
 		const std::vector<IRRow> &dirtyRow = rects.DirtyRows;
 		const int surf_height = rects.SurfaceSize.Height;
@@ -385,25 +397,29 @@ void update_invalid_region(Bitmap *ds, color_t fill_color, const DirtyRects &rec
 					Rect src_r(dirty_row.span[k].x1, i, dirty_row.span[k].x2, i + rowsInOne - 1);
 					Rect dst_r = tf.ScaleRange(src_r);
 					ds->FillRect(dst_r, fill_color);
+					painted = painted.IsEmpty() ? dst_r : SumRects(painted, dst_r);
 				}
 			}
 		}
 	}
+	return IntersectRects(painted, rects.Viewport);
 }
 
-void update_black_invreg_and_reset(Bitmap *ds) {
+Rect update_black_invreg_and_reset(Bitmap *ds) {
 	if (!_GP(BlackRects).IsInit())
-		return;
-	update_invalid_region(ds, (color_t)0, _GP(BlackRects));
+		return Rect();
+	const Rect painted = update_invalid_region(ds, (color_t)0, _GP(BlackRects));
 	_GP(BlackRects).Reset();
+	return painted;
 }
 
-void update_room_invreg_and_reset(int view_index, Bitmap *ds, Bitmap *src, bool no_transform) {
+Rect update_room_invreg_and_reset(int view_index, Bitmap *ds, Bitmap *src, bool no_transform) {
 	if (view_index < 0 || _GP(RoomCamRects).size() == 0)
-		return;
+		return Rect();
 
-	update_invalid_region(ds, src, _GP(RoomCamRects)[view_index], no_transform);
+	const Rect painted = update_invalid_region(ds, src, _GP(RoomCamRects)[view_index], no_transform);
 	_GP(RoomCamRects)[view_index].Reset();
+	return painted;
 }
 
 } // namespace AGS3
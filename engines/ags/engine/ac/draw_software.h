@@ -105,11 +105,13 @@ void invalidate_all_camera_rects(int view_index);
 void invalidate_rect_ds(int x1, int y1, int x2, int y2, bool in_room);
 // Mark rectangle dirty, treat pos as global screen coords (not offset by legacy letterbox mode)
 void invalidate_rect_global(int x1, int y1, int x2, int y2);
-// Paints the black screen background in the regions marked as dirty
-void update_black_invreg_and_reset(AGS::Shared::Bitmap *ds);
+// Paints the black screen background in the regions marked as dirty;
+// returns the bounds of the painted area
+Rect update_black_invreg_and_reset(AGS::Shared::Bitmap *ds);
 // Copies the room regions marked as dirty from source (src) to destination (ds) with the given offset (x, y)
 // no_transform flag tells the system that the regions should be plain copied to the ds.
-void update_room_invreg_and_reset(int view_index, AGS::Shared::Bitmap *ds, AGS::Shared::Bitmap *src, bool no_transform);
+// Returns the bounds of the painted area on ds.
+Rect update_room_invreg_and_reset(int view_index, AGS::Shared::Bitmap *ds, AGS::Shared::Bitmap *src, bool no_transform);
 
 } // namespace AGS3
 
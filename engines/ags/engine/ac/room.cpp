@@ -44,6 +44,7 @@
 #include "ags/engine/ac/room.h"
 #include "ags/engine/ac/room_object.h"
 #include "ags/engine/ac/room_status.h"
+#include "ags/engine/ac/view_frame.h"
 #include "ags/engine/ac/screen.h"
 #include "ags/engine/ac/string.h"
 #include "ags/engine/ac/system.h"
@@ -398,6 +399,28 @@ static void reset_temp_room() {
 	_GP(troom) = RoomStatus();
 }
 
+// Queues the sprites which the room objects and the characters in the room
+// are likely to show soon, so that they are loaded in the spare frame time
+// rather than when they are first drawn
+static void preload_room_sprites() {
+	_GP(spriteset).ClearPreloadQueue();
+	for (size_t cc = 0; cc < _G(croom)->numobj; cc++) {
+		if (_G(objs)[cc].view != RoomObject::NoView)
+			preload_view(_G(objs)[cc].view);
+		else
+			_GP(spriteset).QueuePreload(_G(objs)[cc].num);
+	}
+	for (int cc = 0; cc < _GP(game).numcharacters; cc++) {
+		const CharacterInfo &chi = _GP(game).chars[cc];
+		if (chi.room != _G(displayed_room))
+			continue;
+		preload_view(chi.view);
+		preload_view(chi.defview);
+		preload_view(chi.idleview);
+		preload_view(chi.talkview);
+	}
+}
+
 // forchar = playerchar on NewRoom, or NULL if restore saved game
 void load_new_room(int newnum, CharacterInfo *forchar) {
 
@@ -845,6 +868,8 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 	if (_GP(game).color_depth > 1)
 		setpal();
 
+	preload_room_sprites();
+
 	_G(our_eip) = 220;
 	update_polled_stuff();
 	debug_script_log("Now in room %d", _G(displayed_room));
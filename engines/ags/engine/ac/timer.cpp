@@ -23,6 +23,7 @@
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/core/platform.h"
 #include "ags/engine/ac/sys_events.h"
+#include "ags/shared/ac/sprite_cache.h"
 #include "ags/engine/platform/base/ags_platform_driver.h"
 #include "ags/ags.h"
 #include "ags/globals.h"
@@ -31,6 +32,7 @@ namespace AGS3 {
 
 namespace {
 const auto MAXIMUM_FALL_BEHIND = 3; // number of full frames
+const uint32 PRELOAD_TIME_MARGIN = 2; // ms of the frame time not given to the sprite preloading
 }
 
 std::chrono::microseconds GetFrameDuration() {
@@ -81,6 +83,12 @@ void WaitForNextFrame() {
 
 	if (_G(next_frame_timestamp) > now) {
 		auto frame_time_remaining = _G(next_frame_timestamp) - now;
+		// Use the spare frame time for loading sprites which are about to be shown
+		if (frame_time_remaining > PRELOAD_TIME_MARGIN && _GP(spriteset).GetPreloadQueueSize() > 0) {
+			_GP(spriteset).ProcessPreloadQueue(frame_time_remaining - PRELOAD_TIME_MARGIN);
+			const auto after_preload = AGS_Clock::now();
+			frame_time_remaining = _G(next_frame_timestamp) > after_preload ? _G(next_frame_timestamp) - after_preload : 0;
+		}
 		std::this_thread::sleep_for(frame_time_remaining);
 	}
 
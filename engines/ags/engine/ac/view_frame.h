@@ -51,6 +51,8 @@ int  ViewFrame_GetLoop(ScriptViewFrame *svf);
 int  ViewFrame_GetFrame(ScriptViewFrame *svf);
 
 void precache_view(int view);
+// Queues all the frames of the view for loading ahead of their use
+void preload_view(int view);
 // Handle the new animation frame (play linked sounds, etc);
  // sound_volume is an optional relative factor, -1 means not use
  void CheckViewFrame(int view, int loop, int frame, int sound_volume = -1);
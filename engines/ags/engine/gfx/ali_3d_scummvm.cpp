@@ -40,6 +40,11 @@ using namespace Shared;
 
 static RGB faded_out_palette[256];
 
+// Maximal number of separate dirty regions, above that whole screen is presented
+static const size_t kMaxDirtyRects = 32;
+// Maximal number of dirty regions of a batch surface, above that it is redrawn fully
+static const size_t kMaxBatchDirtyRects = 16;
+
 
 // ----------------------------------------------------------------------------
 // ScummVMRendererGraphicsDriver
@@ -155,7 +160,7 @@ void ScummVMRendererGraphicsDriver::CreateVirtualScreen() {
 	_origVirtualScreen.reset(new Bitmap(vscreen_w, vscreen_h, _srcColorDepth));
 	virtualScreen = _origVirtualScreen.get();
 	_stageVirtualScreen = virtualScreen;
-
+	_fullDirty = true;
 
 	_lastTexPixels = nullptr;
 	_lastTexPitch = -1;
@@ -173,6 +178,7 @@ void ScummVMRendererGraphicsDriver::DestroyVirtualScreen() {
 void ScummVMRendererGraphicsDriver::ReleaseDisplayMode() {
 	OnModeReleased();
 	ClearDrawLists();
+	_fullDirty = true;
 }
 
 bool ScummVMRendererGraphicsDriver::SetNativeResolution(const GraphicResolution &native_res) {
@@ -246,21 +252,29 @@ int ScummVMRendererGraphicsDriver::GetCompatibleBitmapFormat(int color_depth) {
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateDDB(int width, int height, int color_depth, bool opaque) {
-	return new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ALSoftwareBitmap *ddb = new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ddb->_generation = ++_ddbGeneration;
+	return ddb;
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateDDBFromBitmap(Bitmap *bitmap, bool hasAlpha, bool opaque) {
-	return new ALSoftwareBitmap(bitmap, opaque, hasAlpha);
+	ALSoftwareBitmap *ddb = new ALSoftwareBitmap(bitmap, opaque, hasAlpha);
+	ddb->_generation = ++_ddbGeneration;
+	return ddb;
 }
 
 IDriverDependantBitmap *ScummVMRendererGraphicsDriver::CreateRenderTargetDDB(int width, int height, int color_depth, bool opaque) {
-	return new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ALSoftwareBitmap *ddb = new ALSoftwareBitmap(width, height, color_depth, opaque);
+	ddb->_generation = ++_ddbGeneration;
+	return ddb;
 }
 
 void ScummVMRendererGraphicsDriver::UpdateDDBFromBitmap(IDriverDependantBitmap *bitmapToUpdate, Bitmap *bitmap, bool hasAlpha) {
 	ALSoftwareBitmap *alSwBmp = (ALSoftwareBitmap *)bitmapToUpdate;
 	alSwBmp->_bmp = bitmap;
 	alSwBmp->_hasAlpha = hasAlpha;
+	// The bitmap is shared with the engine, so this is the only way to know that its contents changed
+	alSwBmp->_generation = ++_ddbGeneration;
 }
 
 void ScummVMRendererGraphicsDriver::DestroyDDB(IDriverDependantBitmap *bitmap) {
@@ -295,16 +309,21 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 
 	// Initialize batch surface, depending on the batch description.
 	// Surface was prepared externally (common for room cameras)
+	const bool was_external = batch.IsExternalSurface;
+	batch.IsExternalSurface = false;
 	if (desc.Surface != nullptr) {
 		batch.Surface = desc.Surface;
 		batch.Opaque = true;
 		batch.IsParentRegion = false;
+		batch.IsExternalSurface = true;
+		batch.IsNewSurface = true;
 	}
 	// In case something was not initialized
 	else if (desc.Viewport.IsEmpty() || !virtualScreen) {
 		batch.Surface.reset();
 		batch.Opaque = false;
 		batch.IsParentRegion = false;
+		batch.IsNewSurface = true;
 	}
 	// Drawing directly on a viewport without transformation (other than offset):
 	// then make a subbitmap of the parent surface (virtualScreen or else).
@@ -316,6 +335,7 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 			(batch.Surface->GetSize() != Size(src_w, src_h)) ||
 			(batch.Surface->GetSubOffset() != viewport.GetLT())) {
 			batch.Surface.reset(BitmapHelper::CreateSubBitmap(parent_surf, viewport));
+			batch.IsNewSurface = true;
 		}
 		batch.Opaque = true;
 		batch.IsParentRegion = true;
@@ -328,6 +348,10 @@ void ScummVMRendererGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBa
 	else {
 		if (!batch.Surface || batch.IsParentRegion || (batch.Surface->GetSize() != Size(src_w, src_h))) {
 			batch.Surface.reset(new Bitmap(src_w, src_h, _srcColorDepth));
+			batch.IsNewSurface = true;
+		} else if (was_external) {
+			// Reusing the engine's surface, its contents are unknown
+			batch.IsNewSurface = true;
 		}
 		batch.Opaque = false;
 		batch.IsParentRegion = false;
@@ -379,6 +403,8 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 		return; // no batches - no render
 	}
 
+	UpdateDirtyRects();
+
 	// Render all the sprite batches with necessary transformations
 	//
 	// NOTE: that's not immediately clear whether it would be faster to first draw upon a camera-sized
@@ -396,8 +422,8 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 		// Test if we are entering this batch (and not continuing after coming back from nested)
 		if (cur_spr <= _spriteBatchRange[cur_bat].first) {
 			const auto &batch = _spriteBatches[cur_bat];
-			// Prepare the transparent surface
-			if (batch.Surface && !batch.Opaque)
+			// Prepare the transparent surface; partially redrawn surfaces are cleared region by region
+			if (batch.Surface && !batch.Opaque && batch.FullRedraw)
 				batch.Surface->ClearTransparent();
 		}
 
@@ -414,7 +440,10 @@ void ScummVMRendererGraphicsDriver::RenderToBackBuffer() {
 			parent_surf->SetClip(viewport); // CHECKME: this is not exactly correct?
 			if (surface && !batch.IsParentRegion) {
 				_stageVirtualScreen = surface;
-				cur_spr = RenderSpriteBatch(batch, cur_spr, surface, transform.X, transform.Y);
+				if (batch.FullRedraw)
+					cur_spr = RenderSpriteBatch(batch, cur_spr, surface, transform.X, transform.Y);
+				else
+					cur_spr = RenderSpriteBatchRegions(batch, cur_spr, surface, transform.X, transform.Y);
 			} else {
 				_stageVirtualScreen = surface ? surface : parent_surf;
 				cur_spr = RenderSpriteBatch(batch, cur_spr, _stageVirtualScreen, transform.X, transform.Y);
@@ -501,15 +530,182 @@ size_t ScummVMRendererGraphicsDriver::RenderSpriteBatch(const ALSpriteBatch &bat
 	return from;
 }
 
-void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode) {
+size_t ScummVMRendererGraphicsDriver::RenderSpriteBatchRegions(const ALSpriteBatch &batch, size_t from, Bitmap *surface, int surf_offx, int surf_offy) {
+	size_t to = from;
+	while ((to < _spriteList.size()) && (_spriteList[to].node == batch.ID))
+		++to;
+
+	// Each region is cleared before drawing, so it's fine if they overlap
+	for (const Rect &rc : batch.DirtyRects) {
+		surface->SetClip(rc);
+		surface->FillRect(rc, surface->GetMaskColor());
+		RenderSpriteBatch(batch, from, surface, surf_offx, surf_offy);
+	}
+	surface->ResetClip();
+	return to;
+}
+
+void ScummVMRendererGraphicsDriver::AddDirtyRect(const Rect &rc) {
+	if (_fullDirty || rc.IsEmpty())
+		return;
+
+	// Merge with the intersecting regions, so that no pixel is presented twice
+	Rect merged = rc;
+	for (size_t i = 0; i < _dirtyRects.size();) {
+		if (AreRectsIntersecting(_dirtyRects[i], merged)) {
+			merged = SumRects(merged, _dirtyRects[i]);
+			_dirtyRects.erase(_dirtyRects.begin() + i);
+			i = 0; // the larger region may now intersect the ones already tested
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyRects.size() >= kMaxDirtyRects) {
+		_dirtyRects.clear();
+		_fullDirty = true;
+		return;
+	}
+	_dirtyRects.push_back(merged);
+}
+
+Rect ScummVMRendererGraphicsDriver::BatchToScreen(uint32_t index, const Rect &rc) const {
+	Rect res = rc;
+	while (index != UINT32_MAX) {
+		const ALSpriteBatch &batch = _spriteBatches[index];
+		const Rect &viewport = batch.Viewport;
+		if (batch.Surface && !batch.IsParentRegion) {
+			// The batch's own surface is stretched over the viewport
+			const int surf_w = batch.Surface->GetWidth();
+			const int surf_h = batch.Surface->GetHeight();
+			if (surf_w <= 0 || surf_h <= 0)
+				return Rect();
+			const int view_w = viewport.GetWidth();
+			const int view_h = viewport.GetHeight();
+			res = Rect(viewport.Left + res.Left * view_w / surf_w,
+				viewport.Top + res.Top * view_h / surf_h,
+				viewport.Left + ((res.Right + 1) * view_w + surf_w - 1) / surf_w - 1,
+				viewport.Top + ((res.Bottom + 1) * view_h + surf_h - 1) / surf_h - 1);
+		} else if (batch.Surface) {
+			// The batch's surface is a subregion of the parent's one
+			res = Rect::MoveBy(res, viewport.Left, viewport.Top);
+		}
+		res = IntersectRects(res, viewport);
+
+		// Parent batches without a surface draw right on the virtual screen
+		const uint32_t parent = _spriteBatchDesc[index].Parent;
+		if ((parent == UINT32_MAX) || !_spriteBatches[parent].Surface)
+			break;
+		index = parent;
+	}
+	return res;
+}
+
+void ScummVMRendererGraphicsDriver::UpdateDirtyRects() {
+	const size_t batch_count = _spriteBatchDesc.size();
+
+	// Batches which don't exist anymore leave their last viewport to redraw
+	for (size_t i = batch_count; i < _spriteBatches.size(); ++i) {
+		ALSpriteBatch &batch = _spriteBatches[i];
+		if (batch.HasLastFrame)
+			AddDirtyRect(batch.LastScreenRect);
+		batch.HasLastFrame = false;
+		batch.LastSprites.clear();
+	}
+
+	// Record how each batch's sprites look on this frame
+	std::vector<bool> untracked(batch_count, false), has_children(batch_count, false);
+	for (size_t i = 0; i < batch_count; ++i) {
+		_spriteBatches[i].Sprites.clear();
+		if (_spriteBatchDesc[i].Parent != UINT32_MAX)
+			has_children[_spriteBatchDesc[i].Parent] = true;
+	}
+	for (const auto &sprite : _spriteList) {
+		ALSpriteBatch &batch = _spriteBatches[sprite.node];
+		if (sprite.ddb == nullptr) {
+			// Plugin callbacks may draw anything anywhere
+			untracked[sprite.node] = true;
+			_fullDirty = true;
+			continue;
+		} else if (sprite.ddb == reinterpret_cast<ALSoftwareBitmap *>(DRAWENTRY_TINT)) {
+			// Tint changes the whole surface
+			untracked[sprite.node] = true;
+			continue;
+		}
+
+		const ALSoftwareBitmap *bitmap = sprite.ddb;
+		ALSpriteState state;
+		state.Ddb = bitmap;
+		state.Generation = bitmap->_generation;
+		state.Bounds = RectWH(sprite.x + batch.Transform.X, sprite.y + batch.Transform.Y,
+			bitmap->_bmp ? bitmap->_bmp->GetWidth() : bitmap->GetWidth(),
+			bitmap->_bmp ? bitmap->_bmp->GetHeight() : bitmap->GetHeight());
+		state.Alpha = bitmap->_alpha;
+		batch.Sprites.push_back(state);
+	}
+
+	// Compare with the last frame
+	for (size_t i = 0; i < batch_count; ++i) {
+		ALSpriteBatch &batch = _spriteBatches[i];
+		const SpriteBatchDesc &desc = _spriteBatchDesc[i];
+		const Rect screen_rect = BatchToScreen(i, batch.Surface ? RectWH(batch.Surface->GetSize()) : batch.Viewport);
+
+		// Surfaces drawn upon by the engine or the plugins are not tracked,
+		// and any change of the batch parameters moves all of its sprites
+		const bool same_setup = batch.HasLastFrame && !batch.IsNewSurface && !batch.IsExternalSurface &&
+			!untracked[i] && !batch.LastUntracked && (batch.LastParent == desc.Parent) &&
+			(batch.LastViewport == batch.Viewport) &&
+			(batch.LastTransform.X == batch.Transform.X) && (batch.LastTransform.Y == batch.Transform.Y) &&
+			(batch.LastTransform.ScaleX == batch.Transform.ScaleX) && (batch.LastTransform.ScaleY == batch.Transform.ScaleY);
+
+		batch.DirtyRects.clear();
+		batch.FullRedraw = true;
+		if (same_setup) {
+			// Sprites are compared in the drawing order, so a change of the order is caught too
+			const size_t count = MAX(batch.Sprites.size(), batch.LastSprites.size());
+			for (size_t s = 0; s < count; ++s) {
+				const bool has_last = s < batch.LastSprites.size();
+				const bool has_cur = s < batch.Sprites.size();
+				if (has_last && has_cur && (batch.LastSprites[s] == batch.Sprites[s]))
+					continue;
+				if (has_last)
+					batch.DirtyRects.push_back(batch.LastSprites[s].Bounds);
+				if (has_cur)
+					batch.DirtyRects.push_back(batch.Sprites[s].Bounds);
+			}
+			for (const Rect &rc : batch.DirtyRects)
+				AddDirtyRect(BatchToScreen(i, rc));
+
+			// Only the batch's own surface may be redrawn partially: the other surfaces
+			// are shared with the parent batch or the engine, which redraw under the sprites
+			batch.FullRedraw = !batch.Surface || batch.IsParentRegion || has_children[i] ||
+				(batch.DirtyRects.size() > kMaxBatchDirtyRects);
+		} else {
+			if (batch.HasLastFrame)
+				AddDirtyRect(batch.LastScreenRect);
+			AddDirtyRect(screen_rect);
+		}
+
+		batch.HasLastFrame = true;
+		batch.IsNewSurface = false;
+		batch.LastUntracked = untracked[i];
+		batch.LastParent = desc.Parent;
+		batch.LastViewport = batch.Viewport;
+		batch.LastTransform = batch.Transform;
+		batch.LastScreenRect = screen_rect;
+		batch.LastSprites.swap(batch.Sprites);
+	}
+}
+
+void ScummVMRendererGraphicsDriver::copySurface(const Graphics::Surface &src, bool mode, const Common::Rect &area) {
 	assert(src.w == _screen->w && src.h == _screen->h && src.pitch == _screen->pitch);
-	const uint32 *srcP = (const uint32 *)src.getPixels();
-	uint32 *destP = (uint32 *)_screen->getPixels();
 	uint32 pixel;
 	int x1 = 9999, y1 = 9999, x2 = -1, y2 = -1;
 
-	for (int y = 0; y < src.h; ++y) {
-		for (int x = 0; x < src.w; ++x, ++srcP, ++destP) {
+	for (int y = area.top; y < area.bottom; ++y) {
+		const uint32 *srcP = (const uint32 *)src.getBasePtr(area.left, y);
+		uint32 *destP = (uint32 *)_screen->getBasePtr(area.left, y);
+		for (int x = area.left; x < area.right; ++x, ++srcP, ++destP) {
 			if (!mode) {
 				pixel = (*srcP & 0xff00ff00) |
 					((*srcP & 0xff) << 16) |
@@ -583,18 +779,52 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		renderMode = kRenderOther;
 	}
 
-	if (renderMode != kRenderDirect && !_screen)
+	if (renderMode != kRenderDirect && !_screen) {
 		_screen = new Graphics::Screen();
+		_fullDirty = true;
+	}
+
+	// Only the regions changed since the last frame are presented. Shifted or
+	// flipped frames, palette changes and custom backbuffers are not tracked.
+	if (srcTransformed || (_srcColorDepth == 8) || (virtualScreen != _origVirtualScreen.get()) ||
+			(renderMode != _lastRenderMode))
+		_fullDirty = true;
+	_lastRenderMode = renderMode;
+
+	Common::Array<Common::Rect> areas;
+	if (_fullDirty) {
+		areas.push_back(Common::Rect(src.w, src.h));
+	} else {
+		for (const Rect &rc : _dirtyRects) {
+			Common::Rect area(rc.Left, rc.Top, rc.Right + 1, rc.Bottom + 1);
+			area.clip(Common::Rect(src.w, src.h));
+			if (!area.isEmpty())
+				areas.push_back(area);
+		}
+	}
+
+	// The debug overlay outlines the presented regions, and the outlines
+	// of the last frame are erased by presenting their regions again
+	const size_t dirtyCount = areas.size();
+	for (const Common::Rect &area : _overlayRects)
+		areas.push_back(area);
+	_overlayRects.clear();
+	if (_G(debugDirtyRects)) {
+		for (size_t i = 0; i < dirtyCount; ++i)
+			_overlayRects.push_back(areas[i]);
+	}
 
 	switch (renderMode) {
 	case kRenderToABGR:
 		// ARGB to ABGR
-		copySurface(src, false);
+		for (const Common::Rect &area : areas)
+			copySurface(src, false, area);
 		break;
 
 	case kRenderToRGBA:
 		// ARGB to RGBA
-		copySurface(src, true);
+		for (const Common::Rect &area : areas)
+			copySurface(src, true, area);
 		break;
 
 	case kRenderOther: {
@@ -603,32 +833,48 @@ void ScummVMRendererGraphicsDriver::Present(int xoff, int yoff, Shared::GraphicF
 		Graphics::Surface srcCopy = src;
 		srcCopy.format.aLoss = 8;
 
-		_screen->blitFrom(srcCopy);
+		for (const Common::Rect &area : areas)
+			_screen->blitFrom(srcCopy, area, Common::Point(area.left, area.top));
 		break;
 	}
 
 	case kRenderDirect:
 		// Blit the virtual surface directly to the screen
-		g_system->copyRectToScreen(src.getPixels(), src.pitch,
-			0, 0, src.w, src.h);
-		g_system->updateScreen();
-		if (srcTransformed) {
-			srcTransformed->free();
-			delete srcTransformed;
+		for (const Common::Rect &area : areas) {
+			g_system->copyRectToScreen(src.getBasePtr(area.left, area.top), src.pitch,
+				area.left, area.top, area.width(), area.height());
 		}
-		return;
+		if (!_overlayRects.empty() && screenFormat.bytesPerPixel > 1) {
+			Graphics::Surface *screen = g_system->lockScreen();
+			const uint32 color = screenFormat.RGBToColor(255, 0, 255);
+			for (const Common::Rect &area : _overlayRects)
+				screen->frameRect(area, color);
+			g_system->unlockScreen();
+		}
+		g_system->updateScreen();
+		break;
 
 	default:
 		break;
 	}
 
+	if (renderMode != kRenderDirect && _screen) {
+		if (!_overlayRects.empty()) {
+			const uint32 color = _screen->format.RGBToColor(255, 0, 255);
+			for (const Common::Rect &area : _overlayRects)
+				_screen->frameRect(area, color);
+		}
+		_screen->update();
+	}
+
 	if (srcTransformed) {
 		srcTransformed->free();
 		delete srcTransformed;
 	}
 
-	if (_screen)
-		_screen->update();
+	// Leaving a shifted or flipped frame requires presenting whole screen again
+	_fullDirty = srcTransformed != nullptr;
+	_dirtyRects.clear();
 }
 
 void ScummVMRendererGraphicsDriver::Render(int xoff, int yoff, GraphicFlip flip) {
@@ -641,6 +887,8 @@ void ScummVMRendererGraphicsDriver::Render() {
 }
 
 Bitmap *ScummVMRendererGraphicsDriver::GetMemoryBackBuffer() {
+	// The caller may draw anything on the virtual screen
+	_fullDirty = true;
 	return virtualScreen;
 }
 
@@ -653,6 +901,7 @@ void ScummVMRendererGraphicsDriver::SetMemoryBackBuffer(Bitmap *backBuffer) {
 		virtualScreen = _origVirtualScreen.get();
 	}
 	_stageVirtualScreen = virtualScreen;
+	_fullDirty = true;
 
 	// Reset old virtual screen's subbitmaps;
 	// NOTE: this MUST NOT be called in the midst of the RenderSpriteBatches!
@@ -665,7 +914,9 @@ void ScummVMRendererGraphicsDriver::SetMemoryBackBuffer(Bitmap *backBuffer) {
 	}
 }
 
-Bitmap *ScummVMRendererGraphicsDriver::GetStageBackBuffer(bool /*mark_dirty*/) {
+Bitmap *ScummVMRendererGraphicsDriver::GetStageBackBuffer(bool mark_dirty) {
+	if (mark_dirty)
+		_fullDirty = true;
 	return _stageVirtualScreen;
 }
 
@@ -677,6 +928,11 @@ void ScummVMRendererGraphicsDriver::SetStageBackBuffer(Bitmap *backBuffer) {
 		_stageVirtualScreen = backBuffer;
 	else
 		_stageVirtualScreen = cur_stage;
+	_fullDirty = true;
+}
+
+void ScummVMRendererGraphicsDriver::MarkBackBufferDirty(const Rect &rc) {
+	AddDirtyRect(rc);
 }
 
 bool ScummVMRendererGraphicsDriver::GetCopyOfScreenIntoBitmap(Bitmap *destination, bool at_native_res, GraphicResolution *want_fmt) {
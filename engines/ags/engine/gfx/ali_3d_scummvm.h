@@ -34,6 +34,8 @@
 #ifndef AGS_ENGINE_GFX_ALI_3D_SCUMMVM_H
 #define AGS_ENGINE_GFX_ALI_3D_SCUMMVM_H
 
+#include "common/array.h"
+#include "common/rect.h"
 #include "common/std/memory.h"
 #include "common/std/vector.h"
 #include "ags/shared/core/platform.h"
@@ -81,6 +83,9 @@ public:
 	bool _flipped = false;
 	int _stretchToWidth = 0, _stretchToHeight = 0;
 	int _alpha = 255;
+	// Changes whenever the bitmap is created or updated, which tells the renderer
+	// whether the sprite still looks the same as on the previous frame
+	uint32_t _generation = 0;
 
 	ALSoftwareBitmap(int width, int height, int color_depth, bool opaque) {
 		_width = width;
@@ -137,6 +142,24 @@ private:
 
 
 typedef SpriteDrawListEntry<ALSoftwareBitmap> ALDrawListEntry;
+
+// Sprite as drawn by a batch on a particular frame
+struct ALSpriteState {
+	const ALSoftwareBitmap *Ddb = nullptr;
+	uint32_t Generation = 0;
+	// Sprite's position on the batch surface
+	Rect Bounds;
+	int Alpha = 0;
+
+	bool operator ==(const ALSpriteState &other) const {
+		return Ddb == other.Ddb && Generation == other.Generation &&
+			Bounds == other.Bounds && Alpha == other.Alpha;
+	}
+	bool operator !=(const ALSpriteState &other) const {
+		return !(*this == other);
+	}
+};
+
 // Software renderer's sprite batch
 struct ALSpriteBatch {
 	uint32_t ID = 0u;
@@ -151,6 +174,27 @@ struct ALSpriteBatch {
 	bool IsParentRegion = false;
 	// Tells whether the surface is treated as opaque or transparent
 	bool Opaque = false;
+	// Whether the surface was prepared externally, and is drawn upon by the engine
+	bool IsExternalSurface = false;
+	// Whether the surface was (re)created since the last frame
+	bool IsNewSurface = true;
+
+	// Dirty regions tracking: the batch parameters and the sprites of the last
+	// frame are compared with the current ones to find the changed regions.
+	bool HasLastFrame = false;
+	// Whether the batch had entries which cannot be tracked (plugin callbacks or tint)
+	bool LastUntracked = false;
+	uint32_t LastParent = UINT32_MAX;
+	Rect LastViewport;
+	SpriteTransform LastTransform;
+	// Viewport on the virtual screen, in the virtual screen coordinates
+	Rect LastScreenRect;
+	std::vector<ALSpriteState> LastSprites;
+	std::vector<ALSpriteState> Sprites;
+	// Regions of the batch's own surface which have to be redrawn on this frame;
+	// only used when FullRedraw is not set
+	std::vector<Rect> DirtyRects;
+	bool FullRedraw = true;
 };
 typedef std::vector<ALSpriteBatch> ALSpriteBatches;
 
@@ -229,6 +273,7 @@ public:
 	void SetMemoryBackBuffer(Bitmap *backBuffer) override;
 	Bitmap *GetStageBackBuffer(bool mark_dirty) override;
 	void SetStageBackBuffer(Bitmap *backBuffer) override;
+	void MarkBackBufferDirty(const Rect &rc) override;
 	bool GetStageMatrixes(RenderMatrixes & /*rm*/) override {
 		return false; /* not supported */
 	}
@@ -279,6 +324,17 @@ private:
 	// List of sprites to render
 	std::vector<ALDrawListEntry> _spriteList;
 
+	// Regions of the virtual screen changed since it was last presented,
+	// in virtual screen coordinates
+	std::vector<Rect> _dirtyRects;
+	bool _fullDirty = true;
+	// Regions outlined by the debug overlay on the last frame
+	Common::Array<Common::Rect> _overlayRects;
+	// Way the last frame was presented
+	int _lastRenderMode = -1;
+	// Source of the DDB generations
+	uint32_t _ddbGeneration = 0;
+
 	void InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) override;
 	void ResetAllBatches() override;
 
@@ -289,13 +345,23 @@ private:
 	void ReleaseDisplayMode();
 	// Renders single sprite batch on the precreated surface
 	size_t RenderSpriteBatch(const ALSpriteBatch &batch, size_t from, Shared::Bitmap *surface, int surf_offx, int surf_offy);
+	// Renders only the dirty regions of the sprite batch on its own surface
+	size_t RenderSpriteBatchRegions(const ALSpriteBatch &batch, size_t from, Shared::Bitmap *surface, int surf_offx, int surf_offy);
+
+	// Adds a region of the virtual screen to present on the next frame
+	void AddDirtyRect(const Rect &rc);
+	// Compares the sprite batches with the last frame, and finds which regions
+	// of their surfaces and of the virtual screen have to be redrawn
+	void UpdateDirtyRects();
+	// Converts a region of the batch surface to the virtual screen coordinates
+	Rect BatchToScreen(uint32_t index, const Rect &rc) const;
 
 	void highcolor_fade_in(Bitmap *vs, void(*draw_callback)(), int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void highcolor_fade_out(Bitmap *vs, void(*draw_callback)(), int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	void __fade_from_range(PALETTE source, PALETTE dest, int speed, int from, int to);
 	void __fade_out_range(int speed, int from, int to, int targetColourRed, int targetColourGreen, int targetColourBlue);
 	// Copy raw screen bitmap pixels to the screen
-	void copySurface(const Graphics::Surface &src, bool mode);
+	void copySurface(const Graphics::Surface &src, bool mode, const Common::Rect &area);
 	// Render bitmap on screen
 	void Present(int xoff = 0, int yoff = 0, Shared::GraphicFlip flip = Shared::kFlip_None);
 };
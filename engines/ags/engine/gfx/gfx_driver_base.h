@@ -244,6 +244,9 @@ public:
 	void SetMemoryBackBuffer(Bitmap *backBuffer) override;
 	Bitmap *GetStageBackBuffer(bool mark_dirty) override;
 	void SetStageBackBuffer(Bitmap *backBuffer) override;
+	void MarkBackBufferDirty(const Rect & /*rc*/) override {
+		/* do nothing, video-memory drivers redraw whole screen every frame */
+	}
 	bool GetStageMatrixes(RenderMatrixes &rm) override;
 	// Creates new texture using given parameters
 	IDriverDependantBitmap *CreateDDB(int width, int height, int color_depth, bool opaque) override = 0;
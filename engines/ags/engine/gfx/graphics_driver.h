@@ -228,6 +228,9 @@ public:
 	// Passing NULL pointer will tell renderer to switch back to its original stage buffer.
 	// Note that only software renderer supports this.
 	virtual void SetStageBackBuffer(Shared::Bitmap *backBuffer) = 0;
+	// Tells that the given region of the memory backbuffer was drawn upon outside of the sprite batches.
+	// Renderers which present only the changed parts of the screen rely on this.
+	virtual void MarkBackBufferDirty(const Rect &rc) = 0;
 	// Retrieves 3 transform matrixes for the current rendering stage: world (model), view and projection.
 	// These matrixes will be filled in accordance to the renderer's compatible format;
 	// returns false if renderer does not use matrixes (not a 3D renderer).
@@ -23,6 +23,7 @@
 // Game loop
 //
 
+#include "common/profiler.h"
 #include "common/std/limits.h"
 #include "ags/engine/ac/button.h"
 #include "ags/shared/ac/common.h"
@@ -775,6 +776,7 @@ void set_loop_counter(unsigned int new_counter) {
 }
 
 void UpdateGameOnce(bool checkControls, IDriverDependantBitmap *extraBitmap, int extraX, int extraY) {
+	PROFILE_ZONE("AGS::UpdateGameOnce");
 
 	int res;
 
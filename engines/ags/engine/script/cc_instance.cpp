@@ -449,7 +449,9 @@ int ccInstance::Run(int32_t curpc) {
 	ccInstance *codeInst = runningInst;
 	bool write_debug_dump = ccGetOption(SCOPT_DEBUGRUN) ||
 		(gDebugLevel > 0 && DebugMan.isDebugChannelEnabled(::AGS::kDebugScript));
-	ScriptOperation codeOp;
+	// Keep a reference, in case the code gets decoded again by a nested call
+	std::shared_ptr<ScriptDecodedCode> decoded = codeInst->GetDecodedCode();
+	RuntimeScriptValue stackArgs[MAX_SCMD_ARGS];
 	FunctionCallStack func_callstack;
 	int loopIterationCheckDisabled = 0;
 	unsigned loopIterations = 0u;      // any loop iterations (needed for timeout test)
@@ -464,88 +466,33 @@ int ccInstance::Run(int32_t curpc) {
 		if (_G(abort_engine))
 			return -1;
 
-		/*
-		if (!codeInst->ReadOperation(codeOp, pc))
-		{
-		    return -1;
-		}
-		*/
-		/* ReadOperation */
-		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
-			return -1;
-		}
-
-		codeOp.ArgCount = (*g_commands)[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
+		// Instructions are decoded ahead of time, see DecodeOperation()
+		if ((pc < 0) || (pc >= codeInst->codesize) || (decoded->OpIndex[pc] < 0)) {
+			if (!codeInst->DecodeOperation(*decoded, pc))
+				return -1;
 		}
-
-		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
-					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
-					break;
-				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(codeInst->code[pc_at]));
-					if (import) {
-						codeOp.Args[i] = import->Value;
-					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
-						return -1;
-					}
-				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
-					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
+		const ScriptDecodedOp &codeOp = decoded->Ops[decoded->OpIndex[pc]];
+		const int32_t argCount = codeOp.ArgCount;
+
+		const RuntimeScriptValue *args[MAX_SCMD_ARGS] = {
+			&decoded->Values[codeOp.Args[0]], &decoded->Values[codeOp.Args[1]], &decoded->Values[codeOp.Args[2]]
+		};
+		if (codeOp.HasRuntimeArgs) {
+			for (int i = 0; i < argCount; ++i) {
+				if (codeOp.ArgType[i] == kScDecodedArgStack) {
+					stackArgs[i] = GetStackPtrOffsetFw(args[i]->IValue);
+					args[i] = &stackArgs[i];
+				} else if (codeOp.ArgType[i] == kScDecodedArgBadImport) {
+					cc_error("cannot resolve import, key = %d", args[i]->IValue);
 					return -1;
 				}
-				/* End FixupArgument */
-				//=====================================================================
-			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 			}
 		}
-		/* End ReadOperation */
-		//=====================================================================
 
 		// save the arguments for quick access
-		RuntimeScriptValue &arg1 = codeOp.Args[0];
-		RuntimeScriptValue &arg2 = codeOp.Args[1];
-		RuntimeScriptValue &arg3 = codeOp.Args[2];
+		const RuntimeScriptValue &arg1 = *args[0];
+		const RuntimeScriptValue &arg2 = *args[1];
+		const RuntimeScriptValue &arg3 = *args[2];
 		RuntimeScriptValue &reg1 =
 		    registers[arg1.IValue >= 0 && arg1.IValue < CC_NUM_REGISTERS ? arg1.IValue : 0];
 		RuntimeScriptValue &reg2 =
@@ -555,10 +502,16 @@ int ccInstance::Run(int32_t curpc) {
 		const char *direct_ptr2;
 
 		if (write_debug_dump) {
-			DumpInstruction(codeOp);
+			ScriptOperation dumpOp;
+			dumpOp.Instruction.Code = codeOp.Code;
+			dumpOp.Instruction.InstanceId = codeOp.InstanceId;
+			dumpOp.ArgCount = argCount;
+			for (int i = 0; i < argCount; ++i)
+				dumpOp.Args[i] = *args[i];
+			DumpInstruction(dumpOp);
 		}
 
-		switch (codeOp.Instruction.Code) {
+		switch (codeOp.Code) {
 		case SCMD_LINENUM:
 			line_number = arg1.IValue;
 			_G(currentline) = arg1.IValue;
@@ -736,7 +689,7 @@ int ccInstance::Run(int32_t curpc) {
 			PUSH_CALL_STACK;
 
 			ASSERT_STACK_SPACE_AVAILABLE(1);
-			PushValueToStack(RuntimeScriptValue().SetInt32(pc + codeOp.ArgCount + 1));
+			PushValueToStack(RuntimeScriptValue().SetInt32(pc + argCount + 1));
 
 			if (thisbase[curnest] == 0)
 				pc = reg1.IValue;
@@ -979,7 +932,7 @@ int ccInstance::Run(int32_t curpc) {
 			ccInstance *wasRunning = runningInst;
 
 			// extract the instance ID
-			int32_t instId = codeOp.Instruction.InstanceId;
+			int32_t instId = codeOp.InstanceId;
 			// determine the offset into the code of the instance we want
 			runningInst = _G(loadedInstances)[instId];
 			intptr_t callAddr = reg1.Ptr - (char *)&runningInst->code[0];
@@ -1002,6 +955,7 @@ int ccInstance::Run(int32_t curpc) {
 			}
 
 			next_call_needs_object = 0;
+			decoded = codeInst->GetDecodedCode();
 
 			pc = oldpc;
 			was_just_callas = func_callstack.Count;
@@ -1073,6 +1027,8 @@ int ccInstance::Run(int32_t curpc) {
 			registers[SREG_AX] = return_value;
 			next_call_needs_object = 0;
 			num_args_to_func = -1;
+			// The called function may have changed the imports
+			decoded = codeInst->GetDecodedCode();
 			break;
 		}
 		case SCMD_PUSHREAL:
@@ -1238,11 +1194,11 @@ int ccInstance::Run(int32_t curpc) {
 				loopIterationCheckDisabled++;
 			break;
 		default:
-			cc_error("instruction %d is not implemented", codeOp.Instruction.Code);
+			cc_error("instruction %d is not implemented", codeOp.Code);
 			return -1;
 		}
 
-		pc += codeOp.ArgCount + 1;
+		pc += argCount + 1;
 	}
 	return 0;
 }
@@ -1516,6 +1472,7 @@ void ccInstance::Free() {
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	_decodedCode.reset();
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1726,9 +1683,129 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+	// The code has changed
+	_decodedCode.reset();
 	return true;
 }
 
+std::shared_ptr<ScriptDecodedCode> ccInstance::GetDecodedCode() {
+	if (_decodedCode && _decodedCode->ImportsGeneration == _GP(simp).getGeneration())
+		return _decodedCode;
+
+	// Decode every instruction, in sequence. Anything which cannot be
+	// decoded is left for Run() to report, if it is ever reached.
+	_decodedCode.reset(new ScriptDecodedCode());
+	_decodedCode->ImportsGeneration = _GP(simp).getGeneration();
+	_decodedCode->OpIndex.resize(codesize, -1);
+	// The arguments an instruction does not have point to this value
+	_decodedCode->Values.push_back(RuntimeScriptValue());
+
+	for (int32_t at_pc = 0; at_pc < codesize; at_pc += _decodedCode->Ops.back().ArgCount + 1) {
+		const int32_t op = code[at_pc] & INSTANCE_ID_REMOVEMASK;
+		if (op < 0 || op >= CC_NUM_SCCMDS || at_pc + (*g_commands)[op].ArgCount >= codesize)
+			break;
+		if (!DecodeOperation(*_decodedCode, at_pc))
+			break;
+	}
+
+	return _decodedCode;
+}
+
+bool ccInstance::DecodeOperation(ScriptDecodedCode &decoded, int32_t at_pc) {
+	if (at_pc < 0 || at_pc >= codesize) {
+		cc_error("invalid code position %d (code size %d)", at_pc, codesize);
+		return false;
+	}
+
+	ScriptDecodedOp op;
+	op.Code       = code[at_pc];
+	op.InstanceId = (op.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+	op.Code      &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
+
+	if (op.Code < 0 || op.Code >= CC_NUM_SCCMDS) {
+		cc_error("invalid instruction %d found in code stream", op.Code);
+		return false;
+	}
+
+	op.ArgCount = (*g_commands)[op.Code].ArgCount;
+	if (at_pc + op.ArgCount >= codesize) {
+		cc_error("unexpected end of code data (%d; %d)", at_pc + op.ArgCount, codesize);
+		return false;
+	}
+
+	op.HasRuntimeArgs = false;
+	for (int i = 0; i < MAX_SCMD_ARGS; ++i) {
+		op.ArgType[i] = kScDecodedArgValue;
+		op.Args[i] = 0;
+	}
+
+	int32_t pc_at = at_pc + 1;
+	for (int i = 0; i < op.ArgCount; ++i, ++pc_at) {
+		const intptr_t value = code[pc_at];
+		RuntimeScriptValue arg;
+
+		switch (code_fixups[pc_at]) {
+		case 0:
+			// should be a numeric literal (int32 or float)
+			op.Args[i] = AddDecodedLiteral(decoded, (int32_t)value);
+			continue;
+		case FIXUP_GLOBALDATA: {
+			ScriptVariable *gl_var = (ScriptVariable *)value;
+			arg.SetGlobalVar(&gl_var->RValue);
+		}
+		break;
+		case FIXUP_FUNCTION:
+			// This is a program counter value, presumably will be used as SCMD_CALL argument
+			op.Args[i] = AddDecodedLiteral(decoded, (int32_t)value);
+			continue;
+		case FIXUP_STRING:
+			arg.SetStringLiteral(&strings[0] + value);
+			break;
+		case FIXUP_IMPORT: {
+			const ScriptImport *import = _GP(simp).getByIndex(static_cast<uint32_t>(value));
+			if (import) {
+				arg = import->Value;
+			} else {
+				// Reported when the instruction is run
+				op.ArgType[i] = kScDecodedArgBadImport;
+				op.HasRuntimeArgs = true;
+				op.Args[i] = AddDecodedLiteral(decoded, (int32_t)value);
+				continue;
+			}
+		}
+		break;
+		case FIXUP_STACK:
+			// Depends on the current stack, resolved by Run()
+			op.ArgType[i] = kScDecodedArgStack;
+			op.HasRuntimeArgs = true;
+			op.Args[i] = AddDecodedLiteral(decoded, (int32_t)value);
+			continue;
+		default:
+			cc_error("internal fixup type error: %d", code_fixups[pc_at]);
+			return false;
+		}
+
+		op.Args[i] = decoded.Values.size();
+		decoded.Values.push_back(arg);
+	}
+
+	decoded.OpIndex[at_pc] = decoded.Ops.size();
+	decoded.Ops.push_back(op);
+	return true;
+}
+
+uint32_t ccInstance::AddDecodedLiteral(ScriptDecodedCode &decoded, int32_t value) {
+	// Most literals are register numbers and small constants
+	auto it = decoded.Literals.find(value);
+	if (it != decoded.Literals.end())
+		return it->_value;
+
+	const uint32_t index = decoded.Values.size();
+	decoded.Values.push_back(RuntimeScriptValue().SetInt32(value));
+	decoded.Literals[value] = index;
+	return index;
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
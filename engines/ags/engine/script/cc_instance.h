@@ -24,6 +24,7 @@
 
 #include "common/std/memory.h"
 #include "common/std/map.h"
+#include "common/std/vector.h"
 #include "ags/engine/ac/timer.h"
 #include "ags/shared/script/cc_internal.h"
 #include "ags/shared/script/cc_script.h"  // ccScript
@@ -69,6 +70,38 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// How the argument of a decoded instruction is obtained
+enum ScriptDecodedArgType {
+	kScDecodedArgValue,     // the value was resolved when decoding
+	kScDecodedArgStack,     // stack offset, which is resolved when running
+	kScDecodedArgBadImport  // import which could not be resolved
+};
+
+// Instruction with its arguments decoded and fixed up ahead of time
+struct ScriptDecodedOp {
+	int32_t Code;
+	int32_t InstanceId;
+	int32_t ArgCount;
+	bool    HasRuntimeArgs; // whether any argument is not kScDecodedArgValue
+	uint8_t ArgType[MAX_SCMD_ARGS];
+	uint32_t Args[MAX_SCMD_ARGS]; // indexes in ScriptDecodedCode::Values
+};
+
+// Byte-code of a script instance, translated once into decoded
+// instructions so that running them does not have to decode and fix up
+// their arguments over and over again
+struct ScriptDecodedCode {
+	std::vector<ScriptDecodedOp> Ops;
+	// Index of the instruction starting at each code position, or -1
+	std::vector<int32_t> OpIndex;
+	// Argument values; identical literals are shared between instructions
+	std::vector<RuntimeScriptValue> Values;
+	std::unordered_map<int32_t, uint32_t> Literals;
+	// Imports are resolved when decoding, so the code is decoded again
+	// whenever the imports table changes
+	uint32_t ImportsGeneration;
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -194,6 +227,11 @@ private:
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
+	// Get the decoded code, decoding it first if necessary
+	std::shared_ptr<ScriptDecodedCode> GetDecodedCode();
+	// Decode the instruction at the given bytecode index into the decoded code
+	bool    DecodeOperation(ScriptDecodedCode &decoded, int32_t at_pc);
+	uint32_t AddDecodedLiteral(ScriptDecodedCode &decoded, int32_t value);
 
 	// Begin executing script starting from the given bytecode index
 	int     Run(int32_t curpc);
@@ -224,6 +262,10 @@ private:
 
 	// Last time the script was noted of being "alive"
 	AGS_Clock::time_point _lastAliveTs;
+
+	// Decoded code, shared with the running Run() calls so that decoding
+	// it again while the script runs does not pull it from under them
+	std::shared_ptr<ScriptDecodedCode> _decodedCode;
 };
 
 extern void script_commands_init();
@@ -50,6 +50,8 @@ private:
 
 	std::vector<ScriptImport> imports;
 	IndexMap btree;
+	// Changed whenever an import is added, changed or removed
+	uint32_t generation = 0;
 
 public:
 	uint32_t add(const String &name, const RuntimeScriptValue &value, ccInstance *inst);
@@ -60,6 +62,9 @@ public:
 	String findName(const RuntimeScriptValue &value);
 	void RemoveScriptExports(ccInstance *inst);
 	void clear();
+	uint32_t getGeneration() const {
+		return generation;
+	}
 };
 
 } // namespace AGS3
@@ -608,6 +608,8 @@ public:
 	ObjTexture *_debugMoveListObj;
 	RoomAreaMask _debugRoomMask = kRoomAreaNone;
 	int _debugMoveListChar = -1;
+	// For debugging the regions presented by the software renderer
+	bool _debugDirtyRects = false;
 
 	bool _current_background_is_dirty = false;
 	// Room background sprite
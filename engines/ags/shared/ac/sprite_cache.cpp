@@ -101,6 +101,8 @@ void SpriteCache::Reset() {
 	}
 	_spriteData.clear();
 	_mru.clear();
+	_preloadQueue.clear();
+	_preloadPos = 0;
 	_cacheSize = 0;
 	_lockedSize = 0;
 }
@@ -211,16 +213,104 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 		return _spriteData[index].Image;
 
 	if (_spriteData[index].Image) {
+		_stats.Hits++;
+		if (_spriteData[index].Flags & SPRCACHEFLAG_PRELOADED) {
+			_stats.PreloadHits++;
+			_spriteData[index].Flags &= ~SPRCACHEFLAG_PRELOADED;
+		}
 		// Move to the beginning of the MRU list
 		_mru.splice(_mru.begin(), _mru, _spriteData[index].MruIt);
 	} else {
 		// Sprite exists in file but is not in mem, load it
+		const uint32_t start = g_system->getMillis();
 		LoadSprite(index);
+		_stats.Misses++;
+		_stats.MissTime += g_system->getMillis() - start;
+		_spriteData[index].Flags &= ~SPRCACHEFLAG_PRELOADED;
 		_spriteData[index].MruIt = _mru.insert(_mru.begin(), index);
 	}
 	return _spriteData[index].Image;
 }
 
+void SpriteCache::QueuePreload(sprkey_t index) {
+	if (index < 0 || (size_t)index >= _spriteData.size())
+		return;
+	SpriteData &spr = _spriteData[index];
+	if (!spr.IsAssetSprite() || spr.Image || (spr.Flags & (SPRCACHEFLAG_REMAPPED | SPRCACHEFLAG_PRELOADQUEUED)))
+		return; // not in the game resources, already loaded or queued
+
+	spr.Flags |= SPRCACHEFLAG_PRELOADQUEUED;
+	_preloadQueue.push_back(index);
+}
+
+void SpriteCache::ClearPreloadQueue() {
+	for (size_t i = _preloadPos; i < _preloadQueue.size(); ++i) {
+		if ((size_t)_preloadQueue[i] < _spriteData.size())
+			_spriteData[_preloadQueue[i]].Flags &= ~SPRCACHEFLAG_PRELOADQUEUED;
+	}
+	_preloadQueue.clear();
+	_preloadPos = 0;
+}
+
+size_t SpriteCache::GetPreloadQueueSize() const {
+	return _preloadQueue.size() - _preloadPos;
+}
+
+size_t SpriteCache::ProcessPreloadQueue(uint32_t time_limit) {
+	const uint32_t start = g_system->getMillis();
+	size_t loaded = 0;
+	while (_preloadPos < _preloadQueue.size()) {
+		const sprkey_t index = _preloadQueue[_preloadPos];
+		if ((size_t)index >= _spriteData.size()) {
+			_preloadPos++;
+			continue; // the sprite bank was shrunk
+		}
+
+		SpriteData &spr = _spriteData[index];
+		if (!spr.IsAssetSprite() || spr.Image || (spr.Flags & SPRCACHEFLAG_REMAPPED)) {
+			// Was requested or replaced since it was queued
+			spr.Flags &= ~SPRCACHEFLAG_PRELOADQUEUED;
+			_preloadPos++;
+			continue;
+		}
+
+		// Preloading must not push out the sprites which are in use,
+		// so stop once the cache is full
+		if (_cacheSize + GetExpectedSize(index) > _maxCacheSize) {
+			SprCacheLog("Preload: cache is full, dropping %zu queued sprites", GetPreloadQueueSize());
+			ClearPreloadQueue();
+			break;
+		}
+		if (loaded > 0 && g_system->getMillis() - start >= time_limit)
+			break;
+
+		spr.Flags &= ~SPRCACHEFLAG_PRELOADQUEUED;
+		_preloadPos++;
+		LoadSprite(index);
+		// NOTE: LoadSprite may have remapped the sprite on failure
+		if (_spriteData[index].Image && !_spriteData[index].IsLocked()) {
+			// Put at the end of the MRU list: a preloaded sprite which does not
+			// get used is the first one to dispose
+			_spriteData[index].Flags |= SPRCACHEFLAG_PRELOADED;
+			_spriteData[index].MruIt = _mru.insert(_mru.end(), index);
+		}
+		loaded++;
+	}
+
+	if (_preloadPos >= _preloadQueue.size()) {
+		_preloadQueue.clear();
+		_preloadPos = 0;
+	}
+
+	_stats.Preloaded += loaded;
+	_stats.PreloadTime += g_system->getMillis() - start;
+	return loaded;
+}
+
+void SpriteCache::ResetStats() {
+	_stats = Stats();
+}
+
 void SpriteCache::FreeMem(size_t space) {
 	for (int tries = 0; (_mru.size() > 0) && (_cacheSize >= (_maxCacheSize - space)); ++tries) {
 		DisposeOldest();
@@ -259,6 +349,7 @@ void SpriteCache::DisposeOldest() {
 		_cacheSize -= _spriteData[sprnum].Size;
 		delete _spriteData[*it].Image;
 		_spriteData[sprnum].Image = nullptr;
+		_stats.Evictions++;
 		SprCacheLog("DisposeOldest: disposed %d, size now %d KB", sprnum, _cacheSize / 1024);
 	}
 	// Remove from the mru list
@@ -307,6 +398,12 @@ void SpriteCache::Precache(sprkey_t index) {
 	SprCacheLog("Precached %d", index);
 }
 
+size_t SpriteCache::GetExpectedSize(sprkey_t index) const {
+	// The color depth is only known once the sprite is loaded and converted,
+	// so assume the largest one
+	return (size_t)_sprInfos[index].Width * _sprInfos[index].Height * 4;
+}
+
 sprkey_t SpriteCache::GetDataIndex(sprkey_t index) {
 	return (_spriteData[index].Flags & SPRCACHEFLAG_REMAPPED) == 0 ? index : 0;
 }
@@ -70,6 +70,10 @@ struct SpriteInfo;
 #define SPRCACHEFLAG_REMAPPED       0x02
 // Locked sprites are ones that should not be freed when out of cache space.
 #define SPRCACHEFLAG_LOCKED         0x04
+// Tells that the sprite is waiting in the preload queue.
+#define SPRCACHEFLAG_PRELOADQUEUED  0x08
+// Tells that the sprite was preloaded and was not requested since.
+#define SPRCACHEFLAG_PRELOADED      0x10
 
 // Max size of the sprite cache, in bytes
 #if AGS_PLATFORM_OS_ANDROID || AGS_PLATFORM_OS_IOS
@@ -89,6 +93,17 @@ public:
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
 
+	// Cache usage counters, for the diagnostics
+	struct Stats {
+		uint32_t Hits = 0;        // requested sprites found in memory
+		uint32_t Misses = 0;      // requested sprites loaded on demand
+		uint32_t PreloadHits = 0; // requested sprites found thanks to the preloading
+		uint32_t Preloaded = 0;   // sprites loaded from the preload queue
+		uint32_t Evictions = 0;   // sprites disposed to free cache space
+		uint32_t MissTime = 0;    // time spent loading sprites on demand, in ms
+		uint32_t PreloadTime = 0; // time spent loading queued sprites, in ms
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos);
 	~SpriteCache();
 
@@ -147,6 +162,22 @@ public:
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[](sprkey_t index);
 
+	// Schedules the sprite to be loaded ahead of its use, by ProcessPreloadQueue
+	void        QueuePreload(sprkey_t index);
+	// Drops all the sprites waiting for the preloading
+	void        ClearPreloadQueue();
+	// Returns number of sprites waiting for the preloading
+	size_t      GetPreloadQueueSize() const;
+	// Loads queued sprites until the given time limit (in ms) is spent,
+	// or the cache has no more free space for them; returns number of loaded sprites.
+	// At least one sprite is loaded if there's any space left.
+	size_t      ProcessPreloadQueue(uint32_t time_limit);
+
+	const Stats &GetStats() const {
+		return _stats;
+	}
+	void        ResetStats();
+
 private:
 	// Load sprite from game resource
 	size_t      LoadSprite(sprkey_t index);
@@ -157,6 +188,8 @@ private:
 	void        DisposeOldest();
 	// Keep disposing oldest elements until cache has at least the given free space
 	void        FreeMem(size_t space);
+	// Returns the memory size a loaded sprite takes, judging by its registered info
+	size_t      GetExpectedSize(sprkey_t index) const;
 
 	// Information required for the sprite streaming
 	struct SpriteData {
@@ -194,6 +227,11 @@ private:
 	// that were last time used long ago.
 	std::list<sprkey_t> _mru;
 
+	// Sprites waiting to be loaded ahead of their use, in the order of queuing
+	std::vector<sprkey_t> _preloadQueue;
+	size_t _preloadPos = 0; // next queue position to load
+	Stats _stats;
+
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
@@ -35,6 +35,7 @@ void Test_DoAllTests() {
 	//Test_File();
 	//Test_IniFile();
 	Test_Gfx();
+	Test_ScriptSpeed();
 }
 
 } // namespace AGS3
@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/shared/core/platform.h"
+#include "common/scummsys.h"
+#include "common/debug.h"
+#include "common/system.h"
+#include "ags/shared/script/cc_internal.h"
+#include "ags/shared/util/string_compat.h"
+#include "ags/engine/script/cc_instance.h"
+#include "ags/engine/script/script_runtime.h"
+
+namespace AGS3 {
+
+using namespace AGS::Shared;
+
+static const int32_t kBenchLoops = 10000;
+
+static RuntimeScriptValue Sc_BenchTwice(const RuntimeScriptValue *params, int32_t param_count) {
+	return RuntimeScriptValue().SetInt32(params[0].IValue * 2);
+}
+
+// Builds a script exporting the following function, which exercises the
+// arithmetic, the jumps and the calls to imported functions:
+//
+//   int bench() {
+//     int sum = 0;
+//     for (int i = 0; i < kBenchLoops; i++)
+//       sum += i * 3 + Bench_Twice(i);
+//     return sum;
+//   }
+static ccScript *CreateBenchScript() {
+	const int32_t code[] = {
+		/*  0 */ SCMD_LITTOREG, SREG_CX, 0,
+		/*  3 */ SCMD_LITTOREG, SREG_DX, 0,
+		/*  6 */ SCMD_LINENUM, 1,
+		/*  8 */ SCMD_REGTOREG, SREG_CX, SREG_AX,
+		/* 11 */ SCMD_MUL, SREG_AX, 3,
+		/* 14 */ SCMD_ADDREG, SREG_DX, SREG_AX,
+		/* 17 */ SCMD_PUSHREAL, SREG_CX,
+		/* 19 */ SCMD_LITTOREG, SREG_BX, 0, // import #0
+		/* 22 */ SCMD_CALLEXT, SREG_BX,
+		/* 24 */ SCMD_SUBREALSTACK, 1,
+		/* 26 */ SCMD_ADDREG, SREG_DX, SREG_AX,
+		/* 29 */ SCMD_ADD, SREG_CX, 1,
+		/* 32 */ SCMD_LITTOREG, SREG_BX, kBenchLoops,
+		/* 35 */ SCMD_REGTOREG, SREG_CX, SREG_AX,
+		/* 38 */ SCMD_LESSTHAN, SREG_AX, SREG_BX,
+		/* 41 */ SCMD_JZ, 2,
+		/* 43 */ SCMD_JMP, -39,
+		/* 45 */ SCMD_REGTOREG, SREG_DX, SREG_AX,
+		/* 48 */ SCMD_RET
+	};
+
+	ccScript *scri = new ccScript();
+	scri->codesize = ARRAYSIZE(code);
+	scri->code = (int32_t *)malloc(sizeof(code));
+	memcpy(scri->code, code, sizeof(code));
+
+	scri->numfixups = 1;
+	scri->fixups = (int32_t *)malloc(sizeof(int32_t));
+	scri->fixuptypes = (char *)malloc(1);
+	scri->fixups[0] = 21;
+	scri->fixuptypes[0] = FIXUP_IMPORT;
+
+	scri->numimports = 1;
+	scri->imports = (char **)malloc(sizeof(char *));
+	scri->imports[0] = ags_strdup("Bench_Twice");
+
+	scri->numexports = 1;
+	scri->exports = (char **)malloc(sizeof(char *));
+	scri->export_addr = (int32_t *)malloc(sizeof(int32_t));
+	scri->exports[0] = ags_strdup("bench");
+	scri->export_addr[0] = EXPORT_FUNCTION << 24;
+	return scri;
+}
+
+void Test_ScriptSpeed() {
+	ccAddExternalStaticFunction("Bench_Twice", Sc_BenchTwice);
+
+	PScript scri(CreateBenchScript());
+	ccInstance *inst = ccInstance::CreateFromScript(scri);
+	assert(inst);
+	bool resolved = inst->ResolveScriptImports(scri.get()) && inst->ResolveImportFixups(scri.get());
+	assert(resolved);
+	(void)resolved;
+
+	const int32_t expected = 5 * (kBenchLoops * (kBenchLoops - 1) / 2);
+	const int runs = 100;
+
+	uint32 start = g_system->getMillis();
+	for (int i = 0; i < runs; i++) {
+		int result = inst->CallScriptFunction("bench", 0, nullptr);
+		assert(result == 0 && inst->returnValue == expected);
+		(void)result;
+	}
+	uint32 end = g_system->getMillis();
+
+	debug("Script benchmark: %d runs of %d loops, %u ms (%f ms per run)", runs, kBenchLoops, end - start, (double)(end - start) / runs);
+
+	delete inst;
+}
+
+} // namespace AGS3
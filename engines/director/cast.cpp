@@ -21,6 +21,7 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/hash-ptr.h"
 #include "common/macresman.h"
 #include "common/memstream.h"
 #include "common/substream.h"
@@ -33,6 +34,7 @@
 
 #include "director/director.h"
 #include "director/cast.h"
+#include "director/channel.h"
 #include "director/movie.h"
 #include "director/rte.h"
 #include "director/score.h"
@@ -84,6 +86,11 @@ Cast::Cast(Movie *movie, uint16 castLibID, bool isShared, bool isExternal) {
 	_stageColor = 0;
 
 	_loadedCast = nullptr;
+	_loadedBitmapsSize = 0;
+	_bitmapAccessCounter = 0;
+	_lastBitmapId = 0;
+	_prevBitmapId = 0;
+	_unloadBlocked = false;
 
 	_defaultPalette = CastMemberID(-1, -1);
 	_frameRate = 0;
@@ -141,12 +148,97 @@ CastMember *Cast::getCastMember(int castId, bool load) {
 			_loadQueue.pop_back();
 		}
 		_loadMutex = true;
+
+		if (result->_type == kCastBitmap)
+			touchBitmap(castId, (BitmapCastMember *)result);
 	} else if (result) {
 		_loadQueue.push_back(result);
 	}
 	return result;
 }
 
+void Cast::touchBitmap(int castId, BitmapCastMember *bitmap) {
+	if (!bitmap->isLoaded() || !bitmap->canUnload())
+		return;
+
+	// Members used together, e.g. a cursor and its mask, are fetched one
+	// after the other, keep the previous one too
+	if (castId != _lastBitmapId) {
+		_prevBitmapId = _lastBitmapId;
+		_lastBitmapId = castId;
+	}
+
+	// The size changes when the bitmap gets dithered. Once the loaded
+	// bitmaps have grown, try unloading others again.
+	uint32 size = bitmap->getDecodedSize();
+	LoadedBitmapMap::iterator it = _loadedBitmaps.find(castId);
+	if (it == _loadedBitmaps.end() || size > it->_value.size)
+		_unloadBlocked = false;
+
+	LoadedBitmap &entry = _loadedBitmaps[castId];
+	_loadedBitmapsSize = _loadedBitmapsSize - entry.size + size;
+	entry.size = size;
+	entry.lastAccess = _bitmapAccessCounter++;
+
+	if (_loadedBitmapsSize > kMaxLoadedBitmapsSize && !_unloadBlocked)
+		unloadBitmaps(_lastBitmapId, _prevBitmapId);
+}
+
+void Cast::unloadBitmaps(int keepId, int keepId2) {
+	// Bitmaps on the stage stay loaded, their mattes are in use
+	Common::HashMap<CastMember *, bool> onStage;
+	Movie *movies[] = { _movie, g_director->getCurrentMovie() };
+	for (auto &movie : movies) {
+		if (!movie || !movie->getScore())
+			continue;
+		for (auto &channel : movie->getScore()->_channels) {
+			if (channel->_sprite && channel->_sprite->_cast)
+				onStage[channel->_sprite->_cast] = true;
+		}
+	}
+
+	while (_loadedBitmapsSize > kMaxLoadedBitmapsSize) {
+		LoadedBitmapMap::iterator oldest = _loadedBitmaps.end();
+		for (LoadedBitmapMap::iterator it = _loadedBitmaps.begin(); it != _loadedBitmaps.end(); ++it) {
+			if (it->_key == keepId || it->_key == keepId2)
+				continue;
+
+			CastMember *member = _loadedCast->getValOrDefault(it->_key);
+			if (!member || onStage.contains(member))
+				continue;
+
+			if (oldest == _loadedBitmaps.end() || it->_value.lastAccess < oldest->_value.lastAccess)
+				oldest = it;
+		}
+
+		if (oldest == _loadedBitmaps.end()) {
+			// Everything left is in use. Don't look again on every lookup,
+			// only once more bitmaps have been loaded.
+			_unloadBlocked = true;
+			break;
+		}
+
+		BitmapCastMember *bitmap = (BitmapCastMember *)_loadedCast->getVal(oldest->_key);
+		debugC(3, kDebugLoading, "Cast::unloadBitmaps(): Unloading bitmap %d, %d bytes", oldest->_key, oldest->_value.size);
+
+		// Lingo might have replaced the picture, then it can't be loaded again
+		if (bitmap->canUnload())
+			bitmap->unload();
+
+		_loadedBitmapsSize -= oldest->_value.size;
+		_loadedBitmaps.erase(oldest);
+	}
+}
+
+void Cast::forgetBitmap(int castId) {
+	LoadedBitmapMap::iterator it = _loadedBitmaps.find(castId);
+	if (it == _loadedBitmaps.end())
+		return;
+
+	_loadedBitmapsSize -= it->_value.size;
+	_loadedBitmaps.erase(it);
+}
+
 void Cast::releaseCastMemberWidget() {
 	if (_loadedCast)
 		for (auto &it : *_loadedCast)
@@ -187,6 +279,15 @@ const Stxt *Cast::getStxt(int castId) {
 
 	if (_loadedStxts.contains(castId)) {
 		result = _loadedStxts.getVal(castId);
+	} else if (_version >= kFileVer400) {
+		// Read on first use, see loadCast()
+		Common::SeekableReadStreamEndian *r = getResource(MKTAG('S','T','X','T'), castId + _castIDoffset);
+		if (r) {
+			result = new Stxt(this, *r);
+			_loadedStxts.setVal(castId, result);
+			debugC(3, kDebugText, "STXT: id %d", castId);
+			delete r;
+		}
 	}
 	return result;
 }
@@ -237,6 +338,7 @@ CastMember *Cast::setCastMember(int castId, CastMember *cast) {
 	if (_loadedCast->contains(castId)) {
 		_loadedCast->erase(castId);
 	}
+	forgetBitmap(castId);
 
 	_loadedCast->setVal(castId, cast);
 	return cast;
@@ -298,6 +400,7 @@ bool Cast::eraseCastMember(int castId) {
 		CastMember *member = _loadedCast->getVal(castId);
 		delete member;
 		_loadedCast->erase(castId);
+		forgetBitmap(castId);
 
 		if (_castsInfo.contains(castId)) {
 			CastMemberInfo *info = _castsInfo.getVal(castId);
@@ -663,9 +766,13 @@ void Cast::loadCast() {
 		delete r;
 	}
 
-	// Now process STXTs
-	Common::Array<uint16> stxt = _castArchive->getResourceIDList(MKTAG('S','T','X','T'));
-	debugC(2, kDebugLoading, "****** Loading %d STXT resources", stxt.size());
+	// Now process STXTs. From D4 on, they are only read when the text cast
+	// members are first used, see getStxt().
+	Common::Array<uint16> stxt;
+	if (_version < kFileVer400) {
+		stxt = _castArchive->getResourceIDList(MKTAG('S','T','X','T'));
+		debugC(2, kDebugLoading, "****** Loading %d STXT resources", stxt.size());
+	}
 
 	for (auto &iterator : stxt) {
 		_loadedStxts.setVal(iterator - _castIDoffset,
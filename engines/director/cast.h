@@ -179,10 +179,33 @@ private:
 	Lingo *_lingo;
 	Movie *_movie;
 
+	void touchBitmap(int castId, BitmapCastMember *bitmap);
+	void unloadBitmaps(int keepId, int keepId2);
+	void forgetBitmap(int castId);
+
 	bool _isShared;
 	bool _loadMutex;
 	Common::Array<CastMember *> _loadQueue;
 
+	// Decoded bitmaps which can be loaded again from the archive. The least
+	// recently used ones are unloaded when they take more than the budget.
+	enum {
+		kMaxLoadedBitmapsSize = 32 * 1024 * 1024
+	};
+
+	struct LoadedBitmap {
+		uint32 size = 0;
+		uint32 lastAccess = 0;
+	};
+	typedef Common::HashMap<int, LoadedBitmap> LoadedBitmapMap;
+
+	LoadedBitmapMap _loadedBitmaps;
+	uint32 _loadedBitmapsSize;
+	uint32 _bitmapAccessCounter;
+	int _lastBitmapId;		// the two bitmaps fetched last, never unloaded
+	int _prevBitmapId;
+	bool _unloadBlocked;	// set when nothing could be unloaded
+
 	Common::String _macName;
 
 	Common::HashMap<uint16, CastMemberInfo *> _castsInfo;
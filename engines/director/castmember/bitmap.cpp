@@ -45,7 +45,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 	_type = kCastBitmap;
 	_picture = new Picture();
 	_ditheredImg = nullptr;
-	_matte = nullptr;
 	_noMatte = false;
 	_bytes = 0;
 	_pitch = 0;
@@ -55,6 +54,8 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 	_ditheredTargetClut = CastMemberID(0, 0);
 	_bitsPerPixel = 0;
 	_external = false;
+	_pictureReplaced = false;
+	_needsReload = false;
 
 	if (debugChannelSet(5, kDebugLoading)) {
 		stream.hexdump(stream.size());
@@ -159,7 +160,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Common::SeekableRe
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Image::ImageDecoder *img, uint8 flags1)
 	: CastMember(cast, castId) {
 	_type = kCastBitmap;
-	_matte = nullptr;
 	_noMatte = false;
 	_bytes = 0;
 	if (img != nullptr) {
@@ -177,6 +177,8 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, Image::ImageDecode
 	_flags2 = 0;
 	_tag = 0;
 	_external = false;
+	_pictureReplaced = true;
+	_needsReload = false;
 }
 
 BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, BitmapCastMember &source)
@@ -192,7 +194,6 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, BitmapCastMember &
 
 	_picture = source._picture ? new Picture(*source._picture) : nullptr;
 	_ditheredImg = nullptr;
-	_matte = nullptr;
 
 	_pitch = source._pitch;
 	_regX = source._regX;
@@ -207,6 +208,8 @@ BitmapCastMember::BitmapCastMember(Cast *cast, uint16 castId, BitmapCastMember &
 	_tag = source._tag;
 	_noMatte = source._noMatte;
 	_external = source._external;
+	_pictureReplaced = true;
+	_needsReload = false;
 
 	warning("BitmapCastMember(): Duplicating source %d to target %d! This is unlikely to work properly, as the resource loader is based on the cast ID", source._castId, castId);
 }
@@ -219,13 +222,13 @@ BitmapCastMember::~BitmapCastMember() {
 		delete _ditheredImg;
 	}
 
-	if (_matte) {
-		_matte->free();
-		delete _matte;
-	}
+	clearMattes();
 }
 
 Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) {
+	if (_needsReload)
+		_cast->getCastMember(_castId);
+
 	if (!_picture) {
 		warning("BitmapCastMember::createWidget: No picture");
 		return nullptr;
@@ -253,6 +256,9 @@ Graphics::MacWidget *BitmapCastMember::createWidget(Common::Rect &bbox, Channel
 			_ditheredTargetClut = CastMemberID(0, 0);
 		}
 
+		// The mattes are made from the dithered image
+		clearMattes();
+
 		if (dstBpp == 1) {
 			// ScummVM using 8-bit video
 
@@ -440,7 +446,7 @@ bool BitmapCastMember::isModified() {
 	return false;
 }
 
-void BitmapCastMember::createMatte(Common::Rect &bbox) {
+Graphics::Surface *BitmapCastMember::createMatte(Common::Rect &bbox) {
 	// Like background trans, but all white pixels NOT ENCLOSED by coloured pixels
 	// are transparent
 	Graphics::Surface tmp;
@@ -453,8 +459,6 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 		bbox
 	);
 
-	_noMatte = true;
-
 	// Searching white color in the corners
 	uint32 whiteColor = 0;
 	bool colorFound = false;
@@ -478,14 +482,12 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 		colorFound = true;
 	}
 
+	Graphics::Surface *matte = nullptr;
+
 	if (!colorFound) {
 		debugC(1, kDebugImages, "BitmapCastMember::createMatte(): No white color for matte image");
+		_noMatte = true;
 	} else {
-		if (_matte) {
-			_matte->free();
-			delete _matte;
-		}
-
 		Graphics::FloodFill matteFill(&tmp, whiteColor, 0, true);
 
 		for (int yy = 0; yy < tmp.h; yy++) {
@@ -502,31 +504,64 @@ void BitmapCastMember::createMatte(Common::Rect &bbox) {
 		Graphics::Surface *matteSurf = matteFill.getMask();
 		// convert the mask to the same surface format used for 1bpp bitmaps.
 		// this uses the director palette scheme, so white is 0x00 and black is 0xff.
-		_matte = new Graphics::Surface();
-		_matte->create(matteSurf->w, matteSurf->h, Graphics::PixelFormat::createFormatCLUT8());
+		matte = new Graphics::Surface();
+		matte->create(matteSurf->w, matteSurf->h, Graphics::PixelFormat::createFormatCLUT8());
 		for (int y = 0; y < matteSurf->h; y++) {
 			for (int x = 0; x < matteSurf->w; x++) {
-				_matte->setPixel(x, y, matteSurf->getPixel(x, y) ? 0x00 : 0xff);
+				matte->setPixel(x, y, matteSurf->getPixel(x, y) ? 0x00 : 0xff);
 			}
 		}
-		_noMatte = false;
 	}
 
 	tmp.free();
+
+	return matte;
 }
 
 Graphics::Surface *BitmapCastMember::getMatte(Common::Rect &bbox) {
-	// Lazy loading of mattes
-	if (!_matte && !_noMatte) {
-		createMatte(bbox);
+	if (_needsReload)
+		_cast->getCastMember(_castId);
+
+	if (_noMatte)
+		return nullptr;
+
+	// Lazy loading of mattes. They are kept for each size, as the same
+	// bitmap can be on the stage stretched to several sizes at once.
+	for (uint i = 0; i < _mattes.size(); i++) {
+		Graphics::Surface *matte = _mattes[i];
+		if (matte->w == bbox.width() && matte->h == bbox.height()) {
+			// Keep the most recently used matte last
+			if (i != _mattes.size() - 1) {
+				_mattes.remove_at(i);
+				_mattes.push_back(matte);
+			}
+			return matte;
+		}
 	}
 
-	// check for the scale matte
-	if (_matte && (_matte->w != bbox.width() || _matte->h != bbox.height())) {
-		createMatte(bbox);
+	Graphics::Surface *matte = createMatte(bbox);
+	if (!matte)
+		return nullptr;
+
+	if (_mattes.size() >= kMaxMattes) {
+		_mattes[0]->free();
+		delete _mattes[0];
+		_mattes.remove_at(0);
 	}
+	_mattes.push_back(matte);
+
+	debugC(5, kDebugImages, "BitmapCastMember::getMatte(): Created %dx%d matte for cast %d, %d cached", matte->w, matte->h, _castId, _mattes.size());
 
-	return _matte;
+	return matte;
+}
+
+void BitmapCastMember::clearMattes() {
+	for (auto &matte : _mattes) {
+		matte->free();
+		delete matte;
+	}
+	_mattes.clear();
+	_noMatte = false;
 }
 
 Common::String BitmapCastMember::formatInfo() {
@@ -694,6 +729,7 @@ void BitmapCastMember::load() {
 	debugC(5, kDebugImages, "BitmapCastMember::load(): Bitmap: id: %d, w: %d, h: %d, flags1: %x, flags2: %x bytes: %x, bpp: %d clut: %s", imgId, w, h, _flags1, _flags2, _bytes, _bitsPerPixel, _clut.asString().c_str());
 
 	_loaded = true;
+	_needsReload = false;
 }
 
 void BitmapCastMember::unload() {
@@ -706,7 +742,25 @@ void BitmapCastMember::unload() {
 	delete _ditheredImg;
 	_ditheredImg = nullptr;
 
+	clearMattes();
+
 	_loaded = false;
+	_needsReload = true;
+}
+
+uint32 BitmapCastMember::getDecodedSize() const {
+	uint32 size = 0;
+
+	if (_picture)
+		size += _picture->_surface.pitch * _picture->_surface.h + _picture->getPaletteSize();
+
+	if (_ditheredImg)
+		size += _ditheredImg->pitch * _ditheredImg->h;
+
+	for (auto &matte : _mattes)
+		size += matte->pitch * matte->h;
+
+	return size;
 }
 
 PictureReference *BitmapCastMember::getPicture() const {
@@ -723,10 +777,12 @@ PictureReference *BitmapCastMember::getPicture() const {
 void BitmapCastMember::setPicture(PictureReference &picture) {
 	delete _picture;
 	_picture = new Picture(*picture._picture);
+	_pictureReplaced = true;
 
 	// Force redither
 	delete _ditheredImg;
 	_ditheredImg = nullptr;
+	clearMattes();
 
 	// Make sure we get redrawn
 	setModified(true);
@@ -736,6 +792,7 @@ void BitmapCastMember::setPicture(PictureReference &picture) {
 void BitmapCastMember::setPicture(Image::ImageDecoder &image, bool adjustSize) {
 	delete _picture;
 	_picture = new Picture(image);
+	clearMattes();
 	if (adjustSize) {
 		auto surf = image.getSurface();
 		_size = surf->pitch * surf->h + _picture->getPaletteSize();
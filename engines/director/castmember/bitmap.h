@@ -40,8 +40,9 @@ public:
 	Graphics::MacWidget *createWidget(Common::Rect &bbox, Channel *channel, SpriteType spriteType) override;
 
 	bool isModified() override;
-	void createMatte(Common::Rect &bbox);
+	Graphics::Surface *createMatte(Common::Rect &bbox);
 	Graphics::Surface *getMatte(Common::Rect &bbox);
+	void clearMattes();
 	Graphics::Surface *getDitherImg();
 
 	bool hasField(int field) override;
@@ -57,12 +58,17 @@ public:
 	void setPicture(PictureReference &picture);
 	void setPicture(Image::ImageDecoder &image, bool adjustSize);
 
+	// Whether the picture can be unloaded and loaded again from the archive
+	bool canUnload() const { return _loaded && !_pictureReplaced; }
+	uint32 getDecodedSize() const;
+
 	Common::Point getRegistrationOffset() override;
 	Common::Point getRegistrationOffset(int16 width, int16 height) override;
 
 	Picture *_picture = nullptr;
 	Graphics::Surface *_ditheredImg;
-	Graphics::Surface *_matte;
+	// Mattes for each size the bitmap is drawn at, most recently used last
+	Common::Array<Graphics::Surface *> _mattes;
 
 	uint16 _pitch;
 	int16 _regX;
@@ -77,6 +83,11 @@ public:
 	uint32 _tag;
 	bool _noMatte;
 	bool _external;
+	bool _pictureReplaced;	// not from the archive, e.g. set from Lingo
+	bool _needsReload;	// unloaded to save memory, see Cast::unloadBitmaps()
+
+private:
+	static const uint kMaxMattes = 4;
 };
 
 } // End of namespace Director
@@ -478,8 +478,8 @@ void TextCastMember::load() {
 		stxtid = _castId;
 	}
 
-	if (_cast->_loadedStxts.contains(stxtid)) {
-		const Stxt *stxt = _cast->_loadedStxts.getVal(stxtid);
+	const Stxt *stxt = _cast->getStxt(stxtid);
+	if (stxt) {
 		importStxt(stxt);
 		_size = stxt->_size;
 	} else {
@@ -49,6 +49,7 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 	_widget = nullptr;
 	_constraint = 0;
 	_mask = nullptr;
+	_maskPicture = nullptr;
 
 	_priority = priority;
 
@@ -61,6 +62,7 @@ Channel::Channel(Score *sc, Sprite *sp, int priority) {
 
 	_visible = true;
 	_dirty = true;
+	_renderStateValid = false;
 
 	if (_sprite)
 		_sprite->updateEditable();
@@ -77,6 +79,7 @@ Channel& Channel::operator=(const Channel &channel) {
 	_widget = nullptr;
 	_constraint = channel._constraint;
 	_mask = nullptr;
+	_maskPicture = nullptr;
 
 	_priority = channel._priority;
 
@@ -89,6 +92,7 @@ Channel& Channel::operator=(const Channel &channel) {
 
 	_visible = channel._visible;
 	_dirty = channel._dirty;
+	_renderStateValid = false;
 
 	return *this;
 }
@@ -193,14 +197,19 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 				return nullptr;
 			}
 
-			if (_mask) {
-				delete _mask;
-				_mask = nullptr;
-			}
 			if (bitmap->_picture) {
 				// reposition channel bounding box, so origin is at registration offset
 				Common::Point originPos = getPosition();
 				bbox.translate(-originPos.x, -originPos.y);
+
+				// the mask is kept until the sprite or the mask cast member change
+				if (_mask && _maskId == maskID && _maskBbox == bbox && _maskPicture == bitmap->_picture && !bitmap->isModified())
+					return &_mask->rawSurface();
+
+				if (_mask) {
+					delete _mask;
+					_mask = nullptr;
+				}
 				// create new mask surface, with the exact dimensions of the channel.
 				_mask = new Graphics::ManagedSurface(bbox.width(), bbox.height());
 				// get the bounding box of the mask image (origin at registration offset)
@@ -217,6 +226,10 @@ const Graphics::Surface *Channel::getMask(bool forceMatte) {
 				srcRect.translate(-destOrigin.x, -destOrigin.y);
 				debugC(8, kDebugImages, "Channel::getMask(): cast mask %s, orig %dx%d, dest %dx%d, crop %d,%d %dx%d",  maskID.asString().c_str(), bitmap->_picture->_surface.w, bitmap->_picture->_surface.h, bbox.width(), bbox.height(), destRect.left, destRect.top, destRect.width(), destRect.height());
 				_mask->copyRectToSurface(bitmap->_picture->_surface, destRect.left, destRect.top, srcRect);
+
+				_maskId = maskID;
+				_maskBbox = bbox;
+				_maskPicture = bitmap->_picture;
 				return &_mask->rawSurface();
 			} else {
 				warning("Channel::getMask(): Requested cast mask %s, but no picture found", maskID.asString().c_str());
@@ -265,6 +278,29 @@ bool Channel::isDirty(Sprite *nextSprite) {
 	return isDirtyFlag;
 }
 
+ChannelRenderState Channel::getRenderState() {
+	ChannelRenderState state;
+	state.widget = _widget;
+	state.visible = _visible;
+	state.filmLoopFrame = _filmLoopFrame;
+
+	if (_sprite) {
+		state.bbox = getBbox();
+		state.castId = _sprite->_castId;
+		state.cast = _sprite->_cast;
+		state.spriteType = _sprite->_spriteType;
+		state.ink = _sprite->_ink;
+		state.foreColor = _sprite->_foreColor;
+		state.backColor = _sprite->_backColor;
+		state.blendAmount = _sprite->_blendAmount;
+		state.pattern = _sprite->_pattern;
+		state.thickness = _sprite->_thickness;
+		state.trails = _sprite->_trails;
+	}
+
+	return state;
+}
+
 bool Channel::isStretched() {
 	return _sprite->_stretch;
 }
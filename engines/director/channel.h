@@ -36,6 +36,35 @@ namespace Director {
 class Sprite;
 class Cursor;
 class Score;
+class CastMember;
+class Picture;
+
+// What a channel looked like when it was last drawn, see Score::updateSprites()
+struct ChannelRenderState {
+	Common::Rect bbox;
+	CastMemberID castId;
+	CastMember *cast = nullptr;
+	Graphics::MacWidget *widget = nullptr;
+	SpriteType spriteType = kInactiveSprite;
+	InkType ink = kInkTypeCopy;
+	uint32 foreColor = 0;
+	uint32 backColor = 0;
+	byte blendAmount = 0;
+	uint16 pattern = 0;
+	byte thickness = 0;
+	bool trails = false;
+	bool visible = false;
+	uint filmLoopFrame = 0;
+
+	bool operator==(const ChannelRenderState &s) const {
+		return bbox == s.bbox && castId == s.castId && cast == s.cast && widget == s.widget &&
+			spriteType == s.spriteType && ink == s.ink && foreColor == s.foreColor &&
+			backColor == s.backColor && blendAmount == s.blendAmount && pattern == s.pattern &&
+			thickness == s.thickness && trails == s.trails && visible == s.visible &&
+			filmLoopFrame == s.filmLoopFrame;
+	}
+	bool operator!=(const ChannelRenderState &s) const { return !(*this == s); }
+};
 
 class Channel {
 public:
@@ -55,6 +84,7 @@ public:
 
 	bool isStretched();
 	bool isDirty(Sprite *nextSprite = nullptr);
+	ChannelRenderState getRenderState();
 	bool isEmpty();
 	bool isActiveText();
 	bool isMouseIn(const Common::Point &pos);
@@ -105,6 +135,10 @@ public:
 	uint _constraint;
 	Graphics::ManagedSurface *_mask;
 
+	// Last drawn state, only meaningful when _renderStateValid is set
+	ChannelRenderState _renderState;
+	bool _renderStateValid;
+
 	int _priority;
 
 	// Used in digital movie sprites
@@ -119,6 +153,11 @@ public:
 private:
 	Graphics::ManagedSurface *getSurface();
 	Score *_score;
+
+	// What _mask was made from, see getMask()
+	CastMemberID _maskId;
+	Common::Rect _maskBbox;
+	Picture *_maskPicture;
 };
 
 } // End of namespace Director
@@ -191,7 +191,7 @@ bool Debugger::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" bplist - Lists all breakpoints\n");
 	debugPrintf("\n");
 	debugPrintf("GFX:\n");
-	debugPrintf(" draw [cast|frame|off] - Draws debug outlines for cast or frame number\n");
+	debugPrintf(" draw [cast|frame|dirty|off] - Draws debug outlines for cast, frame number or redrawn areas\n");
 	return true;
 }
 
@@ -968,10 +968,12 @@ bool Debugger::cmdDraw(int argc, const char **argv) {
 				g_director->_debugDraw |= kDebugDrawCast;
 			} else if (!strncmp(argv[i], "frame", 5)) { // allow "frameS"
 				g_director->_debugDraw |= kDebugDrawFrame;
+			} else if (!scumm_stricmp(argv[i], "dirty")) {
+				g_director->_debugDraw |= kDebugDrawDirty;
 			} else if (!scumm_stricmp(argv[i], "all")) {
-				g_director->_debugDraw |= kDebugDrawCast | kDebugDrawFrame;
+				g_director->_debugDraw |= kDebugDrawCast | kDebugDrawFrame | kDebugDrawDirty;
 			} else {
-				debugPrintf("Valid parameters are 'cast', 'frame', 'all' or 'off'.\n");
+				debugPrintf("Valid parameters are 'cast', 'frame', 'dirty', 'all' or 'off'.\n");
 				return true;
 			}
 		}
@@ -984,6 +986,9 @@ bool Debugger::cmdDraw(int argc, const char **argv) {
 	if (g_director->_debugDraw & kDebugDrawFrame)
 		debugPrintf("frame ");
 
+	if (g_director->_debugDraw & kDebugDrawDirty)
+		debugPrintf("dirty ");
+
 	if (!g_director->_debugDraw)
 		debugPrintf("off ");
 
@@ -88,6 +88,7 @@ enum {
 	kDebugImGui,
 	kDebugPaused,
 	kDebugPauseOnLoad,
+	kDebugInkCheck,
 };
 
 enum {
@@ -325,6 +326,11 @@ public:
 	bool _firstMovie = true;
 };
 
+struct DirectorPlotData;
+
+// Draws a row of a bitmap sprite with an ink, see DirectorPlotData::getInkBlitSpan()
+typedef void (*InkBlitSpanPtr)(void *dst, const void *src, const byte *msk, int width, const DirectorPlotData *p);
+
 // An extension of MacPlotData for interfacing with inks and patterns without
 // needing extra surfaces.
 struct DirectorPlotData {
@@ -353,6 +359,10 @@ struct DirectorPlotData {
 	uint32 preprocessColor(uint32 src);
 	void inkBlitShape(Common::Rect &srcRect);
 	void inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask);
+	InkBlitSpanPtr getInkBlitSpan();
+	void inkBlitPixels(Common::Rect &srcRect, const Graphics::Surface *mask, bool &failedBoundsCheck);
+	void inkBlitSpans(Common::Rect &srcRect, const Graphics::Surface *mask, InkBlitSpanPtr blitSpan, bool &failedBoundsCheck);
+	void inkBlitCheck(Common::Rect &srcRect, const Graphics::Surface *mask, InkBlitSpanPtr blitSpan, bool &failedBoundsCheck);
 
 	DirectorPlotData(DirectorEngine *d_, SpriteType s, InkType i, int a, uint32 b, uint32 f) : d(d_), sprite(s), ink(i), alpha(a), backColor(b), foreColor(f) {
 		colorWhite = d->_wm->_colorWhite;
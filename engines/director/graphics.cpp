@@ -21,6 +21,7 @@
 
 #include "common/system.h"
 #include "common/memstream.h"
+#include "common/profiler.h"
 #include "graphics/paletteman.h"
 #include "graphics/macgui/macwindowmanager.h"
 
@@ -260,74 +261,18 @@ void DirectorEngine::setCursor(DirectorCursor type) {
 }
 
 void DirectorEngine::draw() {
+	PROFILE_ZONE("Director::DirectorEngine::draw");
+
 	_wm->renderZoomBox(true);
 	_wm->draw();
 	g_system->updateScreen();
 }
 
+// Applies the ink to a single pixel. The span blitters below call this with
+// a constant ink, so the switch is folded away when it gets inlined.
 template <typename T>
-void inkDrawPixel(int x, int y, int src, void *data) {
-	DirectorPlotData *p = (DirectorPlotData *)data;
-	Graphics::MacWindowManager *wm = p->d->_wm;
-
-	if (!p->destRect.contains(x, y))
-		return;
-
-	T *dst;
-	uint32 tmpDst;
-
-	dst = (T *)p->dst->getBasePtr(x, y);
-
-	if (p->ms) {
-		if (p->ms->pd->thickness > 1) {
-			int prevThickness = p->ms->pd->thickness;
-			int x1 = x;
-			int x2 = x1 + prevThickness;
-			int y1 = y;
-			int y2 = y1 + prevThickness;
-
-			p->ms->pd->thickness = 1;	// We do not want recursive loops
-
-			for (y = y1; y < y2; y++)
-				for (x = x1; x < x2; x++)
-					if (x >= 0 && x < p->ms->pd->surface->w && y >= 0 && y < p->ms->pd->surface->h) {
-						inkDrawPixel<T>(x, y, src, data);
-					}
-
-			p->ms->pd->thickness = prevThickness;
-			return;
-		}
-
-		if (p->ms->tile) {
-			int x1 = p->ms->tileRect->left + (p->ms->pd->fillOriginX + x) % p->ms->tileRect->width();
-			int y1 = p->ms->tileRect->top  + (p->ms->pd->fillOriginY + y) % p->ms->tileRect->height();
-
-			src = p->ms->tile->_surface.getPixel(x1, y1);
-		} else {
-			// Get the pixel that macDrawPixel will give us, but store it to apply the
-			// ink later
-			tmpDst = *dst;
-			(wm->getDrawPixel())(x, y, src, p->ms->pd);
-			src = *dst;
-
-			*dst = tmpDst;
-		}
-	} else if (p->alpha) {
-		// Sprite blend does not respect colourization; defaults to matte ink
-		byte rSrc, gSrc, bSrc;
-		byte rDst, gDst, bDst;
-
-		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
-		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
-
-		rDst = lerpByte(rSrc, rDst, p->alpha, 255);
-		gDst = lerpByte(gSrc, gDst, p->alpha, 255);
-		bDst = lerpByte(bSrc, bDst, p->alpha, 255);
-		*dst = wm->findBestColor(rDst, gDst, bDst);
-		return;
-	}
-
- 	switch (p->ink) {
+static inline void inkApplyPixel(T *dst, int src, InkType ink, const DirectorPlotData *p, Graphics::MacWindowManager *wm) {
+	switch (ink) {
 	case kInkTypeBackgndTrans:
 		if (p->oneBitImage) {
 			// One-bit images have a slightly different rendering algorithm for BackgndTrans.
@@ -453,7 +398,7 @@ void inkDrawPixel(int x, int y, int src, void *data) {
 		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
 		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
 
-		switch (p->ink) {
+		switch (ink) {
 		case kInkTypeAddPin:
 			// Add src to dst, but pinning each channel so it can't go above 0xff.
 			*dst = wm->findBestColor(rDst + MIN(0xff - rDst, (int)rSrc), gDst + MIN(0xff - gDst, (int)gSrc), bDst + MIN(0xff - bDst, (int)bSrc));
@@ -485,6 +430,71 @@ void inkDrawPixel(int x, int y, int src, void *data) {
 	}
 }
 
+template <typename T>
+void inkDrawPixel(int x, int y, int src, void *data) {
+	DirectorPlotData *p = (DirectorPlotData *)data;
+	Graphics::MacWindowManager *wm = p->d->_wm;
+
+	if (!p->destRect.contains(x, y))
+		return;
+
+	T *dst;
+	uint32 tmpDst;
+
+	dst = (T *)p->dst->getBasePtr(x, y);
+
+	if (p->ms) {
+		if (p->ms->pd->thickness > 1) {
+			int prevThickness = p->ms->pd->thickness;
+			int x1 = x;
+			int x2 = x1 + prevThickness;
+			int y1 = y;
+			int y2 = y1 + prevThickness;
+
+			p->ms->pd->thickness = 1;	// We do not want recursive loops
+
+			for (y = y1; y < y2; y++)
+				for (x = x1; x < x2; x++)
+					if (x >= 0 && x < p->ms->pd->surface->w && y >= 0 && y < p->ms->pd->surface->h) {
+						inkDrawPixel<T>(x, y, src, data);
+					}
+
+			p->ms->pd->thickness = prevThickness;
+			return;
+		}
+
+		if (p->ms->tile) {
+			int x1 = p->ms->tileRect->left + (p->ms->pd->fillOriginX + x) % p->ms->tileRect->width();
+			int y1 = p->ms->tileRect->top  + (p->ms->pd->fillOriginY + y) % p->ms->tileRect->height();
+
+			src = p->ms->tile->_surface.getPixel(x1, y1);
+		} else {
+			// Get the pixel that macDrawPixel will give us, but store it to apply the
+			// ink later
+			tmpDst = *dst;
+			(wm->getDrawPixel())(x, y, src, p->ms->pd);
+			src = *dst;
+
+			*dst = tmpDst;
+		}
+	} else if (p->alpha) {
+		// Sprite blend does not respect colourization; defaults to matte ink
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		wm->decomposeColor<T>(src, rSrc, gSrc, bSrc);
+		wm->decomposeColor<T>(*dst, rDst, gDst, bDst);
+
+		rDst = lerpByte(rSrc, rDst, p->alpha, 255);
+		gDst = lerpByte(gSrc, gDst, p->alpha, 255);
+		bDst = lerpByte(bSrc, bDst, p->alpha, 255);
+		*dst = wm->findBestColor(rDst, gDst, bDst);
+		return;
+	}
+
+	inkApplyPixel<T>(dst, src, p->ink, p, wm);
+}
+
 Graphics::MacDrawPixPtr DirectorEngine::getInkDrawPixel() {
 	if (_pixelformat.bytesPerPixel == 1)
 		return &inkDrawPixel<byte>;
@@ -676,6 +686,221 @@ void DirectorPlotData::inkBlitShape(Common::Rect &srcRect) {
 	}
 }
 
+// Span blitters
+//
+// Bitmap sprites are drawn a row at a time through a blitter picked once
+// per sprite, instead of calling getInkDrawPixel() for every pixel. The
+// ink is a template parameter, so the ink switch goes away, and the rows
+// without a mask get their own loop the compiler can vectorize.
+
+// Inks which don't depend on the colourization boil down to a bitwise
+// operation on the pixel values
+template <typename T, InkType ink>
+static inline T inkPlainPixel(T dst, T src, T backColor) {
+	switch (ink) {
+	case kInkTypeBackgndTrans:
+		return src == backColor ? dst : src;
+	case kInkTypeTransparent:
+		return dst | src;
+	case kInkTypeNotTrans:
+		return dst | (T)~src;
+	case kInkTypeReverse:
+		return dst ^ src;
+	case kInkTypeNotReverse:
+		return dst ^ (T)~src;
+	case kInkTypeGhost:
+		return dst & (T)~src;
+	case kInkTypeNotGhost:
+		return dst & src;
+	default:
+		// Copy and friends
+		return src;
+	}
+}
+
+template <typename T, InkType ink>
+static void inkBlitSpanPlain(void *dstPtr, const void *srcPtr, const byte *msk, int width, const DirectorPlotData *p) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	const T backColor = p->backColor;
+
+	if (!msk) {
+		if (ink == kInkTypeCopy) {
+			memcpy(dst, src, width * sizeof(T));
+			return;
+		}
+
+		for (int i = 0; i < width; i++)
+			dst[i] = inkPlainPixel<T, ink>(dst[i], src[i], backColor);
+	} else {
+		for (int i = 0; i < width; i++)
+			dst[i] = msk[i] ? inkPlainPixel<T, ink>(dst[i], src[i], backColor) : dst[i];
+	}
+}
+
+template <typename T, InkType ink>
+static void inkBlitSpan(void *dstPtr, const void *srcPtr, const byte *msk, int width, const DirectorPlotData *p) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	Graphics::MacWindowManager *wm = p->d->_wm;
+
+	for (int i = 0; i < width; i++) {
+		if (!msk || msk[i])
+			inkApplyPixel<T>(dst + i, src[i], ink, p, wm);
+	}
+}
+
+// Sprite blend, see inkDrawPixel()
+template <typename T>
+static void inkBlitSpanBlend(void *dstPtr, const void *srcPtr, const byte *msk, int width, const DirectorPlotData *p) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	Graphics::MacWindowManager *wm = p->d->_wm;
+	const Graphics::PixelFormat &format = wm->_pixelformat;
+	const int alpha = CLIP<int>(p->alpha, 0, 255);
+
+	for (int i = 0; i < width; i++) {
+		if (msk && !msk[i])
+			continue;
+
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		if (sizeof(T) == 4) {
+			// Skip the calls into the window manager, which end up here anyway
+			format.colorToRGB(src[i], rSrc, gSrc, bSrc);
+			format.colorToRGB(dst[i], rDst, gDst, bDst);
+		} else {
+			wm->decomposeColor<T>(src[i], rSrc, gSrc, bSrc);
+			wm->decomposeColor<T>(dst[i], rDst, gDst, bDst);
+		}
+
+		// Same as lerpByte(src, dst, alpha, 255)
+		rDst = (rDst * alpha + rSrc * (255 - alpha)) / 255;
+		gDst = (gDst * alpha + gSrc * (255 - alpha)) / 255;
+		bDst = (bDst * alpha + bSrc * (255 - alpha)) / 255;
+
+		if (sizeof(T) == 4)
+			dst[i] = format.RGBToColor(rDst, gDst, bDst);
+		else
+			dst[i] = wm->findBestColor(rDst, gDst, bDst);
+	}
+}
+
+// Add and add pin, see inkApplyPixel(). In 32bpp the channels are added
+// through the pixel format directly. In 8bpp the color found in the
+// palette is reused while the source and destination pixels stay the same.
+template <typename T, InkType ink>
+static void inkBlitSpanAdd(void *dstPtr, const void *srcPtr, const byte *msk, int width, const DirectorPlotData *p) {
+	T *dst = (T *)dstPtr;
+	const T *src = (const T *)srcPtr;
+	Graphics::MacWindowManager *wm = p->d->_wm;
+	const Graphics::PixelFormat &format = wm->_pixelformat;
+
+	bool cached = false;
+	T cachedSrc = 0, cachedDst = 0, cachedColor = 0;
+
+	for (int i = 0; i < width; i++) {
+		if (msk && !msk[i])
+			continue;
+
+		if (sizeof(T) == 1 && cached && src[i] == cachedSrc && dst[i] == cachedDst) {
+			dst[i] = cachedColor;
+			continue;
+		}
+
+		byte rSrc, gSrc, bSrc;
+		byte rDst, gDst, bDst;
+
+		if (sizeof(T) == 4) {
+			format.colorToRGB(src[i], rSrc, gSrc, bSrc);
+			format.colorToRGB(dst[i], rDst, gDst, bDst);
+		} else {
+			wm->decomposeColor<T>(src[i], rSrc, gSrc, bSrc);
+			wm->decomposeColor<T>(dst[i], rDst, gDst, bDst);
+		}
+
+		if (ink == kInkTypeAddPin) {
+			// Pin each channel at 0xff
+			rDst = MIN<int>(rDst + rSrc, 0xff);
+			gDst = MIN<int>(gDst + gSrc, 0xff);
+			bDst = MIN<int>(bDst + bSrc, 0xff);
+		} else {
+			// Let each channel wrap around
+			rDst += rSrc;
+			gDst += gSrc;
+			bDst += bSrc;
+		}
+
+		if (sizeof(T) == 4) {
+			dst[i] = format.RGBToColor(rDst, gDst, bDst);
+		} else {
+			cached = true;
+			cachedSrc = src[i];
+			cachedDst = dst[i];
+			cachedColor = wm->findBestColor(rDst, gDst, bDst);
+			dst[i] = cachedColor;
+		}
+	}
+}
+
+template <typename T>
+static InkBlitSpanPtr getInkBlitSpanFor(const DirectorPlotData *p) {
+	if (p->alpha)
+		return &inkBlitSpanBlend<T>;
+
+	const bool colored = p->oneBitImage || p->applyColor;
+
+	switch (p->ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeMask:
+	case kInkTypeBlend:
+		// All drawn the same, the mask has been dealt with already
+		return p->applyColor ? &inkBlitSpan<T, kInkTypeCopy> : &inkBlitSpanPlain<T, kInkTypeCopy>;
+	case kInkTypeBackgndTrans:
+		// The background color has to fit the pixel to be compared as one
+		if (p->oneBitImage || (T)p->backColor != p->backColor)
+			return &inkBlitSpan<T, kInkTypeBackgndTrans>;
+		return &inkBlitSpanPlain<T, kInkTypeBackgndTrans>;
+	case kInkTypeTransparent:
+		return colored ? &inkBlitSpan<T, kInkTypeTransparent> : &inkBlitSpanPlain<T, kInkTypeTransparent>;
+	case kInkTypeNotTrans:
+		return colored ? &inkBlitSpan<T, kInkTypeNotTrans> : &inkBlitSpanPlain<T, kInkTypeNotTrans>;
+	case kInkTypeReverse:
+		return &inkBlitSpanPlain<T, kInkTypeReverse>;
+	case kInkTypeNotReverse:
+		return &inkBlitSpanPlain<T, kInkTypeNotReverse>;
+	case kInkTypeGhost:
+		return colored ? &inkBlitSpan<T, kInkTypeGhost> : &inkBlitSpanPlain<T, kInkTypeGhost>;
+	case kInkTypeNotGhost:
+		return colored ? &inkBlitSpan<T, kInkTypeNotGhost> : &inkBlitSpanPlain<T, kInkTypeNotGhost>;
+	case kInkTypeNotCopy:
+		return &inkBlitSpan<T, kInkTypeNotCopy>;
+	case kInkTypeAddPin:
+		return &inkBlitSpanAdd<T, kInkTypeAddPin>;
+	case kInkTypeAdd:
+		return &inkBlitSpanAdd<T, kInkTypeAdd>;
+	case kInkTypeSubPin:
+		return &inkBlitSpan<T, kInkTypeSubPin>;
+	case kInkTypeLight:
+		return &inkBlitSpan<T, kInkTypeLight>;
+	case kInkTypeSub:
+		return &inkBlitSpan<T, kInkTypeSub>;
+	case kInkTypeDark:
+		return &inkBlitSpan<T, kInkTypeDark>;
+	default:
+		return nullptr;
+	}
+}
+
+InkBlitSpanPtr DirectorPlotData::getInkBlitSpan() {
+	if (d->_wm->_pixelformat.bytesPerPixel == 1)
+		return getInkBlitSpanFor<byte>(this);
+	else
+		return getInkBlitSpanFor<uint32>(this);
+}
+
 void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Surface *mask) {
 	if (!srf)
 		return;
@@ -710,6 +935,29 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 	// format as the window manager. Most of the time this is
 	// the job of BitmapCastMember::createWidget.
 
+	// Text sprites get their colors adjusted by preprocessColor(), so
+	// they keep going through the per-pixel path
+	InkBlitSpanPtr blitSpan = (sprite != kTextSprite && !ms) ? getInkBlitSpan() : nullptr;
+
+	if (blitSpan && debugChannelSet(-1, kDebugInkCheck))
+		inkBlitCheck(srcRect, mask, blitSpan, failedBoundsCheck);
+	else if (blitSpan)
+		inkBlitSpans(srcRect, mask, blitSpan, failedBoundsCheck);
+	else
+		inkBlitPixels(srcRect, mask, failedBoundsCheck);
+
+	if (failedBoundsCheck) {
+		warning("DirectorPlotData::inkBlitSurface: Out of bounds - srfClip: %d,%d,%d,%d, srcRect: %d,%d,%d,%d, dstRect: %d,%d,%d,%d",
+				srfClip.left, srfClip.top, srfClip.right, srfClip.bottom,
+				srcRect.left, srcRect.top, srcRect.right, srcRect.bottom,
+				destRect.left, destRect.top, destRect.right, destRect.bottom);
+	}
+
+}
+
+void DirectorPlotData::inkBlitPixels(Common::Rect &srcRect, const Graphics::Surface *mask, bool &failedBoundsCheck) {
+	Common::Rect srfClip = srf->getBounds();
+
 	srcPoint.y = abs(srcRect.top - destRect.top);
 	for (int i = 0; i < destRect.height(); i++, srcPoint.y++) {
 		srcPoint.x = abs(srcRect.left - destRect.left);
@@ -732,14 +980,68 @@ void DirectorPlotData::inkBlitSurface(Common::Rect &srcRect, const Graphics::Sur
 			}
 		}
 	}
+}
 
-	if (failedBoundsCheck) {
-		warning("DirectorPlotData::inkBlitSurface: Out of bounds - srfClip: %d,%d,%d,%d, srcRect: %d,%d,%d,%d, dstRect: %d,%d,%d,%d",
-				srfClip.left, srfClip.top, srfClip.right, srfClip.bottom,
-				srcRect.left, srcRect.top, srcRect.right, srcRect.bottom,
-				destRect.left, destRect.top, destRect.right, destRect.bottom);
+void DirectorPlotData::inkBlitSpans(Common::Rect &srcRect, const Graphics::Surface *mask, InkBlitSpanPtr blitSpan, bool &failedBoundsCheck) {
+	Common::Rect srfClip = srf->getBounds();
+	const int width = destRect.width();
+	const int srcX = abs(srcRect.left - destRect.left);
+	int srcY = abs(srcRect.top - destRect.top);
+
+	// Only the part of the row within the source is drawn, and the
+	// mask is read from its start, same as inkBlitPixels() does
+	const int start = CLIP<int>(srfClip.left - srcX, 0, width);
+	const int end = CLIP<int>(srfClip.right - srcX, start, width);
+
+	for (int i = 0; i < destRect.height(); i++, srcY++) {
+		if (srcY < srfClip.top || srcY >= srfClip.bottom) {
+			failedBoundsCheck |= (width > 0);
+			continue;
+		}
+
+		if (start > 0 || end < width)
+			failedBoundsCheck = true;
+
+		if (start == end)
+			continue;
+
+		const byte *msk = mask ? (const byte *)mask->getBasePtr(srcX, srcY) : nullptr;
+		blitSpan(dst->getBasePtr(destRect.left + start, destRect.top + i), srf->getBasePtr(srcX + start, srcY), msk, end - start, this);
+	}
+}
+
+void DirectorPlotData::inkBlitCheck(Common::Rect &srcRect, const Graphics::Surface *mask, InkBlitSpanPtr blitSpan, bool &failedBoundsCheck) {
+	// Draw the sprite with both paths, and compare the results
+	Common::Rect area(destRect);
+	area.clip(dst->getBounds());
+	if (area.isEmpty()) {
+		inkBlitSpans(srcRect, mask, blitSpan, failedBoundsCheck);
+		return;
+	}
+
+	Graphics::Surface before, expected;
+	before.create(area.width(), area.height(), dst->format);
+	before.copyRectToSurface(dst->rawSurface(), 0, 0, area);
+
+	inkBlitPixels(srcRect, mask, failedBoundsCheck);
+
+	expected.create(area.width(), area.height(), dst->format);
+	expected.copyRectToSurface(dst->rawSurface(), 0, 0, area);
+	dst->copyRectToSurface(before, area.left, area.top, Common::Rect(area.width(), area.height()));
+
+	inkBlitSpans(srcRect, mask, blitSpan, failedBoundsCheck);
+
+	for (int y = 0; y < area.height(); y++) {
+		if (memcmp(dst->getBasePtr(area.left, area.top + y), expected.getBasePtr(0, y), area.width() * dst->format.bytesPerPixel)) {
+			warning("DirectorPlotData::inkBlitCheck: Span blit of ink %d differs at row %d - alpha: %d, applyColor: %d, oneBitImage: %d, mask: %d, dstRect: %d,%d,%d,%d",
+					ink, area.top + y, alpha, applyColor, oneBitImage, mask != nullptr,
+					destRect.left, destRect.top, destRect.right, destRect.bottom);
+			break;
+		}
 	}
 
+	before.free();
+	expected.free();
 }
 
 } // End of namespace Director
@@ -244,6 +244,8 @@ void Lingo::initBuiltIns() {
 }
 
 void Lingo::initBuiltIns(BuiltinProto protos[]) {
+	invalidateCallSites();
+
 	for (BuiltinProto *blt = protos; blt->name; blt++) {
 		if (blt->version > _vm->getVersion())
 			continue;
@@ -281,12 +283,16 @@ void Lingo::initBuiltIns(BuiltinProto protos[]) {
 }
 
 void Lingo::cleanupBuiltIns() {
+	invalidateCallSites();
+
 	_builtinCmds.clear();
 	_builtinFuncs.clear();
 	_builtinConsts.clear();
 }
 
 void Lingo::cleanupBuiltIns(BuiltinProto protos[]) {
+	invalidateCallSites();
+
 	for (BuiltinProto *blt = protos; blt->name; blt++) {
 		switch (blt->type) {
 		case CBLTIN:
@@ -2032,6 +2038,7 @@ void LB::b_clearGlobals(int nargs) {
 			g_lingo->_globalvars.erase(it._key);
 		}
 	}
+	g_lingo->invalidateGlobalSlots();
 }
 
 void LB::b_cursor(int nargs) {
@@ -421,6 +421,7 @@ void LC::cb_hilite() {
 }
 
 void LC::cb_localcall() {
+	const inst *callSite = &(*g_lingo->_state->script)[g_lingo->_state->pc];
 	int functionId = g_lingo->readInt();
 
 	Datum nargs = g_lingo->pop();
@@ -429,7 +430,7 @@ void LC::cb_localcall() {
 		if (debugChannelSet(3, kDebugLingoExec))
 			g_lingo->printArgs(name.c_str(), nargs.u.i, "localcall:");
 
-		LC::call(name, nargs.u.i, nargs.type == ARGC);
+		LC::call(name, nargs.u.i, nargs.type == ARGC, callSite);
 
 	} else {
 		warning("cb_localcall: first arg should be of type ARGC or ARGCNORET, not %s", nargs.type2str());
@@ -536,11 +537,12 @@ void LC::cb_proplist() {
 
 
 void LC::cb_call() {
-	Common::String name = g_lingo->readString();
+	const char *callSite = g_lingo->readString();
+	Common::String name = callSite;
 
 	Datum nargs = g_lingo->pop();
 	if ((nargs.type == ARGC) || (nargs.type == ARGCNORET)) {
-		LC::call(name, nargs.u.i, nargs.type == ARGC);
+		LC::call(name, nargs.u.i, nargs.type == ARGC, callSite);
 
 	} else {
 		warning("cb_call: first arg should be of type ARGC or ARGCNORET, not %s", nargs.type2str());
@@ -550,22 +552,18 @@ void LC::cb_call() {
 
 
 void LC::cb_globalpush() {
-	Common::String name = g_lingo->readString();
-	Datum target(name);
-	target.type = GLOBALREF;
-	debugC(3, kDebugLingoExec, "cb_globalpush: pushing %s to stack", name.c_str());
-	Datum result = g_lingo->varFetch(target);
+	uint32 sym = g_lingo->readSymbol();
+	debugC(3, kDebugLingoExec, "cb_globalpush: pushing %s to stack", g_lingo->getSymbolName(sym).c_str());
+	Datum result = g_lingo->globalFetch(sym);
 	g_lingo->push(result);
 }
 
 
 void LC::cb_globalassign() {
-	Common::String name = g_lingo->readString();
-	Datum target(name);
-	target.type = GLOBALREF;
-	debugC(3, kDebugLingoExec, "cb_globalassign: assigning to %s", name.c_str());
+	uint32 sym = g_lingo->readSymbol();
+	debugC(3, kDebugLingoExec, "cb_globalassign: assigning to %s", g_lingo->getSymbolName(sym).c_str());
 	Datum source = g_lingo->pop();
-	g_lingo->varAssign(target, source);
+	g_lingo->getGlobal(sym) = source;
 }
 
 void LC::cb_objectfieldassign() {
@@ -590,16 +588,9 @@ void LC::cb_varrefpush() {
 
 void LC::cb_theassign() {
 	// cb_theassign is for setting script/factory-level properties
-	Common::String name = g_lingo->readString();
+	uint32 sym = g_lingo->readSymbol();
 	Datum value = g_lingo->pop();
-	if (g_lingo->_state->me.type == OBJECT) {
-		// Don't bother checking if the property is defined, leave that to the object.
-		// For D3-style anonymous objects/factories, you are allowed to define whatever properties you like.
-		g_debugger->propWriteHook(name);
-		g_lingo->_state->me.u.obj->setProp(name, value);
-	} else {
-		warning("cb_theassign: no me object");
-	}
+	g_lingo->propAssign(sym, value, true);
 }
 
 void LC::cb_theassign2() {
@@ -619,8 +610,15 @@ void LC::cb_theassign2() {
 }
 
 void LC::cb_thepush() {
-	Common::String name = g_lingo->readString();
+	uint32 sym = g_lingo->readSymbol();
+	Common::String name = g_lingo->getSymbolName(sym);
 	if (g_lingo->_state->me.type == OBJECT) {
+		Datum *prop = g_lingo->_state->me.u.obj->findOwnProp(sym);
+		if (prop) {
+			g_lingo->push(*prop);
+			g_debugger->propReadHook(name);
+			return;
+		}
 		if (g_lingo->_state->me.u.obj->hasProp(name)) {
 			g_lingo->push(g_lingo->_state->me.u.obj->getProp(name));
 			g_debugger->propReadHook(name);
@@ -1651,6 +1649,7 @@ ScriptContext *LingoCompiler::compileLingoV4(Common::SeekableReadStreamEndian &s
 				_assemblyArchive->functionHandlers[it._key] = it._value;
 			}
 		}
+		g_lingo->invalidateCallSites();
 	}
 
 	if (!skipdump && ConfMan.getBool("dump_scripts")) {
@@ -480,9 +480,9 @@ void LC::c_proparraypush() {
 }
 
 void LC::c_globalinit() {
-	Common::String name(g_lingo->readString());
-	if (!g_lingo->_globalvars.contains(name) || g_lingo->_globalvars[name].type == VOID) {
-		g_lingo->_globalvars[name] = Datum(0);
+	Datum &value = g_lingo->getGlobal(g_lingo->readSymbol());
+	if (value.type == VOID) {
+		value = Datum(0);
 	}
 }
 
@@ -521,9 +521,7 @@ void LC::c_varpush() {
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	g_lingo->push(g_lingo->globalFetch(g_lingo->readSymbol()));
 }
 
 void LC::c_localpush() {
@@ -533,9 +531,7 @@ void LC::c_localpush() {
 }
 
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	g_lingo->push(g_lingo->propFetch(g_lingo->readSymbol()));
 }
 
 void LC::c_stackpeek() {
@@ -1534,22 +1530,25 @@ void LC::c_telldone() {
 //************************
 
 void LC::c_callcmd() {
-	Common::String name(g_lingo->readString());
+	// The name is stored inline, its location identifies the call site
+	const char *callSite = g_lingo->readString();
+	Common::String name(callSite);
 
 	int nargs = g_lingo->readInt();
 
-	LC::call(name, nargs, false);
+	LC::call(name, nargs, false, callSite);
 }
 
 void LC::c_callfunc() {
-	Common::String name(g_lingo->readString());
+	const char *callSite = g_lingo->readString();
+	Common::String name(callSite);
 
 	int nargs = g_lingo->readInt();
 
-	LC::call(name, nargs, true);
+	LC::call(name, nargs, true, callSite);
 }
 
-void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
+void LC::call(const Common::String &name, int nargs, bool allowRetVal, const void *callSite) {
 	if (debugChannelSet(3, kDebugLingoExec))
 		g_lingo->printArgs(name.c_str(), nargs, "call:");
 
@@ -1614,37 +1613,28 @@ void LC::call(const Common::String &name, int nargs, bool allowRetVal) {
 		}
 	}
 
-	// Handler
-	funcSym = g_lingo->getHandler(name);
+	// Handler, or the builtin or 'the' entity it overrides. These only change
+	// along with the scripts, and are resolved once per call site.
+	// The call may change the cached call sites, copy what's needed.
+	const CallSite &site = g_lingo->resolveCall(name, allowRetVal, callSite);
+	funcSym = site.handler;
+	TheEntity *theEntity = site.theEntity;
 
-	if (g_lingo->_builtinListHandlers.contains(name) && nargs >= 1) {
+	if (site.listHandler.type != VOIDSYM && nargs >= 1) {
 		// Lingo builtin functions in the "List" category have very strange override mechanics.
 		// If the first argument is an ARRAY or PARRAY, it will use the builtin.
 		// Otherwise, it will fall back to whatever handler is defined globally.
 		Datum firstArg = g_lingo->peek(nargs - 1);
 		if (firstArg.type == ARRAY || firstArg.type == PARRAY ||
 				firstArg.type == POINT || firstArg.type == RECT) {
-			funcSym = g_lingo->_builtinListHandlers[name];
-		}
-	}
-
-	if (funcSym.type == VOIDSYM) { // The built-ins could be overridden
-		// Builtin
-		if (allowRetVal) {
-			if (g_lingo->_builtinFuncs.contains(name)) {
-				funcSym = g_lingo->_builtinFuncs[name];
-			}
-		} else {
-			if (g_lingo->_builtinCmds.contains(name)) {
-				funcSym = g_lingo->_builtinCmds[name];
-			}
+			funcSym = site.listHandler;
 		}
 	}
 
 	// use lingo-the as fallback. we can only use functions as fallback, not properties
-	if (funcSym.type == VOIDSYM && g_lingo->_theEntities.contains(name) && g_lingo->_theEntities[name]->isFunction) {
+	if (funcSym.type == VOIDSYM && theEntity) {
 		Datum id;
-		Datum res = g_lingo->getTheEntity(g_lingo->_theEntities[name]->entity, id, kTheNOField);
+		Datum res = g_lingo->getTheEntity(theEntity->entity, id, kTheNOField);
 		g_lingo->push(res);
 		return;
 	}
@@ -241,6 +241,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 		currentFunc.argNames = argNames;
 		currentFunc.varNames = varNames;
 		_assemblyContext->_functionHandlers[*currentFunc.name] = currentFunc;
+		_assemblyContext->_handlersVersion = g_lingo->newHandlersVersion();
 		_assemblyContext->_eventHandlers[kEventGeneric] = currentFunc;
 	} else {
 		delete _currentAssembly;
@@ -253,6 +254,7 @@ ScriptContext *LingoCompiler::compileLingo(const Common::U32String &code, LingoA
 				_assemblyArchive->functionHandlers[it._key] = it._value;
 			}
 		}
+		g_lingo->invalidateCallSites();
 	}
 
 	delete _methodVars;
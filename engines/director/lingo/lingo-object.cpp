@@ -436,6 +436,7 @@ void LM::m_dispose(int nargs) {
 ScriptContext::ScriptContext(Common::String name, ScriptType type, int id)
 	: Object<ScriptContext>(name), _scriptType(type), _id(id) {
 	_objType = kScriptObj;
+	_handlersVersion = g_lingo->newHandlersVersion();
 }
 
 ScriptContext::ScriptContext(const ScriptContext &sc) : Object<ScriptContext>(sc) {
@@ -445,6 +446,8 @@ ScriptContext::ScriptContext(const ScriptContext &sc) : Object<ScriptContext>(sc
 		_functionHandlers[it._key] = it._value;
 		_functionHandlers[it._key].ctx = this;
 	}
+	// The handlers are bound to the copy, so are the call sites resolved in it
+	_handlersVersion = g_lingo->newHandlersVersion();
 	for (auto &it : sc._eventHandlers) {
 		_eventHandlers[it._key] = it._value;
 		_eventHandlers[it._key].ctx = this;
@@ -483,6 +486,7 @@ Symbol ScriptContext::define(const Common::String &name, ScriptData *code, Commo
 	if (g_lingo->_eventHandlerTypeIds.contains(name)) {
 		_eventHandlers[g_lingo->_eventHandlerTypeIds[name]] = sym;
 	}
+	_handlersVersion = g_lingo->newHandlersVersion();
 
 	return sym;
 }
@@ -547,6 +551,24 @@ Datum ScriptContext::getProp(const Common::String &propName) {
 	return _properties[propName]; // return new property
 }
 
+Datum *ScriptContext::findOwnProp(uint32 sym) {
+	// Disposed objects are reported by hasProp()
+	if (_disposed)
+		return nullptr;
+
+	Common::HashMap<uint32, Datum *>::iterator slot = _propertySlots.find(sym);
+	if (slot != _propertySlots.end())
+		return slot->_value;
+
+	// Properties are never removed, so their values stay at the same place
+	DatumHash::iterator it = _properties.find(g_lingo->getSymbolName(sym));
+	if (it == _properties.end())
+		return nullptr;
+
+	_propertySlots[sym] = &it->_value;
+	return &it->_value;
+}
+
 Common::String ScriptContext::getPropAt(uint32 index) {
 	uint32 target = 1;
 	for (auto &it : _propertyNames) {
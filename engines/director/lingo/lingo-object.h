@@ -62,6 +62,7 @@ public:
 	virtual Common::String getPropAt(uint32 index) = 0;
 	virtual uint32 getPropCount() = 0;
 	virtual bool setProp(const Common::String &propName, const Datum &value, bool force = false) = 0;
+	virtual Datum *findOwnProp(uint32 sym) = 0;
 	virtual bool hasField(int field) = 0;
 	virtual Datum getField(int field) = 0;
 	virtual bool setField(int field, const Datum &value) = 0;
@@ -189,6 +190,9 @@ public:
 	bool setProp(const Common::String &propName, const Datum &value, bool force = false) override {
 		return false;
 	};
+	Datum *findOwnProp(uint32 sym) override {
+		return nullptr;
+	};
 	bool hasField(int field) override {
 		return false;
 	};
@@ -217,6 +221,7 @@ public:
 	Common::Array<Common::String> _functionNames; // used by cb_localcall
 	Common::HashMap<Common::String, Common::Array<uint32>> _functionByteOffsets;
 	SymbolHash _functionHandlers;
+	uint32 _handlersVersion;	// changed along with _functionHandlers, never reused
 	Common::HashMap<uint32, Symbol> _eventHandlers;
 	Common::Array<Datum> _constants;
 	Common::HashMap<uint32, Datum> _objArray;
@@ -226,6 +231,7 @@ public:
 private:
 	DatumHash _properties;
 	Common::Array<Common::String> _propertyNames;
+	Common::HashMap<uint32, Datum *> _propertySlots;	// values in _properties, by symbol
 	bool _onlyInLctxContexts = false;
 
 public:
@@ -246,6 +252,7 @@ public:
 	Common::String getPropAt(uint32 index) override;
 	uint32 getPropCount() override;
 	bool setProp(const Common::String &propName, const Datum &value, bool force = false) override;
+	Datum *findOwnProp(uint32 sym) override;
 
 	Symbol define(const Common::String &name, ScriptData *code, Common::Array<Common::String> *argNames, Common::Array<Common::String> *varNames);
 
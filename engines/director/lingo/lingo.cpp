@@ -175,6 +175,9 @@ Lingo::Lingo(DirectorEngine *vm) : _vm(vm) {
 	_state = nullptr;
 	_currentChannelId = -1;
 	_globalCounter = 0;
+	_callSitesGeneration = 0;
+	_handlerGeneration = 0;
+	_handlersVersionCounter = 0;
 	_freezeState = false;
 	_freezePlay = false;
 	_playDone = false;
@@ -247,6 +250,9 @@ void Lingo::reloadBuiltIns() {
 }
 
 LingoArchive::~LingoArchive() {
+	// The handlers of the cast are gone
+	g_lingo->invalidateCallSites();
+
 	// First cleanup the ScriptContexts that are only in LctxContexts.
 	// LctxContexts has a huge overlap with scriptContexts.
 	for (auto &it : lctxContexts){
@@ -335,8 +341,11 @@ Symbol Lingo::getHandler(const Common::String &name) {
 	Symbol sym;
 
 	// local functions
-	if (_state->context && _state->context->_functionHandlers.contains(name))
-		return _state->context->_functionHandlers[name];
+	if (_state->context) {
+		SymbolHash::iterator it = _state->context->_functionHandlers.find(name);
+		if (it != _state->context->_functionHandlers.end())
+			return it->_value;
+	}
 
 	sym = g_director->getCurrentMovie()->getHandler(name);
 	if (sym.type != VOIDSYM)
@@ -347,6 +356,107 @@ Symbol Lingo::getHandler(const Common::String &name) {
 	return sym;
 }
 
+const CallSite &Lingo::resolveCall(const Common::String &name, bool allowRetVal, const void *callSite) {
+	if (!callSite) {
+		resolveCallSite(name, allowRetVal, _uncachedCallSite);
+		return _uncachedCallSite;
+	}
+
+	// Drop all the call sites at once when the cast archives or builtins
+	// have changed, or when there are too many left by discarded code
+	if (_callSitesGeneration != _handlerGeneration || _callSites.size() >= kMaxCallSites) {
+		_callSites.clear();
+		_callSitesGeneration = _handlerGeneration;
+	}
+
+	const uint32 contextHandlers = _state->context ? _state->context->_handlersVersion : 0;
+	CallSiteHash::iterator it = _callSites.find(callSite);
+	if (it != _callSites.end() && it->_value.movie == g_director->getCurrentMovie() &&
+			it->_value.contextHandlers == contextHandlers && it->_value.allowRetVal == allowRetVal &&
+			it->_value.name == name)
+		return it->_value;
+
+	CallSite &site = _callSites[callSite];
+	resolveCallSite(name, allowRetVal, site);
+	return site;
+}
+
+void Lingo::resolveCallSite(const Common::String &name, bool allowRetVal, CallSite &site) {
+	site.name = name;
+	site.movie = g_director->getCurrentMovie();
+	site.contextHandlers = _state->context ? _state->context->_handlersVersion : 0;
+	site.allowRetVal = allowRetVal;
+
+	site.handler = getHandler(name);
+
+	SymbolHash::iterator it = _builtinListHandlers.find(name);
+	site.listHandler = (it != _builtinListHandlers.end()) ? it->_value : Symbol();
+
+	if (site.handler.type == VOIDSYM) { // The built-ins could be overridden
+		SymbolHash &builtins = allowRetVal ? _builtinFuncs : _builtinCmds;
+		it = builtins.find(name);
+		if (it != builtins.end())
+			site.handler = it->_value;
+	}
+
+	// use lingo-the as fallback. we can only use functions as fallback, not properties
+	site.theEntity = nullptr;
+	if (site.handler.type == VOIDSYM) {
+		TheEntityHash::iterator jt = _theEntities.find(name);
+		if (jt != _theEntities.end() && jt->_value->isFunction)
+			site.theEntity = jt->_value;
+	}
+}
+
+uint32 Lingo::internSymbol(const Common::String &name) {
+	SymbolIdHash::iterator it = _symbolIds.find(name);
+	if (it != _symbolIds.end())
+		return it->_value;
+
+	const uint32 sym = _symbolNames.size();
+	_symbolNames.push_back(name);
+	_symbolIds[name] = sym;
+	return sym;
+}
+
+uint32 Lingo::readSymbol() {
+	const char *name = readString();
+
+	// The code may have been replaced since, check the name
+	SymbolSiteHash::iterator it = _symbolSites.find(name);
+	if (it != _symbolSites.end() && _symbolNames[it->_value].equalsIgnoreCase(name))
+		return it->_value;
+
+	if (_symbolSites.size() >= kMaxCallSites)
+		_symbolSites.clear();
+
+	const uint32 sym = internSymbol(name);
+	_symbolSites[name] = sym;
+	return sym;
+}
+
+Datum *Lingo::findGlobal(uint32 sym) {
+	if (sym < _globalSlots.size() && _globalSlots[sym])
+		return _globalSlots[sym];
+
+	DatumHash::iterator it = _globalvars.find(_symbolNames[sym]);
+	if (it == _globalvars.end())
+		return nullptr;
+
+	if (sym >= _globalSlots.size())
+		_globalSlots.resize(MAX<uint>(_symbolNames.size(), _globalSlots.size() * 2));
+	_globalSlots[sym] = &it->_value;
+	return &it->_value;
+}
+
+Datum &Lingo::getGlobal(uint32 sym) {
+	Datum *value = findGlobal(sym);
+	if (value)
+		return *value;
+
+	_globalvars[_symbolNames[sym]] = Datum();
+	return *findGlobal(sym);
+}
 
 void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uint16 id, const char *scriptName, uint32 preprocFlags) {
 	debugC(1, kDebugCompile, "Patching code for type %s(%d) with id %d in '%s%s'\n"
@@ -370,6 +480,9 @@ void LingoArchive::patchCode(const Common::U32String &code, ScriptType type, uin
 		}
 		sc->_functionHandlers.clear();
 		delete sc;
+
+		scriptContexts[type][id]->_handlersVersion = g_lingo->newHandlersVersion();
+		g_lingo->invalidateCallSites();
 	}
 }
 
@@ -1653,15 +1766,7 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		}
 		break;
 	case PROPREF:
-		{
-			Common::String name = *var.u.s;
-			if (_state->me.type == OBJECT && _state->me.u.obj->hasProp(name)) {
-				_state->me.u.obj->setProp(name, value);
-				g_debugger->varWriteHook(name);
-			} else {
-				warning("varAssign: property %s not defined", name.c_str());
-			}
-		}
+		propAssign(internSymbol(*var.u.s), value);
 		break;
 	case FIELDREF:
 	case CASTREF:
@@ -1803,6 +1908,63 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	return result;
 }
 
+// Same as varFetch() for GLOBALREF and PROPREF, with the name interned by
+// readSymbol()
+Datum Lingo::globalFetch(uint32 sym) {
+	Common::String name = _symbolNames[sym];
+	g_debugger->varReadHook(name);
+	Datum *value = findGlobal(sym);
+	if (value)
+		return *value;
+
+	debugC(1, kDebugLingoExec, "varFetch: global variable %s not defined", name.c_str());
+	return Datum();
+}
+
+Datum Lingo::propFetch(uint32 sym) {
+	Common::String name = _symbolNames[sym];
+	g_debugger->varReadHook(name);
+	if (_state->me.type == OBJECT) {
+		AbstractObject *obj = _state->me.u.obj;
+		Datum *value = obj->findOwnProp(sym);
+		if (value)
+			return *value;
+		if (obj->hasProp(name))
+			return obj->getProp(name);
+	}
+
+	warning("varFetch: property %s not defined", name.c_str());
+	return Datum();
+}
+
+// Property assignment for PROPREF references and cb_theassign. With define
+// set, the me object is allowed to create the property.
+void Lingo::propAssign(uint32 sym, const Datum &value, bool define) {
+	Common::String name = _symbolNames[sym];
+	if (_state->me.type != OBJECT) {
+		warning("propAssign: no me object for property %s", name.c_str());
+		return;
+	}
+
+	AbstractObject *obj = _state->me.u.obj;
+	Datum *prop = obj->findOwnProp(sym);
+	if (prop) {
+		*prop = value;
+	} else if (define || obj->hasProp(name)) {
+		// For D3-style anonymous objects/factories, the object decides which
+		// properties may be defined, so don't check them here.
+		obj->setProp(name, value);
+	} else {
+		warning("propAssign: property %s not defined", name.c_str());
+		return;
+	}
+
+	if (define)
+		g_debugger->propWriteHook(name);
+	else
+		g_debugger->varWriteHook(name);
+}
+
 Common::U32String Lingo::evalChunkRef(const Datum &var) {
 	Common::U32String result;
 
@@ -47,6 +47,7 @@ class ScriptContext;
 class DirectorEngine;
 class Frame;
 class LingoCompiler;
+class Movie;
 struct Breakpoint;
 
 typedef void (*inst)(void);
@@ -322,6 +323,20 @@ struct LingoArchive {
 	void patchScriptHandler(ScriptType type, CastMemberID id);
 };
 
+struct CallSite {	/* handler resolved by a call, cached per call site */
+	Common::String	name;				/* name called, in case the code was replaced */
+	Movie			*movie;				/* movie the call was resolved in */
+	uint32			contextHandlers;	/* _handlersVersion of the script context, 0 for none */
+	bool			allowRetVal;
+	Symbol			handler;			/* handler, or the builtin if there is none */
+	Symbol			listHandler;		/* builtin overriding it for list arguments */
+	TheEntity		*theEntity;			/* 'the' entity called as a function if both are void */
+};
+
+typedef Common::HashMap<const void *, CallSite> CallSiteHash;
+typedef Common::HashMap<const void *, uint32> SymbolSiteHash;
+typedef Common::HashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SymbolIdHash;
+
 struct LingoState {
 	// Execution state for a Lingo process, created every time
 	// a top-level handler is called (e.g. on mouseDown).
@@ -396,11 +411,25 @@ public:
 	// lingo-events.cpp
 private:
 	void initEventHandlerTypes();
+	void resolveCallSite(const Common::String &name, bool allowRetVal, CallSite &site);
 	bool processEvent(LEvent event, ScriptType st, CastMemberID scriptId, int channelId = -1);
 
 public:
 	ScriptType event2script(LEvent ev);
 	Symbol getHandler(const Common::String &name);
+	const CallSite &resolveCall(const Common::String &name, bool allowRetVal, const void *callSite);
+	void invalidateCallSites() { _handlerGeneration++; }
+	uint32 newHandlersVersion() { return ++_handlersVersionCounter; }
+
+	uint32 internSymbol(const Common::String &name);
+	uint32 readSymbol();
+	const Common::String &getSymbolName(uint32 sym) const { return _symbolNames[sym]; }
+	Datum *findGlobal(uint32 sym);
+	Datum &getGlobal(uint32 sym);
+	void invalidateGlobalSlots() { _globalSlots.clear(); }
+	Datum globalFetch(uint32 sym);
+	Datum propFetch(uint32 sym);
+	void propAssign(uint32 sym, const Datum &value, bool define = false);
 
 	void processEvents(Common::Queue<LingoEvent> &queue, bool isInputEvent);
 
@@ -537,7 +566,7 @@ public:
 	Common::HashMap<Common::String, uint32, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _eventHandlerTypeIds;
 	Common::HashMap<Common::String, Audio::AudioStream *> _audioAliases;
 
-	DatumHash _globalvars;
+	DatumHash _globalvars;	// call invalidateGlobalSlots() when erasing from it
 
 	FuncHash _functions;
 
@@ -561,6 +590,27 @@ public:
 	Datum _windowList;
 	Symbol _currentInputEvent;
 
+	enum {
+		kMaxCallSites = 4096	// Number of cached call sites before they are dropped
+	};
+
+	// Handlers resolved by the calls, keyed by their location in the
+	// script. Changes to the cast archives or builtins bump the generation,
+	// changes to a script context its _handlersVersion.
+	CallSiteHash _callSites;
+	CallSite _uncachedCallSite;
+	uint32 _callSitesGeneration;
+	uint32 _handlerGeneration;
+	uint32 _handlersVersionCounter;
+
+	// Names of globals and properties, interned to integer symbols. The
+	// scripts keep their names inline, the symbol of each name read from
+	// a script is kept in a side table keyed by its location.
+	SymbolIdHash _symbolIds;
+	Common::Array<Common::String> _symbolNames;
+	SymbolSiteHash _symbolSites;
+	Common::Array<Datum *> _globalSlots;	// values in _globalvars, by symbol
+
 	struct {
 		LingoExecState _state = kRunning;
 		bool (*_shouldPause)() = nullptr;
@@ -128,6 +128,7 @@ void callPacoPlay(const Common::String &cmd) {
 		Graphics::Surface const *frame = nullptr;
 		Common::Event event;
 		bool keepPlaying = true;
+		video->setLookAhead(4);
 		video->start();
 		memcpy(videoPalette, video->getPalette(), 256 * 3);
 		while (!video->endOfVideo()) {
@@ -162,6 +163,9 @@ void callPacoPlay(const Common::String &cmd) {
 				g_system->copyRectToScreen(dither->getPixels(), dither->pitch, posX, posY, width, height);
 				dither->free();
 				delete dither;
+			} else {
+				// Use the wait for the next frame to decode ahead
+				video->decodeAhead();
 			}
 			g_system->updateScreen();
 			g_director->delayMillis(10);
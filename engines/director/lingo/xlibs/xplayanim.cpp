@@ -82,6 +82,7 @@ void XPlayAnim::b_xplayanim(int nargs) {
 	Graphics::Surface const *frame = nullptr;
 	Common::Event event;
 	bool keepPlaying = true;
+	video->setLookAhead(4);
 	video->start();
 	while (!video->endOfVideo()) {
 		if (g_director->pollEvent(event)) {
@@ -103,6 +104,9 @@ void XPlayAnim::b_xplayanim(int nargs) {
 		if (video->needsUpdate()) {
 			frame = video->decodeNextFrame();
 			g_system->copyRectToScreen(frame->getPixels(), frame->pitch, x, y, frame->w, frame->h);
+		} else {
+			// Use the wait for the next frame to decode ahead
+			video->decodeAhead();
 		}
 		if (video->hasDirtyPalette()) {
 			byte *palette = const_cast<byte *>(video->getPalette());
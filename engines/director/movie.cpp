@@ -618,12 +618,16 @@ ScriptContext *Movie::getScriptContext(ScriptType type, CastMemberID id) {
 
 Symbol Movie::getHandler(const Common::String &name) {
 	for (auto &it : _casts) {
-		if (it._value->_lingoArchive->functionHandlers.contains(name))
-			return it._value->_lingoArchive->functionHandlers[name];
+		SymbolHash::iterator jt = it._value->_lingoArchive->functionHandlers.find(name);
+		if (jt != it._value->_lingoArchive->functionHandlers.end())
+			return jt->_value;
 	}
 
-	if (_sharedCast && _sharedCast->_lingoArchive->functionHandlers.contains(name))
-		return _sharedCast->_lingoArchive->functionHandlers[name];
+	if (_sharedCast) {
+		SymbolHash::iterator jt = _sharedCast->_lingoArchive->functionHandlers.find(name);
+		if (jt != _sharedCast->_lingoArchive->functionHandlers.end())
+			return jt->_value;
+	}
 
 	return Symbol();
 }
@@ -25,6 +25,7 @@
 #include "common/file.h"
 #include "common/rational.h"
 #include "common/memstream.h"
+#include "common/profiler.h"
 #include "common/punycode.h"
 #include "common/substream.h"
 
@@ -702,6 +703,8 @@ void Score::update() {
 }
 
 void Score::renderFrame(uint16 frameId, RenderMode mode) {
+	PROFILE_ZONE("Director::Score::renderFrame");
+
 	uint32 start = g_system->getMillis(false);
 	// Force cursor update if a new movie's started.
 	if (_window->_newMovieStarted)
@@ -802,8 +805,15 @@ void Score::updateSprites(RenderMode mode) {
 
 		if (channel->isDirty(nextSprite) || widgetRedrawn || mode == kRenderForceUpdate) {
 			bool invalidCastMember = currentSprite && currentSprite->_spriteType == kCastMemberSprite && currentSprite->_cast == nullptr;
-			if (currentSprite && !invalidCastMember && !currentSprite->_trails)
-				_window->addDirtyRect(channel->getBbox());
+			bool erasePrevious = currentSprite && !invalidCastMember && !currentSprite->_trails;
+			Common::Rect previousBbox = channel->getBbox();
+
+			// The channel is often flagged dirty without anything visible
+			// changing, e.g. when a puppet sprite is set to where it already is.
+			// Changes to the cast member itself don't show in the render state.
+			bool contentChanged = widgetRedrawn || mode == kRenderForceUpdate ||
+				(currentSprite && currentSprite->_cast && currentSprite->_cast->isModified()) ||
+				(nextSprite && nextSprite->_cast && nextSprite->_cast->isModified());
 
 			if (currentSprite && currentSprite->_cast && currentSprite->_cast->_erase) {
 				_movie->eraseCastMember(currentSprite->_castId);
@@ -811,6 +821,7 @@ void Score::updateSprites(RenderMode mode) {
 
 				currentSprite->setCast(currentSprite->_castId);
 				nextSprite->setCast(nextSprite->_castId);
+				contentChanged = true;
 			}
 
 			channel->setClean(nextSprite);
@@ -819,8 +830,18 @@ void Score::updateSprites(RenderMode mode) {
 			if (channel->isActiveVideo())
 				_movie->_videoPlayback = true;
 
-			if (!invalidCastMember)
-				_window->addDirtyRect(channel->getBbox());
+			ChannelRenderState renderState = channel->getRenderState();
+			if (!contentChanged && channel->_renderStateValid && renderState == channel->_renderState) {
+				debugC(6, kDebugImages, "Score::updateSprites(): CH: %-3d: Unchanged, skipping redraw", i);
+			} else {
+				if (erasePrevious)
+					_window->addDirtyRect(previousBbox);
+
+				if (!invalidCastMember)
+					_window->addDirtyRect(channel->getBbox());
+			}
+			channel->_renderState = renderState;
+			channel->_renderStateValid = !invalidCastMember;
 
 			if (currentSprite) {
 				Common::Rect bbox = channel->getBbox();
@@ -836,6 +857,10 @@ void Score::updateSprites(RenderMode mode) {
 			}
 		} else {
 			channel->setClean(nextSprite, true);
+
+			// Not redrawn, so the retained state no longer tells what is on the stage
+			if (channel->_renderStateValid && channel->getRenderState() != channel->_renderState)
+				channel->_renderStateValid = false;
 		}
 
 		// update editable text channel after we render the sprites. because for the current frame, we may get those sprites only when we finished rendering
@@ -24,6 +24,7 @@
 #include "common/compression/deflate.h"
 
 #include "common/memstream.h"
+#include "common/random.h"
 #include "common/macresman.h"
 #include "common/formats/cue.h"
 
@@ -205,6 +206,113 @@ Common::HashMap<Common::String, Movie *> *Window::scanMovies(const Common::Path
 	return nameMap;
 }
 
+// Draws synthetic sprites with every ink which has a span blitter, once
+// pixel by pixel and once through the span blitter, and checks that both
+// give the same result
+void Window::testInkBlitters() {
+	_vm->setPalette(CastMemberID(kClutSystemMac, -1));
+
+	const Graphics::PixelFormat origFormat = _wm->_pixelformat;
+
+	testInkBlitters(Graphics::PixelFormat::createFormatCLUT8());
+	testInkBlitters(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+
+	_wm->_pixelformat = origFormat;
+	_vm->_pixelformat = origFormat;
+}
+
+void Window::testInkBlitters(const Graphics::PixelFormat &format) {
+	// Both the engine and the window manager pick the pixel size from their format
+	_wm->_pixelformat = format;
+	_vm->_pixelformat = format;
+
+	Common::RandomSource rnd("directorinktest");
+	const int w = 37, h = 7;
+
+	// A few colors appear over and over, so that the inks comparing
+	// them and the runs of pixels are exercised
+	uint32 colors[8];
+	for (uint i = 0; i < ARRAYSIZE(colors); i++)
+		colors[i] = format.bytesPerPixel == 1 ? rnd.getRandomNumber(255) : format.RGBToColor(rnd.getRandomNumber(255), rnd.getRandomNumber(255), rnd.getRandomNumber(255));
+	colors[0] = format.bytesPerPixel == 1 ? 0x00 : format.RGBToColor(0x00, 0x00, 0x00);
+	colors[1] = format.bytesPerPixel == 1 ? 0xff : format.RGBToColor(0xff, 0xff, 0xff);
+	const uint32 backColor = colors[2];
+	const uint32 foreColor = colors[3];
+
+	Graphics::ManagedSurface src, before, expected, result;
+	Graphics::Surface mask;
+	src.create(w, h, format);
+	before.create(w + 8, h + 4, format);
+	expected.create(w + 8, h + 4, format);
+	result.create(w + 8, h + 4, format);
+	mask.create(w, h, Graphics::PixelFormat::createFormatCLUT8());
+
+	for (int y = 0; y < h; y++) {
+		for (int x = 0; x < w; x++) {
+			src.setPixel(x, y, rnd.getRandomBit() ? colors[rnd.getRandomNumber(ARRAYSIZE(colors) - 1)] : rnd.getRandomNumber(0xffffffff));
+			*(byte *)mask.getBasePtr(x, y) = rnd.getRandomBit();
+		}
+	}
+	for (int y = 0; y < before.h; y++)
+		for (int x = 0; x < before.w; x++)
+			before.setPixel(x, y, rnd.getRandomBit() ? colors[rnd.getRandomNumber(ARRAYSIZE(colors) - 1)] : rnd.getRandomNumber(0xffffffff));
+
+	// The sprite within the source, and hanging over its right edge
+	const Common::Rect destRects[] = { Common::Rect(3, 2, 3 + w, 2 + h), Common::Rect(5, 1, 5 + w + 3, 1 + h) };
+	const InkType inks[] = {
+		kInkTypeCopy, kInkTypeTransparent, kInkTypeReverse, kInkTypeGhost, kInkTypeNotCopy,
+		kInkTypeNotTrans, kInkTypeNotReverse, kInkTypeNotGhost, kInkTypeMatte, kInkTypeMask,
+		kInkTypeBlend, kInkTypeAddPin, kInkTypeAdd, kInkTypeSubPin, kInkTypeBackgndTrans,
+		kInkTypeLight, kInkTypeSub, kInkTypeDark
+	};
+
+	int checks = 0;
+	for (uint i = 0; i < ARRAYSIZE(inks); i++) {
+		for (int config = 0; config < 32; config++) {
+			DirectorPlotData pd(_vm, kBitmapSprite, inks[i], (config & 1) ? 0x80 : 0, backColor, foreColor);
+			pd.applyColor = (config & 2) != 0;
+			pd.oneBitImage = (config & 4) != 0;
+			pd.srf = &src;
+			pd.destRect = destRects[(config >> 3) & 1];
+			const Graphics::Surface *msk = (config & 16) ? &mask : nullptr;
+			Common::Rect srcRect(pd.destRect);
+
+			InkBlitSpanPtr blitSpan = pd.getInkBlitSpan();
+			if (!blitSpan)
+				continue;
+
+			bool failedBoundsCheck = false;
+			expected.copyRectToSurface(before.rawSurface(), 0, 0, Common::Rect(before.w, before.h));
+			pd.dst = &expected;
+			pd.inkBlitPixels(srcRect, msk, failedBoundsCheck);
+
+			bool spanFailedBoundsCheck = false;
+			result.copyRectToSurface(before.rawSurface(), 0, 0, Common::Rect(before.w, before.h));
+			pd.dst = &result;
+			pd.inkBlitSpans(srcRect, msk, blitSpan, spanFailedBoundsCheck);
+
+			for (int y = 0; y < result.h; y++) {
+				if (memcmp(result.getBasePtr(0, y), expected.getBasePtr(0, y), result.w * format.bytesPerPixel))
+					error("Window::testInkBlitters(): %dbpp span blit of ink %d differs at row %d - alpha: %d, applyColor: %d, oneBitImage: %d, mask: %d, dstRect: %d,%d,%d,%d",
+						format.bytesPerPixel * 8, inks[i], y, pd.alpha, pd.applyColor, pd.oneBitImage, msk != nullptr,
+						pd.destRect.left, pd.destRect.top, pd.destRect.right, pd.destRect.bottom);
+			}
+			if (failedBoundsCheck != spanFailedBoundsCheck)
+				error("Window::testInkBlitters(): %dbpp span blit of ink %d reports out of bounds as %d instead of %d",
+					format.bytesPerPixel * 8, inks[i], spanFailedBoundsCheck, failedBoundsCheck);
+			checks++;
+		}
+	}
+
+	debug("Window::testInkBlitters(): %dbpp, %d span blits match", format.bytesPerPixel * 8, checks);
+
+	src.free();
+	before.free();
+	expected.free();
+	result.free();
+	mask.free();
+}
+
 void Window::enqueueAllMovies() {
 	Common::FSNode dir(ConfMan.getPath("path"));
 	Common::FSList files;
@@ -338,6 +446,8 @@ void Window::runTests() {
 		testFonts();
 	}
 
+	testInkBlitters();
+
 	g_lingo->runTests();
 }
 
@@ -23,6 +23,7 @@
 #include "common/file.h"
 #include "common/system.h"
 #include "common/macresman.h"
+#include "common/profiler.h"
 
 #include "graphics/macgui/macwindowmanager.h"
 
@@ -168,6 +169,8 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		const Common::Rect &r = i;
 		_dirtyChannels = _currentMovie->getScore()->getSpriteIntersections(r);
 
+		debugC(7, kDebugImages, "Window::render(): Redrawing %d,%d,%d,%d, %d channels", PRINT_RECT(r), _dirtyChannels.size());
+
 		bool shouldClear = true;
 		for (auto &j : _dirtyChannels) {
 			if (j->_visible && r == j->getBbox() && j->isTrail()) {
@@ -205,6 +208,11 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		}
 	}
 
+	if (g_director->_debugDraw & kDebugDrawDirty) {
+		for (auto &i : _dirtyRects)
+			blitTo->frameRect(i, _wm->_colorWhite);
+	}
+
 	if (g_director->_debugDraw & kDebugDrawCast) {
 		const Graphics::Font *font = FontMan.getFontByUsage(Graphics::FontManager::kConsoleFont);
 
@@ -497,6 +505,8 @@ bool Window::loadNextMovie() {
 }
 
 bool Window::step() {
+	PROFILE_ZONE("Director::Window::step");
+
 	// finish last movie
 	if (_currentMovie && _currentMovie->getScore()->_playState == kPlayStopped) {
 		debugC(5, kDebugEvents, "\n@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@");
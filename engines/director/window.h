@@ -174,6 +174,8 @@ public:
 	Common::HashMap<Common::String, Movie *> *scanMovies(const Common::Path &folder);
 	void testFontScaling();
 	void testFonts();
+	void testInkBlitters();
+	void testInkBlitters(const Graphics::PixelFormat &format);
 	void enqueueAllMovies();
 	MovieReference getNextMovieFromQueue();
 	void runTests();
@@ -89,6 +89,16 @@ void MusicPlayer::playSMF(int track, bool loop) {
 	musicFile.read(_midiData, midiMusicSize);
 	musicFile.close();
 
+	_isLooping = loop;
+	syncVolume();
+
+	// Tracks which have been rendered before are streamed from the cache
+	if (playCachedTrack(_midiData, midiMusicSize)) {
+		_track = track;
+		debugC(2, kDraciSoundDebugLevel, "Playing track %d from the render cache", track);
+		return;
+	}
+
 	MidiParser *parser = MidiParser::createParser_SMF();
 	if (parser->loadMusic(_midiData, midiMusicSize)) {
 		parser->setTrack(0);
@@ -98,9 +108,6 @@ void MusicPlayer::playSMF(int track, bool loop) {
 
 		_parser = parser;
 
-		syncVolume();
-
-		_isLooping = loop;
 		_isPlaying = true;
 		_track = track;
 		debugC(2, kDraciSoundDebugLevel, "Playing track %d", track);
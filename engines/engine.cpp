@@ -33,6 +33,7 @@
 #include "common/error.h"
 #include "common/list.h"
 #include "common/memstream.h"
+#include "common/profiler.h"
 #include "common/savefile.h"
 #include "common/scummsys.h"
 #include "common/taskbar.h"
@@ -807,6 +808,8 @@ void Engine::setTotalPlayTime(uint32 time) {
 }
 
 int Engine::runDialog(GUI::Dialog &dialog) {
+	PROFILE_ZONE("Engine::runDialog");
+
 	PauseToken pt = pauseEngine();
 	int result = dialog.runModal();
 
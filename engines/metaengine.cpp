@@ -26,6 +26,7 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/memstream.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -380,18 +381,46 @@ SaveStateList MetaEngine::listSaves(const char *target) const {
 		int slotNum = atoi(slotStr);
 
 		if (slotNum >= 0 && slotNum <= getMaximumSaveSlot()) {
-			SaveStateDescriptor desc = querySaveMetaInfos(target, slotNum);
+			SaveStateDescriptor desc;
+
+			// Use the metadata index when possible, and only parse the
+			// save file when it has not been indexed yet.
+			if (!loadIndexedSaveMetaInfos(*file, desc) || desc.getSaveSlot() != slotNum) {
+				desc = querySaveMetaInfos(target, slotNum);
+				if (desc.getSaveSlot() != -1)
+					indexSaveMetaInfos(*file, desc);
+			}
+
 			if (desc.getSaveSlot() != -1) {
 				saveList.push_back(desc);
 			}
 		}
 	}
 
+	saveFileMan->flushSavefileMetadata();
+
 	// Sort saves based on slot number.
 	Common::sort(saveList.begin(), saveList.end(), SaveStateDescriptorSlotComparator());
 	return saveList;
 }
 
+bool MetaEngine::loadIndexedSaveMetaInfos(const Common::String &filename, SaveStateDescriptor &desc) const {
+	Common::Array<byte> metadata;
+	if (!g_system->getSavefileManager()->getSavefileMetadata(filename, metadata))
+		return false;
+
+	Common::MemoryReadStream stream(metadata.data(), metadata.size());
+	return desc.loadMetadata(stream);
+}
+
+void MetaEngine::indexSaveMetaInfos(const Common::String &filename, const SaveStateDescriptor &desc) const {
+	Common::MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
+	desc.saveMetadata(stream);
+
+	Common::Array<byte> metadata(stream.getData(), stream.size());
+	g_system->getSavefileManager()->setSavefileMetadata(filename, metadata);
+}
+
 SaveStateList MetaEngine::listSaves(const char *target, bool saveMode) const {
 	SaveStateList saveList = listSaves(target);
 	int autosaveSlot = getAutosaveSlot();
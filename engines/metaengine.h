@@ -204,6 +204,19 @@ protected:
 	 */
 	int findEmptySaveSlot(const char *target);
 
+	/**
+	 * Read the descriptor of a save file from the save metadata index.
+	 *
+	 * @return True if the save file was indexed and its entry could be read.
+	 */
+	bool loadIndexedSaveMetaInfos(const Common::String &filename, SaveStateDescriptor &desc) const;
+
+	/**
+	 * Store the descriptor of a save file in the save metadata index, so that
+	 * later calls to listSaves() do not have to open the save file again.
+	 */
+	void indexSaveMetaInfos(const Common::String &filename, const SaveStateDescriptor &desc) const;
+
 	/**
 	 * Return a list of extra GUI options for the specified target.
 	 *
@@ -24,6 +24,7 @@
 #include "engines/metaengine.h"
 #include "graphics/surface.h"
 #include "common/config-manager.h"
+#include "common/stream.h"
 #include "common/textconsole.h"
 #include "common/translation.h"
 
@@ -111,3 +112,45 @@ bool SaveStateDescriptor::isValid() const
 {
 	return _slot >= 0 && !_description.empty();
 }
+
+#define SAVESTATE_METADATA_VERSION 1
+
+void SaveStateDescriptor::saveMetadata(Common::WriteStream &stream) const {
+	Common::String description = _description.encode();
+
+	stream.writeByte(SAVESTATE_METADATA_VERSION);
+	stream.writeSint32LE(_slot);
+	stream.writeUint16LE(description.size());
+	stream.writeString(description);
+	stream.writeByte(_isDeletable);
+	stream.writeByte(_isWriteProtected);
+	stream.writeByte(_isLocked);
+	stream.writeByte(_saveType);
+	stream.writeByte(_saveDate.size());
+	stream.writeString(_saveDate);
+	stream.writeByte(_saveTime.size());
+	stream.writeString(_saveTime);
+	stream.writeByte(_playTime.size());
+	stream.writeString(_playTime);
+	stream.writeUint32LE(_playTimeMSecs);
+}
+
+bool SaveStateDescriptor::loadMetadata(Common::ReadStream &stream) {
+	if (stream.readByte() != SAVESTATE_METADATA_VERSION)
+		return false;
+
+	_slot = stream.readSint32LE();
+	uint16 descriptionSize = stream.readUint16LE();
+	_description = stream.readString(0, descriptionSize).decode();
+	_isDeletable = stream.readByte() != 0;
+	_isWriteProtected = stream.readByte() != 0;
+	_isLocked = stream.readByte() != 0;
+	_saveType = (SaveType)stream.readByte();
+	_saveDate = stream.readPascalString();
+	_saveTime = stream.readPascalString();
+	_playTime = stream.readPascalString();
+	_playTimeMSecs = stream.readUint32LE();
+	_thumbnail.reset();
+
+	return !stream.err() && !stream.eos();
+}
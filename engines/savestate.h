@@ -29,6 +29,11 @@
 
 class MetaEngine;
 
+namespace Common {
+class ReadStream;
+class WriteStream;
+}
+
 namespace Graphics {
 struct Surface;
 }
@@ -225,6 +230,19 @@ public:
 	 * Returns true if this entry is valid
 	 */
 	bool isValid() const;
+
+	/**
+	 * Write everything but the thumbnail to a stream, for use in the
+	 * save file metadata index.
+	 */
+	void saveMetadata(Common::WriteStream &stream) const;
+
+	/**
+	 * Restore the data written by saveMetadata().
+	 *
+	 * @return true on success, false if the data is invalid
+	 */
+	bool loadMetadata(Common::ReadStream &stream);
 private:
 	/**
 	 * The saveslot id, as it would be passed to the "-x" command line switch.
@@ -68,6 +68,7 @@
 #include "engines/wintermute/platform_osystem.h"
 
 #include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/str.h"
 
 namespace Wintermute {
@@ -2056,6 +2057,8 @@ bool AdGame::resetResponse(int id) {
 
 //////////////////////////////////////////////////////////////////////////
 bool AdGame::displayContent(bool doUpdate, bool displayAll) {
+	PROFILE_ZONE("Wintermute::AdGame::displayContent");
+
 	// init
 	if (doUpdate) {
 		initLoop();
@@ -99,6 +99,7 @@ void AdScene::setDefaults() {
 	_sceneGeometry = nullptr;
 #endif
 	_pfPointsNum = 0;
+	_pfOpenValid = false;
 	_persistentState = false;
 	_persistentStateSprites = true;
 
@@ -214,6 +215,10 @@ void AdScene::cleanup() {
 	}
 	_pfPath.clear();
 	_pfPointsNum = 0;
+	_pfOpen.clear();
+	_pfOpenValid = false;
+	_pfSceneDist.clear();
+	_pfRegionState.clear();
 
 	for (uint32 i = 0; i < _objects.size(); i++) {
 		_gameRef->unregisterObject(_objects[i]);
@@ -299,6 +304,9 @@ bool AdScene::getPath(const BasePoint &source, const BasePoint &target, AdPath *
 			}
 		}
 
+		pfOpenRebuild();
+		pfUpdateSceneDist();
+
 		return true;
 	}
 }
@@ -376,26 +384,37 @@ uint32 AdScene::getAlphaAt(int x, int y, bool colorCheck) {
 
 //////////////////////////////////////////////////////////////////////////
 bool AdScene::isBlockedAt(int x, int y, bool checkFreeObjects, BaseObject *requester) {
-	bool ret = true;
+	if (checkFreeObjects && isBlockedByObjectsAt(x, y, requester)) {
+		return true;
+	}
+	return isBlockedBySceneAt(x, y);
+}
 
-	if (checkFreeObjects) {
-		for (uint32 i = 0; i < _objects.size(); i++) {
-			if (_objects[i]->_active && _objects[i] != requester && _objects[i]->_currentBlockRegion) {
-				if (_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
-					return true;
-				}
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isBlockedByObjectsAt(int x, int y, BaseObject *requester) {
+	for (uint32 i = 0; i < _objects.size(); i++) {
+		if (_objects[i]->_active && _objects[i] != requester && _objects[i]->_currentBlockRegion) {
+			if (_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
+				return true;
 			}
 		}
-		AdGame *adGame = (AdGame *)_gameRef;
-		for (uint32 i = 0; i < adGame->_objects.size(); i++) {
-			if (adGame->_objects[i]->_active && adGame->_objects[i] != requester && adGame->_objects[i]->_currentBlockRegion) {
-				if (adGame->_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
-					return true;
-				}
+	}
+	AdGame *adGame = (AdGame *)_gameRef;
+	for (uint32 i = 0; i < adGame->_objects.size(); i++) {
+		if (adGame->_objects[i]->_active && adGame->_objects[i] != requester && adGame->_objects[i]->_currentBlockRegion) {
+			if (adGame->_objects[i]->_currentBlockRegion->pointInRegion(x, y)) {
+				return true;
 			}
 		}
 	}
+	return false;
+}
+
 
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isBlockedBySceneAt(int x, int y) {
+	bool ret = true;
 
 	if (_mainLayer) {
 		for (uint32 i = 0; i < _mainLayer->_nodes.size(); i++) {
@@ -463,6 +482,53 @@ bool AdScene::isWalkableAt(int x, int y, bool checkFreeObjects, BaseObject *requ
 
 //////////////////////////////////////////////////////////////////////////
 int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject *requester) {
+	// A pixel is blocked either by a free object or by the scene regions,
+	// the latter being looked up in the cache
+	int dist = getSceneDist(p1, p2);
+	if (dist == -1) {
+		return -1;
+	}
+
+	_pfObjectRegions.clear();
+	for (uint32 i = 0; i < _objects.size(); i++) {
+		if (_objects[i]->_active && _objects[i] != requester && _objects[i]->_currentBlockRegion) {
+			_pfObjectRegions.add(_objects[i]->_currentBlockRegion);
+		}
+	}
+	AdGame *adGame = (AdGame *)_gameRef;
+	for (uint32 i = 0; i < adGame->_objects.size(); i++) {
+		if (adGame->_objects[i]->_active && adGame->_objects[i] != requester && adGame->_objects[i]->_currentBlockRegion) {
+			_pfObjectRegions.add(adGame->_objects[i]->_currentBlockRegion);
+		}
+	}
+
+	if (!_pfObjectRegions.empty() && isLineBlocked(p1, p2, &_pfObjectRegions)) {
+		return -1;
+	}
+	return dist;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+int AdScene::getSceneDist(const BasePoint &p1, const BasePoint &p2) {
+	const PathFinderLine line(p1, p2);
+	if (_pfSceneDist.contains(line)) {
+		return _pfSceneDist.getVal(line);
+	}
+
+	// Start and target points change with every search, don't let them pile up
+	if (_pfSceneDist.size() >= 65536) {
+		_pfSceneDist.clear(true);
+	}
+
+	int dist = isLineBlocked(p1, p2, nullptr) ? -1 : MAX(abs(p2.x - p1.x), abs(p2.y - p1.y));
+	_pfSceneDist.setVal(line, dist);
+	return dist;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isLineBlocked(const BasePoint &p1, const BasePoint &p2, const BaseArray<BaseRegion *> *regions) {
 	double xStep, yStep, x, y;
 	int xLength, yLength, xCount, yCount;
 	int x1, y1, x2, y2;
@@ -485,8 +551,8 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 		y = y1;
 
 		for (xCount = x1; xCount < x2; xCount++) {
-			if (isBlockedAt(xCount, (int)y, true, requester)) {
-				return -1;
+			if (isBlockedOnLineAt(xCount, (int)y, regions)) {
+				return true;
 			}
 			y += yStep;
 		}
@@ -500,28 +566,160 @@ int AdScene::getPointsDist(const BasePoint &p1, const BasePoint &p2, BaseObject
 		x = x1;
 
 		for (yCount = y1; yCount < y2; yCount++) {
-			if (isBlockedAt((int)x, yCount, true, requester)) {
-				return -1;
+			if (isBlockedOnLineAt((int)x, yCount, regions)) {
+				return true;
 			}
 			x += xStep;
 		}
 	}
-	return MAX(xLength, yLength);
+	return false;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::isBlockedOnLineAt(int x, int y, const BaseArray<BaseRegion *> *regions) {
+	// Without regions, the pixels are checked against the scene
+	if (!regions) {
+		return isBlockedBySceneAt(x, y);
+	}
+	for (uint32 i = 0; i < regions->size(); i++) {
+		if ((*regions)[i]->pointInRegion(x, y)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfUpdateSceneDist() {
+	// Record everything isBlockedBySceneAt() depends on
+	Common::Array<int32> state;
+	if (_mainLayer) {
+		for (uint32 i = 0; i < _mainLayer->_nodes.size(); i++) {
+			AdSceneNode *node = _mainLayer->_nodes[i];
+			if (node->_type != OBJECT_REGION) {
+				continue;
+			}
+			AdRegion *region = node->_region;
+			state.push_back(i);
+			state.push_back(region->_active | (region->hasDecoration() << 1) | (region->isBlocked() << 2));
+			state.push_back(region->_points.size());
+			for (uint32 j = 0; j < region->_points.size(); j++) {
+				state.push_back(region->_points[j]->x);
+				state.push_back(region->_points[j]->y);
+			}
+		}
+	}
+
+	if (state != _pfRegionState) {
+		_pfSceneDist.clear(true);
+		_pfRegionState = state;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+AdScene::PathFinderLine::PathFinderLine(const BasePoint &p1, const BasePoint &p2) {
+	// The line is walked the same way in both directions
+	if (p1.x < p2.x || (p1.x == p2.x && p1.y <= p2.y)) {
+		x1 = p1.x; y1 = p1.y;
+		x2 = p2.x; y2 = p2.y;
+	} else {
+		x1 = p2.x; y1 = p2.y;
+		x2 = p1.x; y2 = p1.y;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint AdScene::PathFinderLineHash::operator()(const PathFinderLine &line) const {
+	uint hash = (uint)line.x1;
+	hash = hash * 31 + (uint)line.y1;
+	hash = hash * 31 + (uint)line.x2;
+	hash = hash * 31 + (uint)line.y2;
+	return hash;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfOpenRebuild() {
+	_pfOpen.clear();
+	for (int32 i = 0; i < _pfPointsNum; i++) {
+		if (!_pfPath[i]->_marked && _pfPath[i]->_distance < INT_MAX_VALUE) {
+			pfOpenPush(i);
+		}
+	}
+	_pfOpenValid = true;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void AdScene::pfOpenPush(int32 index) {
+	PathFinderOpenPoint point;
+	point.distance = _pfPath[index]->_distance;
+	point.index = index;
+
+	uint32 pos = _pfOpen.size();
+	_pfOpen.push_back(point);
+	while (pos > 0) {
+		uint32 parent = (pos - 1) / 2;
+		if (!(point < _pfOpen[parent])) {
+			break;
+		}
+		_pfOpen[pos] = _pfOpen[parent];
+		pos = parent;
+	}
+	_pfOpen[pos] = point;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+AdScene::PathFinderOpenPoint AdScene::pfOpenPop() {
+	PathFinderOpenPoint top = _pfOpen[0];
+	PathFinderOpenPoint last = _pfOpen.back();
+	_pfOpen.pop_back();
+
+	uint32 size = _pfOpen.size();
+	if (size > 0) {
+		uint32 pos = 0;
+		for (;;) {
+			uint32 child = pos * 2 + 1;
+			if (child >= size) {
+				break;
+			}
+			if (child + 1 < size && _pfOpen[child + 1] < _pfOpen[child]) {
+				child++;
+			}
+			if (!(_pfOpen[child] < last)) {
+				break;
+			}
+			_pfOpen[pos] = _pfOpen[child];
+			pos = child;
+		}
+		_pfOpen[pos] = last;
+	}
+	return top;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 void AdScene::pathFinderStep() {
 	int i;
+	if (!_pfOpenValid) {
+		pfOpenRebuild();
+	}
+
 	// get lowest unmarked
-	int lowestDist = INT_MAX_VALUE;
 	AdPathPoint *lowestPt = nullptr;
-
-	for (i = 0; i < _pfPointsNum; i++)
-		if (!_pfPath[i]->_marked && _pfPath[i]->_distance < lowestDist) {
-			lowestDist = _pfPath[i]->_distance;
-			lowestPt = _pfPath[i];
+	while (!_pfOpen.empty()) {
+		PathFinderOpenPoint open = pfOpenPop();
+		// Points reached again by a shorter way are queued several times
+		if (!_pfPath[open.index]->_marked && _pfPath[open.index]->_distance == open.distance) {
+			lowestPt = _pfPath[open.index];
+			break;
 		}
+	}
 
 	if (lowestPt == nullptr) { // no path -> terminate PathFinder
 		_pfReady = true;
@@ -550,6 +748,7 @@ void AdScene::pathFinderStep() {
 			if (j != -1 && lowestPt->_distance + j < _pfPath[i]->_distance) {
 				_pfPath[i]->_distance = lowestPt->_distance + j;
 				_pfPath[i]->_origin = lowestPt;
+				pfOpenPush(i);
 			}
 		}
 }
@@ -569,6 +768,10 @@ bool AdScene::initLoop() {
 	}
 #else
 	uint32 start = _gameRef->_currentTime;
+	// Scripts may have changed the regions since the last frame
+	if (!_pfReady) {
+		pfUpdateSceneDist();
+	}
 	while (!_pfReady && g_system->getMillis() - start <= _pfMaxTime) {
 		pathFinderStep();
 	}
@@ -3023,6 +3226,10 @@ bool AdScene::persist(BasePersistenceManager *persistMgr) {
 	_pfPath.persist(persistMgr);
 	persistMgr->transferSint32(TMEMBER(_pfPointsNum));
 	persistMgr->transferBool(TMEMBER(_pfReady));
+	if (!persistMgr->getIsSaving()) {
+		_pfOpen.clear();
+		_pfOpenValid = false;
+	}
 	persistMgr->transferPtr(TMEMBER_PTR(_pfRequester));
 	persistMgr->transferPtr(TMEMBER_PTR(_pfTarget));
 	persistMgr->transferPtr(TMEMBER_PTR(_pfTargetPath));
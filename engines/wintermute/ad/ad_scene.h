@@ -30,6 +30,8 @@
 
 #include "engines/wintermute/base/base_fader.h"
 
+#include "common/hashmap.h"
+
 namespace Wintermute {
 
 class UIWindow;
@@ -43,6 +45,7 @@ class AdPath;
 class AdScaleLevel;
 class AdRotLevel;
 class AdPathPoint;
+class BaseRegion;
 #ifdef ENABLE_WME3D
 class AdSceneGeometry;
 #endif
@@ -200,6 +203,53 @@ private:
 	BaseObject *_pfRequester;
 	BaseArray<AdPathPoint *> _pfPath;
 
+	// Point of the search waiting to be marked, as known when it was queued
+	struct PathFinderOpenPoint {
+		int32 distance;
+		int32 index; // into _pfPath
+		// Same order as the original linear scan for the lowest point
+		bool operator<(const PathFinderOpenPoint &other) const {
+			return distance < other.distance || (distance == other.distance && index < other.index);
+		}
+	};
+
+	// Points of the running search which were reached but not marked yet,
+	// as a binary heap ordered by distance and then index. It's not saved,
+	// but rebuilt from _pfPath after loading.
+	Common::Array<PathFinderOpenPoint> _pfOpen;
+	bool _pfOpenValid;
+	void pfOpenRebuild();
+	void pfOpenPush(int32 index);
+	PathFinderOpenPoint pfOpenPop();
+
+	// Key of the line between two points, stored with the smaller point first
+	struct PathFinderLine {
+		int32 x1, y1, x2, y2;
+		PathFinderLine(const BasePoint &p1, const BasePoint &p2);
+		bool operator==(const PathFinderLine &other) const {
+			return x1 == other.x1 && y1 == other.y1 && x2 == other.x2 && y2 == other.y2;
+		}
+	};
+	struct PathFinderLineHash {
+		uint operator()(const PathFinderLine &line) const;
+	};
+
+	// Distances between the points as far as the scene regions are concerned,
+	// -1 for the blocked lines. They are valid as long as the regions of the
+	// main layer stay the same, which is what _pfRegionState records.
+	Common::HashMap<PathFinderLine, int32, PathFinderLineHash> _pfSceneDist;
+	Common::Array<int32> _pfRegionState;
+	void pfUpdateSceneDist();
+	int getSceneDist(const BasePoint &p1, const BasePoint &p2);
+
+	// Blocking regions of the free objects, gathered by getPointsDist
+	BaseArray<BaseRegion *> _pfObjectRegions;
+
+	bool isBlockedBySceneAt(int x, int y);
+	bool isBlockedByObjectsAt(int x, int y, BaseObject *requester);
+	bool isLineBlocked(const BasePoint &p1, const BasePoint &p2, const BaseArray<BaseRegion *> *regions);
+	bool isBlockedOnLineAt(int x, int y, const BaseArray<BaseRegion *> *regions);
+
 	int32 _offsetTop;
 	int32 _offsetLeft;
 
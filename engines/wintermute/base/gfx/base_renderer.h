@@ -137,6 +137,16 @@ public:
 	virtual bool displayDebugInfo() {
 		return STATUS_FAILED;
 	};
+	/**
+	 * Get a description of the rendering statistics gathered since the last
+	 * call to resetStats(), for the debugger.
+	 *
+	 * @return the statistics, or an empty string if the renderer has none.
+	 */
+	virtual Common::String getStats() const {
+		return Common::String();
+	}
+	virtual void resetStats() {}
 	virtual bool drawShaderQuad() {
 		return STATUS_FAILED;
 	}
@@ -35,11 +35,16 @@
 #include "engines/wintermute/base/base_sprite.h"
 #include "engines/util.h"
 
+#include "common/profiler.h"
 #include "common/system.h"
 #include "common/queue.h"
 #include "common/config-manager.h"
 
 #define DIRTY_RECT_LIMIT 800
+// Maximum number of separate dirty rects, more are merged into one
+#define MAX_DIRTY_RECTS 16
+// Area (in pixels) two dirty rects may grow by when merged, rather than drawn separately
+#define DIRTY_RECT_MERGE_SLACK 4096
 
 namespace Wintermute {
 
@@ -57,13 +62,13 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
 	}
 
 	_lastScreenChangeID = g_system->getScreenChangeID();
+	resetStats();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -75,8 +80,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -156,10 +159,11 @@ bool BaseRenderOSystem::forcedFlip() {
 }
 
 bool BaseRenderOSystem::flip() {
+	PROFILE_ZONE("Wintermute::BaseRenderOSystem::flip");
+
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -198,9 +202,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -381,16 +383,45 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 	}
 }
 
+static int32 rectArea(const Common::Rect &rect) {
+	return (int32)rect.width() * rect.height();
+}
+
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
+	}
+
+	// Merge with the rects it overlaps, or which are about as cheap to
+	// redraw together, until it stands on its own
+	for (uint i = 0; i < _dirtyRects.size();) {
+		Common::Rect merged(_dirtyRects[i]);
+		merged.extend(dirty);
+		if (_dirtyRects[i].intersects(dirty) ||
+		    rectArea(merged) <= rectArea(_dirtyRects[i]) + rectArea(dirty) + DIRTY_RECT_MERGE_SLACK) {
+			dirty = merged;
+			_dirtyRects.remove_at(i);
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+	_dirtyRects.push_back(dirty);
+
+	if (_dirtyRects.size() > MAX_DIRTY_RECTS) {
+		for (uint i = 1; i < _dirtyRects.size(); i++) {
+			_dirtyRects[0].extend(_dirtyRects[i]);
+		}
+		_dirtyRects.resize(1);
+		_stats.collapsed++;
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
+	uint32 startTime = g_system->getMillis();
+
 	RenderQueueIterator it = _renderQueue.begin();
 	// Clean out the old tickets
 	// Note: We draw invalid tickets too, otherwise we wouldn't be honoring
@@ -406,7 +437,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -416,29 +447,67 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
+	_drawList.clear();
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		_drawList.push_back(*it);
+	}
 	_lastFrameIter = _renderQueue.end();
-	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
-	// the background color. Typical use-case: Fullscreen FMVs.
-	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
-		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
-			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+
+	for (uint i = 0; i < _dirtyRects.size(); i++) {
+		drawDirtyRect(_dirtyRects[i]);
+	}
+
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	for (uint i = 0; i < _drawList.size(); i++) {
+		_drawList[i]->_wantsDraw = false;
+	}
+
+	_stats.frames++;
+	_stats.tickets += _drawList.size();
+	_stats.dirtyRects += _dirtyRects.size();
+
+	it = _renderQueue.begin();
+	// Clean out the old tickets
+	while (it != _renderQueue.end()) {
+		if ((*it)->_isValid == false) {
+			RenderTicket *ticket = *it;
+			addDirtyRect((*it)->_dstRect);
+			it = _renderQueue.erase(it);
+			delete ticket;
+		} else {
+			++it;
 		}
-		// Otherwise Do NOT fill.
-	} else {
+	}
+
+	_stats.drawTime += g_system->getMillis() - startTime;
+}
+
+void BaseRenderOSystem::drawDirtyRect(const Common::Rect &dirtyRect) {
+	// Nothing drawn before the last opaque ticket covering the whole rect
+	// shows through, and neither does the clear-color. Typical use-cases:
+	// room backgrounds and fullscreen FMVs.
+	uint first = 0;
+	bool covered = false;
+	for (uint i = _drawList.size(); i > 0; i--) {
+		if (_drawList[i - 1]->isOpaque() && _drawList[i - 1]->_dstRect.contains(dirtyRect)) {
+			first = i - 1;
+			covered = true;
+			break;
+		}
+	}
+
+	if (!covered) {
 		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
+		_renderSurface->fillRect(dirtyRect, _clearColor);
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
+
+	for (uint i = first; i < _drawList.size(); i++) {
+		RenderTicket *ticket = _drawList[i];
+		if (ticket->_dstRect.intersects(dirtyRect)) {
 			// dstClip is the area we want redrawn.
 			Common::Rect dstClip(ticket->_dstRect);
 			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
+			dstClip.clip(dirtyRect);
 			// we need to keep track of the position to redraw the dirty rect
 			Common::Rect pos(dstClip);
 			int16 offsetX = ticket->_dstRect.left;
@@ -448,25 +517,13 @@ void BaseRenderOSystem::drawTickets() {
 
 			drawFromSurface(ticket, &pos, &dstClip);
 			_needsFlip = true;
-		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
-	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-
-	it = _renderQueue.begin();
-	// Clean out the old tickets
-	while (it != _renderQueue.end()) {
-		if ((*it)->_isValid == false) {
-			RenderTicket *ticket = *it;
-			addDirtyRect((*it)->_dstRect);
-			it = _renderQueue.erase(it);
-			delete ticket;
-		} else {
-			++it;
+			_stats.ticketsDrawn++;
 		}
 	}
+	_stats.ticketsHidden += first;
+	_stats.pixels += rectArea(dirtyRect);
 
+	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(dirtyRect.left, dirtyRect.top), _renderSurface->pitch, dirtyRect.left, dirtyRect.top, dirtyRect.width(), dirtyRect.height());
 }
 
 // Replacement for SDL2's SDL_RenderCopy
@@ -598,6 +655,28 @@ void BaseRenderOSystem::endSaveLoad() {
 	g_system->updateScreen();
 }
 
+Common::String BaseRenderOSystem::getStats() const {
+	if (_disableDirtyRects) {
+		return "Dirty rects are disabled, the whole screen is redrawn every frame\n";
+	}
+	if (_stats.frames == 0) {
+		return "No frames drawn\n";
+	}
+
+	const uint32 frames = _stats.frames;
+	return Common::String::format(
+		"Frames: %u, %u ms drawing (%.2f ms per frame)\n"
+		"Tickets per frame: %.1f, %.1f redrawn, %.1f hidden by opaque ones\n"
+		"Dirty rects per frame: %.1f, %.0f pixels, merged into one %u times\n",
+		frames, _stats.drawTime, (double)_stats.drawTime / frames,
+		(double)_stats.tickets / frames, (double)_stats.ticketsDrawn / frames, (double)_stats.ticketsHidden / frames,
+		(double)_stats.dirtyRects / frames, (double)_stats.pixels / frames, _stats.collapsed);
+}
+
+void BaseRenderOSystem::resetStats() {
+	memset(&_stats, 0, sizeof(_stats));
+}
+
 bool BaseRenderOSystem::startSpriteBatch() {
 	return STATUS_OK;
 }
@@ -30,6 +30,7 @@
 
 #include "engines/wintermute/base/gfx/base_renderer.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "common/list.h"
 
@@ -114,6 +115,8 @@ public:
 	bool startSpriteBatch() override;
 	bool endSpriteBatch() override;
 	void endSaveLoad() override;
+	Common::String getStats() const override;
+	void resetStats() override;
 	void drawSurface(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRect, Graphics::TransformStruct &transform);
 	BaseSurface *createSurface() override;
 private:
@@ -130,8 +133,27 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	/**
+	 * Redraw the tickets overlapping a dirty rect, and copy it to the screen
+	 */
+	void drawDirtyRect(const Common::Rect &dirtyRect);
+	// Disjoint regions of the screen to redraw
+	Common::Array<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
+	// The render queue in an array, as each dirty rect walks it
+	Common::Array<RenderTicket *> _drawList;
+
+	struct Stats {
+		uint32 frames;        // Frames drawn with dirty rects
+		uint32 tickets;       // Tickets in the queue, summed over the frames
+		uint32 ticketsDrawn;  // Tickets redrawn, once for each dirty rect they overlap
+		uint32 ticketsHidden; // Tickets skipped as they were behind an opaque one
+		uint32 dirtyRects;    // Dirty rects redrawn
+		uint32 collapsed;     // Frames with too many dirty rects, redrawn as one
+		uint64 pixels;        // Area of the dirty rects
+		uint32 drawTime;      // Time spent drawing the tickets, in ms
+	};
+	Stats _stats;
 
 	bool _needsFlip;
 	RenderQueueIterator _lastFrameIter;
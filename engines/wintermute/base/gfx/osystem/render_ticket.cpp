@@ -45,12 +45,11 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 	        _wantsDraw(true),
 	        _transform(transform) {
 	if (surf) {
-		_surface = new Graphics::Surface();
-		_surface->create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
-		assert(_surface->format.bytesPerPixel == 4);
+		_surface.create((uint16)srcRect->width(), (uint16)srcRect->height(), surf->format);
+		assert(_surface.format.bytesPerPixel == 4);
 		// Get a clipped copy of the surface
-		for (int i = 0; i < _surface->h; i++) {
-			memcpy(_surface->getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface->format.bytesPerPixel);
+		for (int i = 0; i < _surface.h; i++) {
+			memcpy(_surface.getBasePtr(0, i), surf->getBasePtr(srcRect->left, srcRect->top + i), srcRect->width() * _surface.format.bytesPerPixel);
 		}
 		// Then scale it if necessary
 		//
@@ -61,27 +60,16 @@ RenderTicket::RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *s
 		// (Mirroring should most likely be done before rotation. See also
 		// TransformTools.)
 		if (_transform._angle != Graphics::kDefaultAngle) {
-			Graphics::Surface *temp = _surface->rotoscale(transform, owner->_gameRef->getBilinearFiltering());
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			Graphics::ManagedSurface *temp = _surface.rotoscale(transform, owner->_gameRef->getBilinearFiltering());
+			_surface = Common::move(*temp);
+			delete temp;
 		} else if ((dstRect->width() != srcRect->width() ||
 					dstRect->height() != srcRect->height()) &&
 					_transform._numTimesX * _transform._numTimesY == 1) {
-			Graphics::Surface *temp = _surface->scale(dstRect->width(), dstRect->height(), owner->_gameRef->getBilinearFiltering());
-			_surface->free();
-			delete _surface;
-			_surface = temp;
+			Graphics::ManagedSurface *temp = _surface.scale(dstRect->width(), dstRect->height(), owner->_gameRef->getBilinearFiltering());
+			_surface = Common::move(*temp);
+			delete temp;
 		}
-	} else {
-		_surface = nullptr;
-	}
-}
-
-RenderTicket::~RenderTicket() {
-	if (_surface) {
-		_surface->free();
-		delete _surface;
 	}
 }
 
@@ -96,26 +84,35 @@ bool RenderTicket::operator==(const RenderTicket &t) const {
 	return true;
 }
 
-// Replacement for SDL2's SDL_RenderCopy
-void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
-	Graphics::ManagedSurface src;
-	src.copyFrom(*getSurface());
+Graphics::AlphaType RenderTicket::getAlphaType() const {
+	if (!_owner) {
+		return Graphics::ALPHA_FULL;
+	}
+	if (_transform._alphaDisable) {
+		return Graphics::ALPHA_OPAQUE;
+	} else if (_transform._angle) {
+		return Graphics::ALPHA_FULL;
+	} else {
+		return _owner->getAlphaType();
+	}
+}
 
+bool RenderTicket::isOpaque() const {
+	// Rotated tickets are blended, and tiled ones may leave gaps
+	return getAlphaType() == Graphics::ALPHA_OPAQUE &&
+	       _transform._blendMode == Graphics::BLEND_NORMAL &&
+	       (_transform._rgbaMod & MS_ARGB(255, 0, 0, 0)) == MS_ARGB(255, 0, 0, 0) &&
+	       _transform._numTimesX * _transform._numTimesY == 1 &&
+	       _surface.w == _dstRect.width() && _surface.h == _dstRect.height();
+}
+
+// Replacement for SDL2's SDL_RenderCopy
+void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) {
 	Common::Rect clipRect;
 	clipRect.setWidth(getSurface()->w);
 	clipRect.setHeight(getSurface()->h);
 
-	Graphics::AlphaType alphaMode = Graphics::ALPHA_FULL;
-
-	if (_owner) {
-		if (_transform._alphaDisable) {
-			alphaMode = Graphics::ALPHA_OPAQUE;
-		} else if (_transform._angle) {
-			alphaMode = Graphics::ALPHA_FULL;
-		} else {
-			alphaMode = _owner->getAlphaType();
-		}
-	}
+	Graphics::AlphaType alphaMode = getAlphaType();
 
 	int y = _dstRect.top;
 	int w = _dstRect.width() / _transform._numTimesX;
@@ -124,7 +121,7 @@ void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	for (int ry = 0; ry < _transform._numTimesY; ++ry) {
 		int x = _dstRect.left;
 		for (int rx = 0; rx < _transform._numTimesX; ++rx) {
-			src.blendBlitTo(*_targetSurface, x, y, _transform._flip, &clipRect, _transform._rgbaMod, clipRect.width(), clipRect.height(),
+			_surface.blendBlitTo(*_targetSurface, x, y, _transform._flip, &clipRect, _transform._rgbaMod, clipRect.width(), clipRect.height(),
 				Graphics::BLEND_NORMAL, alphaMode);
 			x += w;
 		}
@@ -132,10 +129,7 @@ void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface) const {
 	}
 }
 
-void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface, Common::Rect *dstRect, Common::Rect *clipRect) const {
-	Graphics::ManagedSurface src;
-	src.copyFrom(*getSurface());
-
+void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface, Common::Rect *dstRect, Common::Rect *clipRect) {
 	bool doDelete = false;
 	if (!clipRect) {
 		doDelete = true;
@@ -144,21 +138,11 @@ void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface, Common::Rect
 		clipRect->setHeight(getSurface()->h * _transform._numTimesY);
 	}
 
-	Graphics::AlphaType alphaMode = Graphics::ALPHA_FULL;
-
-	if (_owner) {
-		if (_transform._alphaDisable) {
-			alphaMode = Graphics::ALPHA_OPAQUE;
-		} else if (_transform._angle) {
-			alphaMode = Graphics::ALPHA_FULL;
-		} else {
-			alphaMode = _owner->getAlphaType();
-		}
-	}
+	Graphics::AlphaType alphaMode = getAlphaType();
 
 	if (_transform._numTimesX * _transform._numTimesY == 1) {
 
-		src.blendBlitTo(*_targetSurface, dstRect->left, dstRect->top, _transform._flip, clipRect, _transform._rgbaMod, clipRect->width(),
+		_surface.blendBlitTo(*_targetSurface, dstRect->left, dstRect->top, _transform._flip, clipRect, _transform._rgbaMod, clipRect->width(),
 			clipRect->height(), _transform._blendMode, alphaMode);
 
 	} else {
@@ -187,7 +171,7 @@ void RenderTicket::drawToSurface(Graphics::Surface *_targetSurface, Common::Rect
 				if (subRect.intersects(*clipRect)) {
 					subRect.clip(*clipRect);
 					subRect.translate(-x, -y);
-					src.blendBlitTo(*_targetSurface, basex + x + subRect.left, basey + y + subRect.top, _transform._flip, &subRect,
+					_surface.blendBlitTo(*_targetSurface, basex + x + subRect.left, basey + y + subRect.top, _transform._flip, &subRect,
 						_transform._rgbaMod, subRect.width(), subRect.height(), _transform._blendMode, alphaMode);
 
 				}
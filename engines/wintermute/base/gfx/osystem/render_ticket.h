@@ -28,6 +28,7 @@
 #ifndef WINTERMUTE_RENDER_TICKET_H
 #define WINTERMUTE_RENDER_TICKET_H
 
+#include "graphics/managed_surface.h"
 #include "graphics/surface.h"
 
 #include "common/rect.h"
@@ -52,12 +53,16 @@ class RenderTicket {
 public:
 	RenderTicket(BaseSurfaceOSystem *owner, const Graphics::Surface *surf, Common::Rect *srcRect, Common::Rect *dstRest, Graphics::TransformStruct transform);
 	RenderTicket() : _isValid(true), _wantsDraw(false), _transform(Graphics::TransformStruct()) {}
-	~RenderTicket();
-	const Graphics::Surface *getSurface() const { return _surface; }
+	const Graphics::Surface *getSurface() const { return &_surface.rawSurface(); }
 	// Non-dirty-rects:
-	void drawToSurface(Graphics::Surface *_targetSurface) const;
+	void drawToSurface(Graphics::Surface *_targetSurface);
 	// Dirty-rects:
-	void drawToSurface(Graphics::Surface *_targetSurface, Common::Rect *dstRect, Common::Rect *clipRect) const;
+	void drawToSurface(Graphics::Surface *_targetSurface, Common::Rect *dstRect, Common::Rect *clipRect);
+	/**
+	 * Tells if the ticket fully covers its destination rect, so that nothing
+	 * drawn before it there can show through.
+	 */
+	bool isOpaque() const;
 
 	Common::Rect _dstRect;
 
@@ -70,7 +75,9 @@ public:
 	bool operator==(const RenderTicket &a) const;
 	const Common::Rect *getSrcRect() const { return &_srcRect; }
 private:
-	Graphics::Surface *_surface;
+	Graphics::AlphaType getAlphaType() const;
+
+	Graphics::ManagedSurface _surface;
 	Common::Rect _srcRect;
 };
 
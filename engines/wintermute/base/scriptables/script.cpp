@@ -49,6 +49,7 @@ IMPLEMENT_PERSISTENT(ScScript, false)
 
 //////////////////////////////////////////////////////////////////////////
 ScScript::ScScript(BaseGame *inGame, ScEngine *engine) : BaseClass(inGame) {
+	_compiled = nullptr;
 	_buffer = nullptr;
 	_bufferSize = _iP = 0;
 	_scriptStream = nullptr;
@@ -115,27 +116,12 @@ ScScript::~ScScript() {
 	cleanup();
 }
 
-void ScScript::readHeader() {
-	uint32 oldPos = _scriptStream->pos();
-	_scriptStream->seek(0);
-	_header.magic = _scriptStream->readUint32LE();
-	_header.version = _scriptStream->readUint32LE();
-	_header.codeStart = _scriptStream->readUint32LE();
-	_header.funcTable = _scriptStream->readUint32LE();
-	_header.symbolTable = _scriptStream->readUint32LE();
-	_header.eventTable = _scriptStream->readUint32LE();
-	_header.externalsTable = _scriptStream->readUint32LE();
-	_header.methodTable = _scriptStream->readUint32LE();
-	_scriptStream->seek(oldPos);
-}
-
-
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::initScript() {
 	if (!_scriptStream) {
 		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
 	}
-	readHeader();
+	_header = _compiled->_header;
 
 	if (_header.magic != SCRIPT_MAGIC) {
 		_gameRef->LOG(0, "File '%s' is not a valid compiled script", _filename);
@@ -175,81 +161,28 @@ bool ScScript::initScript() {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScScript::initTables() {
-	uint32 origIP = _iP;
-
-	readHeader();
-	// load symbol table
-	_iP = _header.symbolTable;
-
-	_numSymbols = getDWORD();
-	_symbols = new char*[_numSymbols];
-	for (uint32 i = 0; i < _numSymbols; i++) {
-		uint32 index = getDWORD();
-		_symbols[index] = getString();
-	}
-
-	// load functions table
-	_iP = _header.funcTable;
-
-	_numFunctions = getDWORD();
-	_functions = new TFunctionPos[_numFunctions];
-	for (uint32 i = 0; i < _numFunctions; i++) {
-		_functions[i].pos = getDWORD();
-		_functions[i].name = getString();
-	}
-
-
-	// load events table
-	_iP = _header.eventTable;
-
-	_numEvents = getDWORD();
-	_events = new TEventPos[_numEvents];
-	for (uint32 i = 0; i < _numEvents; i++) {
-		_events[i].pos = getDWORD();
-		_events[i].name = getString();
-	}
-
-
-	// load externals
-	if (_header.version >= 0x0101) {
-		_iP = _header.externalsTable;
-
-		_numExternals = getDWORD();
-		_externals = new TExternalFunction[_numExternals];
-		for (uint32 i = 0; i < _numExternals; i++) {
-			_externals[i].dll_name = getString();
-			_externals[i].name = getString();
-			_externals[i].call_type = (TCallType)getDWORD();
-			_externals[i].returns = (TExternalType)getDWORD();
-			_externals[i].nu_params = getDWORD();
-			if (_externals[i].nu_params > 0) {
-				_externals[i].params = new TExternalType[_externals[i].nu_params];
-				for (int j = 0; j < _externals[i].nu_params; j++) {
-					_externals[i].params[j] = (TExternalType)getDWORD();
-				}
-			}
-		}
-	}
-
-	// load method table
-	_iP = _header.methodTable;
-
-	_numMethods = getDWORD();
-	_methods = new TMethodPos[_numMethods];
-	for (uint32 i = 0; i < _numMethods; i++) {
-		_methods[i].pos = getDWORD();
-		_methods[i].name = getString();
-	}
-
-
-	_iP = origIP;
+	// the tables are only parsed by the first instance of the script
+	_compiled->initTables();
+
+	_header = _compiled->_header;
+
+	_symbols = _compiled->_symbols;
+	_numSymbols = _compiled->_numSymbols;
+	_functions = _compiled->_functions;
+	_numFunctions = _compiled->_numFunctions;
+	_events = _compiled->_events;
+	_numEvents = _compiled->_numEvents;
+	_externals = _compiled->_externals;
+	_numExternals = _compiled->_numExternals;
+	_methods = _compiled->_methods;
+	_numMethods = _compiled->_numMethods;
 
 	return STATUS_OK;
 }
 
 
 //////////////////////////////////////////////////////////////////////////
-bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner) {
+bool ScScript::create(const char *filename, ScCompiledScript *compiled, BaseScriptHolder *owner) {
 	cleanup();
 
 	_thread = false;
@@ -262,14 +195,11 @@ bool ScScript::create(const char *filename, byte *buffer, uint32 size, BaseScrip
 	_filename = new char[filenameSize];
 	Common::strcpy_s(_filename, filenameSize, filename);
 
-	_buffer = new byte [size];
-	if (!_buffer) {
-		return STATUS_FAILED;
-	}
-
-	memcpy(_buffer, buffer, size);
-
-	_bufferSize = size;
+	// share the bytecode
+	_compiled = compiled;
+	_compiled->incRef();
+	_buffer = _compiled->_buffer;
+	_bufferSize = _compiled->_size;
 
 	bool res = initScript();
 	if (DID_FAIL(res)) {
@@ -299,11 +229,11 @@ bool ScScript::createThread(ScScript *original, uint32 initIP, const Common::Str
 	_filename = new char[filenameSize];
 	Common::strcpy_s(_filename, filenameSize, original->_filename);
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
-	_bufferSize = original->_bufferSize;
+	// share the bytecode
+	_compiled = original->_compiled;
+	_compiled->incRef();
+	_buffer = _compiled->_buffer;
+	_bufferSize = _compiled->_size;
 
 	// initialize
 	bool res = initScript();
@@ -350,11 +280,11 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 	_filename = new char[filenameSize];
 	Common::strcpy_s(_filename, filenameSize, original->_filename);
 
-	// copy buffer
-	_buffer = new byte [original->_bufferSize];
-
-	memcpy(_buffer, original->_buffer, original->_bufferSize);
-	_bufferSize = original->_bufferSize;
+	// share the bytecode
+	_compiled = original->_compiled;
+	_compiled->incRef();
+	_buffer = _compiled->_buffer;
+	_bufferSize = _compiled->_size;
 
 	// initialize
 	bool res = initScript();
@@ -381,19 +311,19 @@ bool ScScript::createMethodThread(ScScript *original, const Common::String &meth
 
 //////////////////////////////////////////////////////////////////////////
 void ScScript::cleanup() {
-	if (_buffer) {
-		delete[] _buffer;
+	// the tables belong to the shared bytecode
+	if (_compiled) {
+		_compiled->decRef();
 	}
+	_compiled = nullptr;
 	_buffer = nullptr;
+	_bufferSize = 0;
 
 	if (_filename) {
 		delete[] _filename;
 	}
 	_filename = nullptr;
 
-	if (_symbols) {
-		delete[] _symbols;
-	}
 	_symbols = nullptr;
 	_numSymbols = 0;
 
@@ -414,33 +344,15 @@ void ScScript::cleanup() {
 	delete _stack;
 	_stack = nullptr;
 
-	if (_functions) {
-		delete[] _functions;
-	}
 	_functions = nullptr;
 	_numFunctions = 0;
 
-	if (_methods) {
-		delete[] _methods;
-	}
 	_methods = nullptr;
 	_numMethods = 0;
 
-	if (_events) {
-		delete[] _events;
-	}
 	_events = nullptr;
 	_numEvents = 0;
 
-
-	if (_externals) {
-		for (uint32 i = 0; i < _numExternals; i++) {
-			if (_externals[i].nu_params > 0) {
-				delete[] _externals[i].params;
-			}
-		}
-		delete[] _externals;
-	}
 	_externals = nullptr;
 	_numExternals = 0;
 
@@ -1311,11 +1223,15 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 	} else {
 		persistMgr->transferUint32(TMEMBER(_bufferSize));
 		if (_bufferSize > 0) {
-			_buffer = new byte[_bufferSize];
-			persistMgr->getBytes(_buffer, _bufferSize);
+			// the saved bytecode isn't shared with the script cache
+			byte *buffer = new byte[_bufferSize];
+			persistMgr->getBytes(buffer, _bufferSize);
+			_compiled = new ScCompiledScript(buffer, _bufferSize);
+			_buffer = _compiled->_buffer;
 			_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
 			initTables();
 		} else {
+			_compiled = nullptr;
 			_buffer = nullptr;
 			_scriptStream = nullptr;
 		}
@@ -1363,15 +1279,15 @@ bool ScScript::persist(BasePersistenceManager *persistMgr) {
 //////////////////////////////////////////////////////////////////////////
 void ScScript::afterLoad() {
 	if (_buffer == nullptr) {
-		byte *buffer = _engine->getCompiledScript(_filename, &_bufferSize);
-		if (!buffer) {
+		_compiled = _engine->getCompiledScript(_filename);
+		if (!_compiled) {
 			_gameRef->LOG(0, "Error reinitializing script '%s' after load. Script will be terminated.", _filename);
 			_state = SCRIPT_ERROR;
 			return;
 		}
 
-		_buffer = new byte [_bufferSize];
-		memcpy(_buffer, buffer, _bufferSize);
+		_buffer = _compiled->_buffer;
+		_bufferSize = _compiled->_size;
 
 		delete _scriptStream;
 		_scriptStream = new Common::MemoryReadStream(_buffer, _bufferSize);
@@ -1526,4 +1442,160 @@ void ScScript::preInstHook(uint32 inst) {}
 
 void ScScript::postInstHook(uint32 inst) {}
 
+
+//////////////////////////////////////////////////////////////////////////
+ScCompiledScript::ScCompiledScript(byte *buffer, uint32 size) {
+	_buffer = buffer;
+	_size = size;
+	_refCount = 1;
+
+	uint32 pos = 0;
+	_header.magic = readDWORD(pos);
+	_header.version = readDWORD(pos);
+	_header.codeStart = readDWORD(pos);
+	_header.funcTable = readDWORD(pos);
+	_header.symbolTable = readDWORD(pos);
+	_header.eventTable = readDWORD(pos);
+	_header.externalsTable = readDWORD(pos);
+	_header.methodTable = readDWORD(pos);
+
+	_tablesLoaded = false;
+	_symbols = nullptr;
+	_numSymbols = 0;
+	_functions = nullptr;
+	_numFunctions = 0;
+	_methods = nullptr;
+	_numMethods = 0;
+	_events = nullptr;
+	_numEvents = 0;
+	_externals = nullptr;
+	_numExternals = 0;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+ScCompiledScript::~ScCompiledScript() {
+	delete[] _symbols;
+	delete[] _functions;
+	delete[] _methods;
+	delete[] _events;
+
+	if (_externals) {
+		for (uint32 i = 0; i < _numExternals; i++) {
+			if (_externals[i].nu_params > 0) {
+				delete[] _externals[i].params;
+			}
+		}
+		delete[] _externals;
+	}
+
+	delete[] _buffer;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScCompiledScript::decRef() {
+	_refCount--;
+	if (_refCount <= 0) {
+		delete this;
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+void ScCompiledScript::initTables() {
+	if (_tablesLoaded) {
+		return;
+	}
+	_tablesLoaded = true;
+
+	uint32 pos;
+
+	// load symbol table
+	pos = _header.symbolTable;
+
+	_numSymbols = readDWORD(pos);
+	_symbols = new char*[_numSymbols];
+	for (uint32 i = 0; i < _numSymbols; i++) {
+		uint32 index = readDWORD(pos);
+		_symbols[index] = readString(pos);
+	}
+
+	// load functions table
+	pos = _header.funcTable;
+
+	_numFunctions = readDWORD(pos);
+	_functions = new ScScript::TFunctionPos[_numFunctions];
+	for (uint32 i = 0; i < _numFunctions; i++) {
+		_functions[i].pos = readDWORD(pos);
+		_functions[i].name = readString(pos);
+	}
+
+
+	// load events table
+	pos = _header.eventTable;
+
+	_numEvents = readDWORD(pos);
+	_events = new ScScript::TEventPos[_numEvents];
+	for (uint32 i = 0; i < _numEvents; i++) {
+		_events[i].pos = readDWORD(pos);
+		_events[i].name = readString(pos);
+	}
+
+
+	// load externals
+	if (_header.version >= 0x0101) {
+		pos = _header.externalsTable;
+
+		_numExternals = readDWORD(pos);
+		_externals = new ScScript::TExternalFunction[_numExternals];
+		for (uint32 i = 0; i < _numExternals; i++) {
+			_externals[i].dll_name = readString(pos);
+			_externals[i].name = readString(pos);
+			_externals[i].call_type = (TCallType)readDWORD(pos);
+			_externals[i].returns = (TExternalType)readDWORD(pos);
+			_externals[i].nu_params = readDWORD(pos);
+			if (_externals[i].nu_params > 0) {
+				_externals[i].params = new TExternalType[_externals[i].nu_params];
+				for (int j = 0; j < _externals[i].nu_params; j++) {
+					_externals[i].params[j] = (TExternalType)readDWORD(pos);
+				}
+			}
+		}
+	}
+
+	// load method table
+	pos = _header.methodTable;
+
+	_numMethods = readDWORD(pos);
+	_methods = new ScScript::TMethodPos[_numMethods];
+	for (uint32 i = 0; i < _numMethods; i++) {
+		_methods[i].pos = readDWORD(pos);
+		_methods[i].name = readString(pos);
+	}
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+uint32 ScCompiledScript::readDWORD(uint32 &pos) const {
+	// reads past the end return 0, like the script stream
+	uint32 ret = 0;
+	if (pos <= _size && _size - pos >= 4) {
+		ret = READ_LE_UINT32(_buffer + pos);
+	}
+	pos += 4;
+	return ret;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+char *ScCompiledScript::readString(uint32 &pos) const {
+	char *ret = (char *)(_buffer + pos);
+	while (*(char *)(_buffer + pos) != '\0') {
+		pos++;
+	}
+	pos++;
+	return ret;
+}
+
 } // End of namespace Wintermute
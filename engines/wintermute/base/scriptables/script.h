@@ -37,6 +37,7 @@
 namespace Wintermute {
 class BaseScriptHolder;
 class BaseObject;
+class ScCompiledScript;
 class ScEngine;
 class ScStack;
 class ScValue;
@@ -132,10 +133,10 @@ public:
 	uint32 getDWORD();
 	double getFloat();
 	void cleanup();
-	bool create(const char *filename, byte *buffer, uint32 size, BaseScriptHolder *owner);
+	bool create(const char *filename, ScCompiledScript *compiled, BaseScriptHolder *owner);
 	uint32 _iP;
 private:
-	void readHeader();
+	ScCompiledScript *_compiled;
 	uint32 _bufferSize;
 	byte *_buffer;
 public:
@@ -174,6 +175,49 @@ private:
 #endif
 };
 
+/**
+ * The bytecode of a script and its parsed tables.
+ *
+ * It is shared by all the instances and threads of the script, and by the
+ * script cache of ScEngine, and is deleted when the last of them releases it.
+ * The tables point into the bytecode, and neither is modified once loaded.
+ */
+class ScCompiledScript {
+public:
+	// Takes ownership of the buffer, which must be allocated with new[]
+	ScCompiledScript(byte *buffer, uint32 size);
+	~ScCompiledScript();
+
+	void incRef() {
+		_refCount++;
+	}
+	void decRef();
+
+	void initTables();
+
+	byte *_buffer;
+	uint32 _size;
+	ScScript::TScriptHeader _header;
+
+	char **_symbols;
+	uint32 _numSymbols;
+	ScScript::TFunctionPos *_functions;
+	uint32 _numFunctions;
+	ScScript::TMethodPos *_methods;
+	uint32 _numMethods;
+	ScScript::TEventPos *_events;
+	uint32 _numEvents;
+	ScScript::TExternalFunction *_externals;
+	uint32 _numExternals;
+
+private:
+	uint32 readDWORD(uint32 &pos) const;
+	char *readString(uint32 &pos) const;
+
+	int32 _refCount;
+	bool _tablesLoaded;
+};
+
 } // End of namespace Wintermute
 
 #endif
@@ -74,9 +74,8 @@ ScEngine::ScEngine(BaseGame *inGame) : BaseClass(inGame) {
 	}
 
 	// prepare script cache
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		_cachedScripts[i] = nullptr;
-	}
+	_cachedScriptsSize = 0;
+	_cacheAccessCounter = 0;
 
 	_currentScript = nullptr;
 
@@ -140,12 +139,9 @@ void ScEngine::parseElement(void *data, int line, int type, void *elementData) {
 
 //////////////////////////////////////////////////////////////////////////
 ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
-	byte *compBuffer;
-	uint32 compSize;
-
 	// get script from cache
-	compBuffer = getCompiledScript(filename, &compSize);
-	if (!compBuffer) {
+	ScCompiledScript *compiled = getCompiledScript(filename);
+	if (!compiled) {
 		return nullptr;
 	}
 
@@ -159,7 +155,8 @@ ScScript *ScEngine::runScript(const char *filename, BaseScriptHolder *owner) {
 #else
 	ScScript *script = new ScScript(_gameRef, this);
 #endif
-	bool ret = script->create(filename, compBuffer, compSize, owner);
+	bool ret = script->create(filename, compiled, owner);
+	compiled->decRef();
 	if (DID_FAIL(ret)) {
 		_gameRef->LOG(ret, "Error running script '%s'...", filename);
 		delete script;
@@ -195,22 +192,18 @@ bool ScEngine::isRunningScript(const char *filename) {
 
 
 //////////////////////////////////////////////////////////////////////////
-byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache) {
+ScCompiledScript *ScEngine::getCompiledScript(const char *filename, bool ignoreCache) {
 	// is script in cache?
 	if (!ignoreCache) {
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] && scumm_stricmp(_cachedScripts[i]->_filename.c_str(), filename) == 0) {
-				_cachedScripts[i]->_timestamp = g_system->getMillis();
-				*outSize = _cachedScripts[i]->_size;
-				return _cachedScripts[i]->_buffer;
-			}
+		CachedScripts::iterator it = _cachedScripts.find(filename);
+		if (it != _cachedScripts.end()) {
+			it->_value._lastAccess = _cacheAccessCounter++;
+			it->_value._script->incRef();
+			return it->_value._script;
 		}
 	}
 
 	// nope, load it
-	byte *compBuffer;
-	uint32 compSize;
-
 	uint32 size;
 
 	byte *buffer = BaseEngine::instance().getFileManager()->readWholeFile(filename, &size);
@@ -220,10 +213,7 @@ byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ig
 	}
 
 	// needs to be compiled?
-	if (FROM_LE_32(*(uint32 *)buffer) == SCRIPT_MAGIC) {
-		compBuffer = buffer;
-		compSize = size;
-	} else {
+	if (size < sizeof(uint32) || FROM_LE_32(*(uint32 *)buffer) != SCRIPT_MAGIC) {
 		if (!_compilerAvailable) {
 			_gameRef->LOG(0, "ScEngine::GetCompiledScript - script '%s' needs to be compiled but compiler is not available", filename);
 			delete[] buffer;
@@ -234,37 +224,49 @@ byte *ScEngine::getCompiledScript(const char *filename, uint32 *outSize, bool ig
 		error("Script needs compilation, ScummVM does not contain a WME compiler");
 	}
 
-	byte *ret = nullptr;
-
-	// add script to cache
-	CScCachedScript *cachedScript = new CScCachedScript(filename, compBuffer, compSize);
-	if (cachedScript) {
-		int index = 0;
-		uint32 minTime = g_system->getMillis();
-		for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-			if (_cachedScripts[i] == nullptr) {
-				index = i;
-				break;
-			} else if (_cachedScripts[i]->_timestamp <= minTime) {
-				minTime = _cachedScripts[i]->_timestamp;
-				index = i;
-			}
-		}
+	// the script takes over the buffer
+	ScCompiledScript *compiled = new ScCompiledScript(buffer, size);
+
+	// add script to cache, scripts too large for it are only shared by
+	// the instances running them
+	CachedScripts::iterator it = _cachedScripts.find(filename);
+	if (it != _cachedScripts.end()) {
+		_cachedScriptsSize -= it->_value._script->_size;
+		it->_value._script->decRef();
+		_cachedScripts.erase(it);
+	}
 
-		if (_cachedScripts[index] != nullptr) {
-			delete _cachedScripts[index];
+	if (size <= SCRIPT_CACHE_SIZE) {
+		while (_cachedScriptsSize + size > SCRIPT_CACHE_SIZE) {
+			dropOldestCachedScript();
 		}
-		_cachedScripts[index] = cachedScript;
 
-		ret = cachedScript->_buffer;
-		*outSize = cachedScript->_size;
+		CachedScript cachedScript;
+		cachedScript._script = compiled;
+		cachedScript._lastAccess = _cacheAccessCounter++;
+		_cachedScripts[filename] = cachedScript;
+		_cachedScriptsSize += size;
+
+		compiled->incRef();
 	}
 
+	return compiled;
+}
+
 
-	// cleanup
-	delete[] buffer;
+//////////////////////////////////////////////////////////////////////////
+void ScEngine::dropOldestCachedScript() {
+	CachedScripts::iterator oldest = _cachedScripts.begin();
+	for (CachedScripts::iterator it = _cachedScripts.begin(); it != _cachedScripts.end(); ++it) {
+		if (it->_value._lastAccess < oldest->_value._lastAccess) {
+			oldest = it;
+		}
+	}
 
-	return ret;
+	// running instances keep the script alive
+	_cachedScriptsSize -= oldest->_value._script->_size;
+	oldest->_value._script->decRef();
+	_cachedScripts.erase(oldest);
 }
 
 
@@ -479,12 +481,11 @@ int ScEngine::getNumScripts(int *running, int *waiting, int *persistent) {
 
 //////////////////////////////////////////////////////////////////////////
 bool ScEngine::emptyScriptCache() {
-	for (int i = 0; i < MAX_CACHED_SCRIPTS; i++) {
-		if (_cachedScripts[i]) {
-			delete _cachedScripts[i];
-			_cachedScripts[i] = nullptr;
-		}
+	for (CachedScripts::iterator it = _cachedScripts.begin(); it != _cachedScripts.end(); ++it) {
+		it->_value._script->decRef();
 	}
+	_cachedScripts.clear();
+	_cachedScriptsSize = 0;
 	return STATUS_OK;
 }
 
@@ -31,38 +31,22 @@
 #include "engines/wintermute/persistent.h"
 #include "engines/wintermute/coll_templ.h"
 #include "engines/wintermute/base/base.h"
+#include "common/hash-str.h"
 
 namespace Wintermute {
 
-#define MAX_CACHED_SCRIPTS 20
+// maximum size of the bytecode kept in the script cache
+#define SCRIPT_CACHE_SIZE (2 * 1024 * 1024)
+class ScCompiledScript;
 class ScScript;
 class ScValue;
 class BaseObject;
 class BaseScriptHolder;
 class ScEngine : public BaseClass {
 public:
-	class CScCachedScript {
-	public:
-		CScCachedScript(const char *filename, byte *buffer, uint32 size) {
-			_timestamp = g_system->getMillis();
-			_buffer = new byte[size];
-			if (_buffer) {
-				memcpy(_buffer, buffer, size);
-			}
-			_size = size;
-			_filename = filename;
-		};
-
-		~CScCachedScript() {
-			if (_buffer) {
-				delete[] _buffer;
-			}
-		};
-
-		uint32 _timestamp;
-		byte *_buffer;
-		uint32 _size;
-		Common::String _filename;
+	struct CachedScript {
+		ScCompiledScript *_script;
+		uint32 _lastAccess;
 	};
 
 public:
@@ -78,7 +62,8 @@ public:
 	bool resetObject(BaseObject *Object);
 	bool resetScript(ScScript *script);
 	bool emptyScriptCache();
-	byte *getCompiledScript(const char *filename, uint32 *outSize, bool ignoreCache = false);
+	// the caller owns a reference to the returned script, see ScCompiledScript::decRef()
+	ScCompiledScript *getCompiledScript(const char *filename, bool ignoreCache = false);
 	DECLARE_PERSISTENT(ScEngine, BaseClass)
 	bool cleanup();
 	int getNumScripts(int *running = nullptr, int *waiting = nullptr, int *persistent = nullptr);
@@ -107,7 +92,12 @@ public:
 
 private:
 
-	CScCachedScript *_cachedScripts[MAX_CACHED_SCRIPTS];
+	typedef Common::HashMap<Common::String, CachedScript, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> CachedScripts;
+	CachedScripts _cachedScripts;
+	uint32 _cachedScriptsSize;
+	uint32 _cacheAccessCounter;
+
+	void dropOldestCachedScript();
 	bool _isProfiling;
 	uint32 _profilingStartTime;
 
@@ -271,6 +271,11 @@ bool ScValue::propExists(const char *name) {
 
 //////////////////////////////////////////////////////////////////////////
 void ScValue::deleteProps() {
+	// most values are not objects, don't walk their empty table
+	if (_valObject.empty()) {
+		return;
+	}
+
 	_valIter = _valObject.begin();
 	while (_valIter != _valObject.end()) {
 		delete(ScValue *)_valIter->_value;
@@ -723,7 +728,10 @@ void ScValue::copy(ScValue *orig, bool copyWhole) {
 	_valBool = orig->_valBool;
 	_valInt = orig->_valInt;
 	_valFloat = orig->_valFloat;
-	setStringVal(orig->_valString);
+	// only strings keep their text, the other types rebuild it in getString()
+	if (orig->_type == VAL_STRING) {
+		setStringVal(orig->_valString);
+	}
 
 	_valRef = orig->_valRef;
 	_persistent = orig->_persistent;
@@ -895,6 +903,20 @@ bool ScValue::saveAsText(BaseDynamicBuffer *buffer, int indent) {
 //////////////////////////////////////////////////////////////////////////
 // -1 ... left is less, 0 ... equals, 1 ... left is greater
 int ScValue::compare(ScValue *val1, ScValue *val2) {
+	// both numbers or booleans? same result as the generic code below
+	// without going through the type checks
+	if (val1->isScalar() && val2->isScalar()) {
+		if (val1->_type == VAL_FLOAT || val2->_type == VAL_FLOAT) {
+			double f1 = val1->getFloat();
+			double f2 = val2->getFloat();
+			return (f1 < f2) ? -1 : ((f1 > f2) ? 1 : 0);
+		} else {
+			int i1 = val1->getInt();
+			int i2 = val2->getInt();
+			return (i1 < i2) ? -1 : ((i1 > i2) ? 1 : 0);
+		}
+	}
+
 	// both natives?
 	if (val1->isNative() && val2->isNative()) {
 		// same class?
@@ -80,6 +80,10 @@ public:
 	bool isFloat();
 	bool isInt();
 	bool isObject();
+	// int, float or bool, held in the value itself rather than referenced
+	bool isScalar() const {
+		return _type == VAL_INT || _type == VAL_FLOAT || _type == VAL_BOOL;
+	}
 	bool setProp(const char *name, ScValue *val, bool copyWhole = false, bool setAsConst = false);
 	ScValue *getProp(const char *name);
 	BaseScriptable *_valNative;
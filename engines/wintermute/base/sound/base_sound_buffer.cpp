@@ -30,6 +30,7 @@
 #include "engines/wintermute/base/sound/base_sound_buffer.h"
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/wintermute.h"
+#include "audio/audio_cache.h"
 #include "audio/audiostream.h"
 #include "audio/mixer.h"
 #ifdef USE_VORBIS
@@ -37,6 +38,7 @@
 #endif
 #include "audio/decoders/wave.h"
 #include "audio/decoders/raw.h"
+#include "common/config-manager.h"
 #include "common/system.h"
 #include "common/substream.h"
 
@@ -95,6 +97,17 @@ void BaseSoundBuffer::setStreaming(bool streamed, uint32 numBlocks, uint32 block
 bool BaseSoundBuffer::loadFromFile(const Common::String &filename, bool forceReload) {
 	debugC(kWintermuteDebugAudio, "BSoundBuffer::LoadFromFile(%s,%d)", filename.c_str(), forceReload);
 
+	// Sound effects are played over and over, keep them decoded. The files
+	// of different games share names, so the target is part of the key.
+	const Common::String cacheKey = Audio::AudioCache::makeKey(Common::Path(filename), "wintermute:" + ConfMan.getActiveDomainName());
+	if (!_streamed && !forceReload) {
+		_stream = Audio::AudioCache::instance().open(cacheKey);
+		if (_stream) {
+			_filename = filename;
+			return STATUS_OK;
+		}
+	}
+
 	// Load a file, but avoid having the File-manager handle the disposal of it.
 	_file = BaseFileManager::getEngineInstance()->openFile(filename, true, false);
 	if (!_file) {
@@ -129,6 +142,9 @@ bool BaseSoundBuffer::loadFromFile(const Common::String &filename, bool forceRel
 	if (!_stream) {
 		return STATUS_FAILED;
 	}
+	if (!_streamed) {
+		_stream = Audio::AudioCache::instance().add(cacheKey, _stream);
+	}
 	_filename = filename;
 
 	return STATUS_OK;
@@ -50,11 +50,11 @@ DebuggerController::DebuggerController(WintermuteEngine *vm) : _engine(vm) {
 }
 
 bool DebuggerController::bytecodeExists(const Common::String &filename) {
-	uint32 compSize;
-	byte *compBuffer = SCENGINE->getCompiledScript(filename.c_str(), &compSize);
-	if (!compBuffer) {
+	ScCompiledScript *compiled = SCENGINE->getCompiledScript(filename.c_str());
+	if (!compiled) {
 		return false;
 	} else {
+		compiled->decRef();
 		return true;
 	}
 }
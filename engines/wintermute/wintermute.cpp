@@ -21,6 +21,8 @@
 
 #include "common/scummsys.h"
 
+#include "audio/audio_cache.h"
+
 #include "common/config-manager.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
@@ -79,6 +81,9 @@ WintermuteEngine::~WintermuteEngine() {
 	deinit();
 	delete _game;
 	//_debugger deleted by Engine
+
+	// Don't keep the sounds of this game around once it is closed
+	Audio::AudioCache::instance().clear();
 }
 
 bool WintermuteEngine::hasFeature(EngineFeature f) const {
@@ -0,0 +1,265 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Fixed-point SSE2 implementation of the YUV to RGB conversion. The chroma
+// multipliers and the ITU-R BT.601 rescale have been chosen so that the result
+// is bit-exact with the lookup tables built by YUVToRGBLookup, which truncate
+// the floating point products towards zero.
+
+#include "common/scummsys.h"
+#include "common/endian.h"
+
+#include "graphics/yuv_to_rgb.h"
+
+#include <emmintrin.h>
+
+#ifdef __GNUC__
+#pragma GCC push_options
+
+#ifndef __x86_64__
+#pragma GCC target("sse2")
+#endif
+
+#endif
+
+namespace Graphics {
+
+namespace {
+
+struct YUVChroma {
+	__m128i crR;
+	__m128i crbG;
+	__m128i cbB;
+};
+
+struct YUVFormat {
+	__m128i rLoss, gLoss, bLoss, aLoss;
+	__m128i rShift, gShift, bShift, aShift;
+
+	YUVFormat(const Graphics::PixelFormat &format) {
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+	}
+};
+
+// Apply the sign mask of the original chroma value to an unsigned product,
+// which gives the same truncation towards zero as the (int16) casts used
+// when building the lookup tables.
+static FORCEINLINE __m128i applySign(__m128i value, __m128i sign) {
+	return _mm_sub_epi16(_mm_xor_si128(value, sign), sign);
+}
+
+// u and v hold eight 16-bit chroma samples in the range [0, 255]
+static FORCEINLINE void computeChroma(YUVChroma &c, __m128i u, __m128i v) {
+	const __m128i zero = _mm_setzero_si128();
+
+	__m128i cr = _mm_sub_epi16(v, _mm_set1_epi16(128));
+	__m128i cb = _mm_sub_epi16(u, _mm_set1_epi16(128));
+	__m128i crSign = _mm_cmplt_epi16(cr, zero);
+	__m128i cbSign = _mm_cmplt_epi16(cb, zero);
+	__m128i crAbs = applySign(cr, crSign);
+	__m128i cbAbs = applySign(cb, cbSign);
+
+	// (0.419 / 0.299), (0.299 / 0.419), (0.114 / 0.331) and (0.587 / 0.331)
+	__m128i crR  = _mm_mulhi_epu16(_mm_slli_epi16(crAbs, 1), _mm_set1_epi16((short)45876));
+	__m128i crG  = _mm_mulhi_epu16(crAbs, _mm_set1_epi16((short)46735));
+	__m128i cbG  = _mm_mulhi_epu16(cbAbs, _mm_set1_epi16((short)22562));
+	__m128i cbB  = _mm_mulhi_epu16(_mm_slli_epi16(cbAbs, 1), _mm_set1_epi16((short)58109));
+
+	c.crR = applySign(crR, crSign);
+	c.crbG = _mm_sub_epi16(zero, _mm_add_epi16(applySign(crG, crSign), applySign(cbG, cbSign)));
+	c.cbB = applySign(cbB, cbSign);
+}
+
+template<YUVToRGBManager::LuminanceScale scale>
+static FORCEINLINE __m128i clipComponent(__m128i value) {
+	if (scale == YUVToRGBManager::kScaleITU) {
+		// (value - 16) * 255 / 219, clamped to the [16, 235] range
+		value = _mm_min_epi16(_mm_max_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		value = _mm_mullo_epi16(_mm_sub_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(255));
+		return _mm_srli_epi16(_mm_mulhi_epu16(value, _mm_set1_epi16((short)19153)), 6);
+	}
+
+	return _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), _mm_set1_epi16(255));
+}
+
+// Convert and store eight pixels. y and a hold 16-bit samples in the range [0, 255].
+template<typename PixelInt, YUVToRGBManager::LuminanceScale scale>
+static FORCEINLINE void putPixels(byte *dst, __m128i y, __m128i a, const YUVChroma &c, const YUVFormat &f) {
+	__m128i r = _mm_srl_epi16(clipComponent<scale>(_mm_add_epi16(y, c.crR)), f.rLoss);
+	__m128i g = _mm_srl_epi16(clipComponent<scale>(_mm_add_epi16(y, c.crbG)), f.gLoss);
+	__m128i b = _mm_srl_epi16(clipComponent<scale>(_mm_add_epi16(y, c.cbB)), f.bLoss);
+	a = _mm_srl_epi16(a, f.aLoss);
+
+	if (sizeof(PixelInt) == 2) {
+		__m128i pixels = _mm_or_si128(
+			_mm_or_si128(_mm_sll_epi16(r, f.rShift), _mm_sll_epi16(g, f.gShift)),
+			_mm_or_si128(_mm_sll_epi16(b, f.bShift), _mm_sll_epi16(a, f.aShift)));
+		_mm_storeu_si128((__m128i *)dst, pixels);
+	} else {
+		const __m128i zero = _mm_setzero_si128();
+
+		__m128i lo = _mm_or_si128(
+			_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(r, zero), f.rShift), _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), f.gShift)),
+			_mm_or_si128(_mm_sll_epi32(_mm_unpacklo_epi16(b, zero), f.bShift), _mm_sll_epi32(_mm_unpacklo_epi16(a, zero), f.aShift)));
+		__m128i hi = _mm_or_si128(
+			_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(r, zero), f.rShift), _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), f.gShift)),
+			_mm_or_si128(_mm_sll_epi32(_mm_unpackhi_epi16(b, zero), f.bShift), _mm_sll_epi32(_mm_unpackhi_epi16(a, zero), f.aShift)));
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 16), hi);
+	}
+}
+
+static FORCEINLINE __m128i load8(const byte *src) {
+	return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)src), _mm_setzero_si128());
+}
+
+// Load four chroma samples and duplicate each one horizontally
+static FORCEINLINE __m128i load4x2(const byte *src) {
+	__m128i value = _mm_unpacklo_epi8(_mm_cvtsi32_si128(READ_UINT32(src)), _mm_setzero_si128());
+	return _mm_unpacklo_epi16(value, value);
+}
+
+template<typename PixelInt, YUVToRGBManager::LuminanceScale scale>
+void convertYUV444ToRGB_SSE2(byte *dstPtr, int dstPitch, const YUVFormat &f, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const __m128i opaque = _mm_set1_epi16(255);
+	YUVChroma c;
+
+	for (int h = 0; h < yHeight; h++) {
+		for (int w = 0; w < yWidth; w += 8) {
+			computeChroma(c, load8(uSrc + w), load8(vSrc + w));
+			putPixels<PixelInt, scale>(dstPtr + w * sizeof(PixelInt), load8(ySrc + w), opaque, c, f);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt, YUVToRGBManager::LuminanceScale scale>
+void convertYUV422ToRGB_SSE2(byte *dstPtr, int dstPitch, const YUVFormat &f, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const __m128i opaque = _mm_set1_epi16(255);
+	YUVChroma c;
+
+	for (int h = 0; h < yHeight; h++) {
+		for (int w = 0; w < yWidth; w += 8) {
+			computeChroma(c, load4x2(uSrc + (w >> 1)), load4x2(vSrc + (w >> 1)));
+			putPixels<PixelInt, scale>(dstPtr + w * sizeof(PixelInt), load8(ySrc + w), opaque, c, f);
+		}
+
+		dstPtr += dstPitch;
+		ySrc += yPitch;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+template<typename PixelInt, YUVToRGBManager::LuminanceScale scale>
+void convertYUV420ToRGB_SSE2(byte *dstPtr, int dstPitch, const YUVFormat &f, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	const __m128i opaque = _mm_set1_epi16(255);
+	YUVChroma c;
+
+	for (int h = 0; h < yHeight; h += 2) {
+		for (int w = 0; w < yWidth; w += 8) {
+			byte *dst = dstPtr + w * sizeof(PixelInt);
+
+			computeChroma(c, load4x2(uSrc + (w >> 1)), load4x2(vSrc + (w >> 1)));
+			if (aSrc) {
+				putPixels<PixelInt, scale>(dst, load8(ySrc + w), load8(aSrc + w), c, f);
+				putPixels<PixelInt, scale>(dst + dstPitch, load8(ySrc + yPitch + w), load8(aSrc + yPitch + w), c, f);
+			} else {
+				putPixels<PixelInt, scale>(dst, load8(ySrc + w), opaque, c, f);
+				putPixels<PixelInt, scale>(dst + dstPitch, load8(ySrc + yPitch + w), opaque, c, f);
+			}
+		}
+
+		dstPtr += dstPitch << 1;
+		ySrc += yPitch << 1;
+		if (aSrc)
+			aSrc += yPitch << 1;
+		uSrc += uvPitch;
+		vSrc += uvPitch;
+	}
+}
+
+} // End of anonymous namespace
+
+void YUVToRGBManager::convert444SSE2(byte *dstPtr, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVFormat f(format);
+
+	if (format.bytesPerPixel == 2) {
+		if (scale == kScaleITU)
+			convertYUV444ToRGB_SSE2<uint16, kScaleITU>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV444ToRGB_SSE2<uint16, kScaleFull>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	} else {
+		if (scale == kScaleITU)
+			convertYUV444ToRGB_SSE2<uint32, kScaleITU>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV444ToRGB_SSE2<uint32, kScaleFull>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	}
+}
+
+void YUVToRGBManager::convert422SSE2(byte *dstPtr, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVFormat f(format);
+
+	if (format.bytesPerPixel == 2) {
+		if (scale == kScaleITU)
+			convertYUV422ToRGB_SSE2<uint16, kScaleITU>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV422ToRGB_SSE2<uint16, kScaleFull>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	} else {
+		if (scale == kScaleITU)
+			convertYUV422ToRGB_SSE2<uint32, kScaleITU>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV422ToRGB_SSE2<uint32, kScaleFull>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+	}
+}
+
+void YUVToRGBManager::convert420SSE2(byte *dstPtr, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+	YUVFormat f(format);
+
+	if (format.bytesPerPixel == 2) {
+		if (scale == kScaleITU)
+			convertYUV420ToRGB_SSE2<uint16, kScaleITU>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV420ToRGB_SSE2<uint16, kScaleFull>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+	} else {
+		if (scale == kScaleITU)
+			convertYUV420ToRGB_SSE2<uint32, kScaleITU>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		else
+			convertYUV420ToRGB_SSE2<uint32, kScaleFull>(dstPtr, dstPitch, f, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+	}
+}
+
+} // End of namespace Graphics
+
+#ifdef __GNUC__
+#pragma GCC pop_options
+#endif
@@ -82,6 +82,8 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "common/system.h"
+
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
 
@@ -183,13 +185,35 @@ YUVToRGBLookup::YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::Lu
 
 YUVToRGBManager::YUVToRGBManager() {
 	_lookup = 0;
+	_useSIMD = false;
+	_simdDetected = false;
 }
 
 YUVToRGBManager::~YUVToRGBManager() {
 	delete _lookup;
 }
 
+void YUVToRGBManager::setSIMDEnabled(bool enable) {
+#ifdef SCUMMVM_SSE2
+	_useSIMD = enable;
+#endif
+	_simdDetected = true;
+}
+
+void YUVToRGBManager::resetSIMDEnabled() {
+	_useSIMD = false;
+	_simdDetected = false;
+}
+
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale) {
+	// The CPU features are queried on first use, when the backend is fully set up
+	if (!_simdDetected) {
+#ifdef SCUMMVM_SSE2
+		_useSIMD = g_system->hasFeature(OSystem::kFeatureCpuSSE2);
+#endif
+		_simdDetected = true;
+	}
+
 	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale)
 		return _lookup;
 
@@ -245,12 +269,29 @@ void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert(ySrc && uSrc && vSrc);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	byte *dstPtr = (byte *)dst->getPixels();
+
+#ifdef SCUMMVM_SSE2
+	// Convert blocks of eight pixels with SSE2 and leave the rest to the table path
+	if (_useSIMD && yWidth >= 8) {
+		int simdWidth = yWidth & ~7;
+		convert444SSE2(dstPtr, dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, simdWidth, yHeight, yPitch, uvPitch);
+
+		dstPtr += simdWidth * dst->format.bytesPerPixel;
+		ySrc += simdWidth;
+		uSrc += simdWidth;
+		vSrc += simdWidth;
+		yWidth -= simdWidth;
+		if (yWidth == 0)
+			return;
+	}
+#endif
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint16>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV444ToRGB<uint32>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
@@ -302,12 +343,29 @@ void YUVToRGBManager::convert422(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	byte *dstPtr = (byte *)dst->getPixels();
+
+#ifdef SCUMMVM_SSE2
+	// Convert blocks of eight pixels with SSE2 and leave the rest to the table path
+	if (_useSIMD && yWidth >= 8) {
+		int simdWidth = yWidth & ~7;
+		convert422SSE2(dstPtr, dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, simdWidth, yHeight, yPitch, uvPitch);
+
+		dstPtr += simdWidth * dst->format.bytesPerPixel;
+		ySrc += simdWidth;
+		uSrc += simdWidth >> 1;
+		vSrc += simdWidth >> 1;
+		yWidth -= simdWidth;
+		if (yWidth == 0)
+			return;
+	}
+#endif
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV422ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint16>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV422ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV422ToRGB<uint32>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 template<typename PixelInt>
@@ -347,7 +405,7 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
 		vSrc += uvPitch - halfWidth;
@@ -363,12 +421,29 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	byte *dstPtr = (byte *)dst->getPixels();
+
+#ifdef SCUMMVM_SSE2
+	// Convert blocks of eight pixels with SSE2 and leave the rest to the table path
+	if (_useSIMD && yWidth >= 8) {
+		int simdWidth = yWidth & ~7;
+		convert420SSE2(dstPtr, dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, nullptr, simdWidth, yHeight, yPitch, uvPitch);
+
+		dstPtr += simdWidth * dst->format.bytesPerPixel;
+		ySrc += simdWidth;
+		uSrc += simdWidth >> 1;
+		vSrc += simdWidth >> 1;
+		yWidth -= simdWidth;
+		if (yWidth == 0)
+			return;
+	}
+#endif
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint16>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUV420ToRGB<uint32>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 #define PUT_PIXELA(s, a, d) \
@@ -415,7 +490,7 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *look
 			dstPtr += sizeof(PixelInt);
 		}
 
-		dstPtr += dstPitch;
+		dstPtr += (dstPitch << 1) - yWidth * sizeof(PixelInt);
 		ySrc += (yPitch << 1) - yWidth;
 		aSrc += (yPitch << 1) - yWidth;
 		uSrc += uvPitch - halfWidth;
@@ -432,12 +507,30 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yHeight & 1) == 0);
 
 	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	byte *dstPtr = (byte *)dst->getPixels();
+
+#ifdef SCUMMVM_SSE2
+	// Convert blocks of eight pixels with SSE2 and leave the rest to the table path
+	if (_useSIMD && yWidth >= 8) {
+		int simdWidth = yWidth & ~7;
+		convert420SSE2(dstPtr, dst->pitch, dst->format, scale, ySrc, uSrc, vSrc, aSrc, simdWidth, yHeight, yPitch, uvPitch);
+
+		dstPtr += simdWidth * dst->format.bytesPerPixel;
+		ySrc += simdWidth;
+		aSrc += simdWidth;
+		uSrc += simdWidth >> 1;
+		vSrc += simdWidth >> 1;
+		yWidth -= simdWidth;
+		if (yWidth == 0)
+			return;
+	}
+#endif
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint16>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
 	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		convertYUVA420ToRGBA<uint32>(dstPtr, dst->pitch, lookup, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
 }
 
 #define READ_QUAD(ptr, prefix) \
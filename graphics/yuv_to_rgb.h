@@ -135,6 +135,21 @@ public:
 	 */
 	void convert410(Graphics::Surface *dst, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
 
+	/**
+	 * Enable or disable the SIMD conversion paths.
+	 *
+	 * By default, they are used whenever the CPU supports them. The SIMD paths
+	 * are bit-exact with the lookup table implementation, so this is mainly
+	 * useful for testing and benchmarking.
+	 */
+	void setSIMDEnabled(bool enable);
+
+	/**
+	 * Go back to using the SIMD paths whenever the CPU supports them, undoing
+	 * setSIMDEnabled(). The CPU features are queried again on next use.
+	 */
+	void resetSIMDEnabled();
+
 private:
 	friend class Common::Singleton<SingletonBaseType>;
 	YUVToRGBManager();
@@ -143,6 +158,14 @@ private:
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale);
 
 	YUVToRGBLookup *_lookup;
+	bool _useSIMD;
+	bool _simdDetected;
+
+#ifdef SCUMMVM_SSE2
+	static void convert444SSE2(byte *dstPtr, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+	static void convert422SSE2(byte *dstPtr, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+	static void convert420SSE2(byte *dstPtr, int dstPitch, const Graphics::PixelFormat &format, LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch);
+#endif
 };
  /** @} */
 } // End of namespace Graphics
@@ -31,7 +31,10 @@ DECLARE_SINGLETON(GUI::EventRecorder);
 #include "common/debug-channels.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/mixer/mixer.h"
+#include "common/algorithm.h"
 #include "common/config-manager.h"
+#include "common/file.h"
+#include "common/formats/json.h"
 #include "common/md5.h"
 #include "gui/gui-manager.h"
 #include "gui/widget.h"
@@ -78,6 +81,9 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_benchmark = false;
+	_benchmarkFrameStart = 0;
+	_benchmarkBackendStart = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -88,6 +94,9 @@ void EventRecorder::deinit() {
 	if (!_initialized) {
 		return;
 	}
+	if (_benchmark) {
+		writeBenchmarkReport();
+	}
 	setFileHeader();
 	_needRedraw = false;
 	_initialized = false;
@@ -161,7 +170,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +227,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -260,7 +269,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				_nextEvent = getNextEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -271,7 +280,7 @@ void EventRecorder::processScreenUpdate() {
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -282,6 +291,10 @@ void EventRecorder::processScreenUpdate() {
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
+		// Everything up to here belongs to the engine's frame
+		if (_benchmark) {
+			_benchmarkBackendStart = getBenchmarkTime();
+		}
 		break;
 	default:
 		break;
@@ -308,7 +321,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	_nextEvent = getNextEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -415,7 +428,7 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		_nextEvent = getNextEvent();
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
@@ -425,6 +438,101 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	switchTimerManagers();
 	_needRedraw = true;
 	_initialized = true;
+	_benchmarkFrameStart = getBenchmarkTime();
+}
+
+void EventRecorder::enableBenchmark(const Common::String &reportFileName) {
+	_benchmark = true;
+	_benchmarkFileName = reportFileName;
+	_benchmarkFrames.clear();
+	_fastPlayback = true;
+
+	// Render into an offscreen surface instead of the window
+	ConfMan.setBool("disable_display", true, Common::ConfigManager::kTransientDomain);
+}
+
+uint64 EventRecorder::getBenchmarkTime() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const uint64 counter = SDL_GetPerformanceCounter();
+	const uint64 frequency = SDL_GetPerformanceFrequency();
+	return (counter / frequency) * 1000000 + (counter % frequency) * 1000000 / frequency;
+#else
+	return (uint64)SDL_GetTicks() * 1000;
+#endif
+}
+
+Common::RecorderEvent EventRecorder::getNextEvent() {
+	// The playback file quits the application once it runs out of events,
+	// so the report has to be written before
+	if (_benchmark && !_playbackFile->hasNextEvent()) {
+		writeBenchmarkReport();
+	}
+	return _playbackFile->getNextEvent();
+}
+
+/**
+ * Quotes and escapes a string for the benchmark report, using the same
+ * rules as Common::JSONValue so that the output is always valid JSON.
+ */
+static Common::String jsonString(const Common::String &str) {
+	return Common::JSONValue(str).stringify();
+}
+
+void EventRecorder::writeBenchmarkReport() {
+	_benchmark = false;
+
+	Common::DumpFile report;
+	if (!report.open(Common::Path(_benchmarkFileName, Common::Path::kNativeSeparator))) {
+		warning("benchmark:action=error reason=\"Could not write report file %s\"", _benchmarkFileName.c_str());
+		return;
+	}
+
+	Common::Array<uint32> frameTimes;
+	uint64 totalTime = 0, engineTime = 0, backendTime = 0;
+	for (uint i = 0; i < _benchmarkFrames.size(); i++) {
+		const BenchmarkFrame &frame = _benchmarkFrames[i];
+		frameTimes.push_back(frame.engineTime + frame.backendTime);
+		engineTime += frame.engineTime;
+		backendTime += frame.backendTime;
+	}
+	totalTime = engineTime + backendTime;
+
+	Common::sort(frameTimes.begin(), frameTimes.end());
+	const uint numFrames = frameTimes.size();
+	// Nearest-rank percentiles
+	const uint32 p95 = numFrames ? frameTimes[(numFrames * 95 + 99) / 100 - 1] : 0;
+	const uint32 p99 = numFrames ? frameTimes[(numFrames * 99 + 99) / 100 - 1] : 0;
+	const uint32 maxTime = numFrames ? frameTimes[numFrames - 1] : 0;
+	const uint32 mean = numFrames ? (uint32)(totalTime / numFrames) : 0;
+
+	const Common::String recording = _playbackFile ? _playbackFile->getHeader().name : Common::String();
+
+	report.writeString("{\n");
+	report.writeString(Common::String::format("\t\"recording\": %s,\n", jsonString(recording).c_str()));
+	report.writeString(Common::String::format("\t\"target\": %s,\n", jsonString(ConfMan.getActiveDomainName()).c_str()));
+	report.writeString("\t\"summary\": {\n");
+	report.writeString(Common::String::format("\t\t\"frames\": %u,\n", numFrames));
+	report.writeString(Common::String::format("\t\t\"total_us\": %llu,\n", (unsigned long long)totalTime));
+	report.writeString(Common::String::format("\t\t\"engine_us\": %llu,\n", (unsigned long long)engineTime));
+	report.writeString(Common::String::format("\t\t\"backend_us\": %llu,\n", (unsigned long long)backendTime));
+	report.writeString(Common::String::format("\t\t\"mean_us\": %u,\n", mean));
+	report.writeString(Common::String::format("\t\t\"p95_us\": %u,\n", p95));
+	report.writeString(Common::String::format("\t\t\"p99_us\": %u,\n", p99));
+	report.writeString(Common::String::format("\t\t\"max_us\": %u\n", maxTime));
+	report.writeString("\t},\n");
+	report.writeString("\t\"frames\": [\n");
+	for (uint i = 0; i < _benchmarkFrames.size(); i++) {
+		const BenchmarkFrame &frame = _benchmarkFrames[i];
+		report.writeString(Common::String::format("\t\t{ \"engine_us\": %u, \"backend_us\": %u }%s\n",
+			frame.engineTime, frame.backendTime, (i + 1 < _benchmarkFrames.size()) ? "," : ""));
+	}
+	report.writeString("\t]\n");
+	report.writeString("}\n");
+	report.finalize();
+	report.close();
+
+	debugC(1, kDebugLevelEventRec, "benchmark:action=report frames=%u mean=%u p95=%u p99=%u", numFrames, mean, p95, p99);
+	_benchmarkFrames.clear();
 }
 
 
@@ -699,7 +807,8 @@ Common::SaveFileManager *EventRecorder::getSaveManager(Common::SaveFileManager *
 }
 
 void EventRecorder::preDrawOverlayGui() {
-	if ((_initialized) || (_needRedraw)) {
+	// The control panel is not shown while benchmarking
+	if (((_initialized) || (_needRedraw)) && !_benchmark) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
 		g_system->showOverlay();
@@ -716,7 +825,17 @@ void EventRecorder::preDrawOverlayGui() {
 }
 
 void EventRecorder::postDrawOverlayGui() {
-	if ((_initialized) || (_needRedraw)) {
+	if (_benchmark && _initialized && _benchmarkBackendStart) {
+		const uint64 now = getBenchmarkTime();
+		BenchmarkFrame frame;
+		frame.engineTime = (uint32)(_benchmarkBackendStart - _benchmarkFrameStart);
+		frame.backendTime = (uint32)(now - _benchmarkBackendStart);
+		_benchmarkFrames.push_back(frame);
+		_benchmarkFrameStart = now;
+		_benchmarkBackendStart = 0;
+	}
+
+	if (((_initialized) || (_needRedraw)) && !_benchmark) {
 		RecordMode oldMode = _recordMode;
 		_recordMode = kPassthrough;
 	    g_system->hideOverlay();
@@ -79,6 +79,13 @@ public:
 
 	void init(const Common::String &recordFileName, RecordMode mode);
 	void deinit();
+
+	/**
+	 * Play back the recording as fast as possible without display output,
+	 * and write the frame timings as JSON to the given file when the
+	 * playback ends. Must be called before init().
+	 */
+	void enableBenchmark(const Common::String &reportFileName);
 	bool processDelayMillis();
 	uint32 getRandomSeed(const Common::String &name);
 	void processTimeAndDate(TimeDate &td, bool skipRecord);
@@ -240,6 +247,22 @@ private:
 	Common::PlaybackFile *_playbackFile;
 	Common::PlaybackFile *_recordFile;
 
+	struct BenchmarkFrame {
+		uint32 engineTime;	///< Time spent between two screen updates, in microseconds
+		uint32 backendTime;	///< Time spent in the screen update, in microseconds
+	};
+
+	bool _benchmark;
+	Common::String _benchmarkFileName;
+	Common::Array<BenchmarkFrame> _benchmarkFrames;
+	uint64 _benchmarkFrameStart;
+	uint64 _benchmarkBackendStart;
+
+	static uint64 getBenchmarkTime();
+	void writeBenchmarkReport();
+
+	Common::RecorderEvent getNextEvent();
+
 	void saveScreenShot();
 	void checkRecordedMD5();
 	void deleteTemporarySave();
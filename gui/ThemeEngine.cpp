@@ -189,7 +189,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(nullptr), _scaleFactor(1.0f) {
+	_cursor(nullptr), _scaleFactor(1.0f), _drawCacheUseCounter(0) {
 
 	_baseWidth = 640;	// Default sane values
 	_baseHeight = 480;
@@ -201,6 +201,8 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 
 	_useCursor = false;
 
+	memset(&_drawCacheStats, 0, sizeof(_drawCacheStats));
+
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		_widgets[i] = nullptr;
 	}
@@ -464,6 +466,9 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	_vectorRenderer = Graphics::createRenderer(mode);
 	_vectorRenderer->setSurface(&_screen);
 
+	// The cached DrawData were rendered for the old mode and format
+	clearDrawCache();
+
 	// Since we reinitialized our screen surfaces we know nothing has been
 	// drawn so far. Sometimes we still end up with dirty screen bits in the
 	// list. Clearing it avoids invalid overlay writes when the backend
@@ -789,6 +794,8 @@ void ThemeEngine::unloadTheme() {
 	if (!_themeOk)
 		return;
 
+	clearDrawCache();
+
 	for (int i = 0; i < kDrawDataMAX; ++i) {
 		delete _widgets[i];
 		_widgets[i] = nullptr;
@@ -948,15 +955,154 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		restoreBackground(extendedRect);
 
 	if (drawData->_layer == _layerToDraw) {
+		const Graphics::ManagedSurface *surf = _vectorRenderer->getActiveSurface();
+
+		// Only elements which are drawn completely can be cached, since the
+		// clipping may differ the next time they are drawn
+		Common::Rect fullRect = r;
+		fullRect.grow(kDirtyRectangleThreshold + drawData->_backgroundOffset);
+		if (drawData->_shadowOffset > drawData->_backgroundOffset) {
+			fullRect.right += drawData->_shadowOffset - drawData->_backgroundOffset;
+			fullRect.bottom += drawData->_shadowOffset - drawData->_backgroundOffset;
+		}
+
+		const bool cacheable = surf->format.bytesPerPixel > 1 && area == r && extendedRect == fullRect &&
+			Common::Rect(surf->w, surf->h).contains(extendedRect) &&
+			(uint32)extendedRect.width() * extendedRect.height() * surf->format.bytesPerPixel <= kDrawCacheMaxEntrySize;
+
+		DrawCacheKey key;
+		Common::Array<byte> background;
+		if (cacheable) {
+			key.type = type;
+			key.dynamic = dynamic;
+			key.width = r.width();
+			key.height = r.height();
+			key.parity = (r.left & 1) | ((r.top & 1) << 1);
+			key.background = hashSurfaceRect(*surf, extendedRect);
+
+			if (drawCachedDD(key, extendedRect)) {
+				addDirtyRect(extendedRect);
+				return;
+			}
+
+			copyRectFromSurface(*surf, extendedRect, background);
+		}
+
 		Common::List<Graphics::DrawStep>::const_iterator step;
 		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
 			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
 		}
 
+		if (cacheable)
+			addCachedDD(key, extendedRect, background);
+
 		addDirtyRect(extendedRect);
 	}
 }
 
+ThemeEngine::DrawCacheStats ThemeEngine::getDrawCacheStats() const {
+	DrawCacheStats stats = _drawCacheStats;
+	stats.entries = _drawCache.size();
+	return stats;
+}
+
+bool ThemeEngine::drawCachedDD(const DrawCacheKey &key, const Common::Rect &r) {
+	DrawCache::iterator it = _drawCache.find(key);
+	Graphics::ManagedSurface *surf = _vectorRenderer->getActiveSurface();
+
+	if (it == _drawCache.end() || !compareRectWithSurface(*surf, r, it->_value.background)) {
+		_drawCacheStats.misses++;
+		return false;
+	}
+
+	copyRectToSurface(*surf, r, it->_value.result);
+	it->_value.lastUse = ++_drawCacheUseCounter;
+	_drawCacheStats.hits++;
+	return true;
+}
+
+void ThemeEngine::addCachedDD(const DrawCacheKey &key, const Common::Rect &r, const Common::Array<byte> &background) {
+	DrawCache::iterator it = _drawCache.find(key);
+	if (it != _drawCache.end())
+		_drawCacheStats.size -= it->_value.background.size() + it->_value.result.size();
+
+	DrawCacheEntry &entry = _drawCache[key];
+	entry.background = background;
+	copyRectFromSurface(*_vectorRenderer->getActiveSurface(), r, entry.result);
+	entry.lastUse = ++_drawCacheUseCounter;
+
+	_drawCacheStats.size += entry.background.size() + entry.result.size();
+	evictDrawCache();
+}
+
+void ThemeEngine::clearDrawCache() {
+	if (_drawCacheStats.hits || _drawCacheStats.misses) {
+		debug(3, "ThemeEngine: DrawData cache had %u hits and %u misses, %u entries using %u bytes",
+			_drawCacheStats.hits, _drawCacheStats.misses, _drawCache.size(), _drawCacheStats.size);
+	}
+
+	_drawCache.clear(true);
+	memset(&_drawCacheStats, 0, sizeof(_drawCacheStats));
+}
+
+void ThemeEngine::evictDrawCache() {
+	// Drop the least recently used entries until the cache fits again
+	while (_drawCacheStats.size > kDrawCacheMaxSize) {
+		DrawCache::iterator oldest = _drawCache.begin();
+		for (DrawCache::iterator it = _drawCache.begin(); it != _drawCache.end(); ++it) {
+			if (it->_value.lastUse < oldest->_value.lastUse)
+				oldest = it;
+		}
+
+		_drawCacheStats.size -= oldest->_value.background.size() + oldest->_value.result.size();
+		_drawCache.erase(oldest);
+	}
+}
+
+uint32 ThemeEngine::hashSurfaceRect(const Graphics::ManagedSurface &surf, const Common::Rect &r) {
+	const uint rowSize = r.width() * surf.format.bytesPerPixel;
+	uint32 hash = 2166136261u;
+
+	for (int y = r.top; y < r.bottom; ++y) {
+		const byte *src = (const byte *)surf.getBasePtr(r.left, y);
+		for (uint i = 0; i < rowSize; ++i)
+			hash = (hash ^ src[i]) * 16777619u;
+	}
+
+	return hash;
+}
+
+void ThemeEngine::copyRectFromSurface(const Graphics::ManagedSurface &surf, const Common::Rect &r, Common::Array<byte> &dst) {
+	const uint rowSize = r.width() * surf.format.bytesPerPixel;
+	dst.resize(rowSize * r.height());
+
+	byte *dstPtr = dst.data();
+	for (int y = r.top; y < r.bottom; ++y, dstPtr += rowSize)
+		memcpy(dstPtr, surf.getBasePtr(r.left, y), rowSize);
+}
+
+bool ThemeEngine::compareRectWithSurface(const Graphics::ManagedSurface &surf, const Common::Rect &r, const Common::Array<byte> &src) {
+	const uint rowSize = r.width() * surf.format.bytesPerPixel;
+	if (src.size() != rowSize * r.height())
+		return false;
+
+	const byte *srcPtr = src.data();
+	for (int y = r.top; y < r.bottom; ++y, srcPtr += rowSize) {
+		if (memcmp(srcPtr, surf.getBasePtr(r.left, y), rowSize) != 0)
+			return false;
+	}
+
+	return true;
+}
+
+void ThemeEngine::copyRectToSurface(Graphics::ManagedSurface &surf, const Common::Rect &r, const Common::Array<byte> &src) {
+	const uint rowSize = r.width() * surf.format.bytesPerPixel;
+
+	const byte *srcPtr = src.data();
+	for (int y = r.top; y < r.bottom; ++y, srcPtr += rowSize)
+		memcpy(surf.getBasePtr(r.left, y), srcPtr, rowSize);
+}
+
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
 	bool restoreBg, bool ellipsis, Graphics::TextAlign alignH, TextAlignVertical alignV,
 	int deltax, const Common::Rect &drawableTextArea) {
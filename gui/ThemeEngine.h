@@ -665,6 +665,17 @@ public:
 	const Common::String &getThemeId() const { return _themeId; }
 	int getGraphicsMode() const { return _graphicsMode; }
 
+	/** Usage statistics of the cache of rendered DrawData. */
+	struct DrawCacheStats {
+		uint hits;
+		uint misses;
+		uint entries;
+		uint32 size;
+	};
+
+	/** Return the usage statistics of the cache of rendered DrawData. */
+	DrawCacheStats getDrawCacheStats() const;
+
 protected:
 
 	/**
@@ -723,6 +734,57 @@ protected:
 	 */
 	void debugWidgetPosition(const char *name, const Common::Rect &r);
 
+	/**
+	 * Cache of rendered DrawData.
+	 *
+	 * The draw steps blend with whatever is below them, so an entry stores
+	 * the pixels below the element along with the rendered result, and is
+	 * only reused when these are identical. Entries are keyed by the
+	 * DrawData, the size, the dynamic data and a hash of the pixels below.
+	 */
+	struct DrawCacheKey {
+		DrawData type;
+		uint32 dynamic;
+		int16 width, height;
+		byte parity; ///< x/y parity of the position, gradients are dithered on it
+		uint32 background;
+
+		bool operator==(const DrawCacheKey &other) const {
+			return type == other.type && dynamic == other.dynamic && width == other.width &&
+				height == other.height && parity == other.parity && background == other.background;
+		}
+	};
+
+	struct DrawCacheKey_Hash {
+		uint operator()(const DrawCacheKey &key) const {
+			return key.background ^ (key.type << 24) ^ (key.width << 12) ^ key.height ^ key.dynamic ^ (key.parity << 30);
+		}
+	};
+
+	struct DrawCacheEntry {
+		Common::Array<byte> background;
+		Common::Array<byte> result;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<DrawCacheKey, DrawCacheEntry, DrawCacheKey_Hash> DrawCache;
+
+	enum {
+		kDrawCacheMaxSize = 16 * 1024 * 1024,	///< Memory used by the cached DrawData
+		kDrawCacheMaxEntrySize = kDrawCacheMaxSize / 8
+	};
+
+	/** Try drawing the DrawData from the cache. Returns false if it has to be rendered. */
+	bool drawCachedDD(const DrawCacheKey &key, const Common::Rect &r);
+	void addCachedDD(const DrawCacheKey &key, const Common::Rect &r, const Common::Array<byte> &background);
+	void clearDrawCache();
+	void evictDrawCache();
+
+	static uint32 hashSurfaceRect(const Graphics::ManagedSurface &surf, const Common::Rect &r);
+	static void copyRectFromSurface(const Graphics::ManagedSurface &surf, const Common::Rect &r, Common::Array<byte> &dst);
+	static bool compareRectWithSurface(const Graphics::ManagedSurface &surf, const Common::Rect &r, const Common::Array<byte> &src);
+	static void copyRectToSurface(Graphics::ManagedSurface &surf, const Common::Rect &r, const Common::Array<byte> &src);
+
 public:
 	struct ThemeDescriptor {
 		Common::String name;
@@ -830,6 +892,10 @@ protected:
 	byte _cursorPalSize;
 
 	Common::Rect _clip;
+
+	DrawCache _drawCache;
+	DrawCacheStats _drawCacheStats;
+	uint32 _drawCacheUseCounter;
 };
 
 } // End of namespace GUI.
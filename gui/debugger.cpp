@@ -22,9 +22,12 @@
 // NB: This is really only necessary if USE_READLINE is defined
 #define FORBIDDEN_SYMBOL_ALLOW_ALL
 
+#include "audio/audio_cache.h"
+
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -81,6 +84,10 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+	registerCmd("audiocache",		WRAP_METHOD(Debugger, cmdAudioCache));
+#ifdef ENABLE_PROFILER
+	registerCmd("profile",			WRAP_METHOD(Debugger, cmdProfile));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -841,6 +848,69 @@ bool Debugger::cmdExecFile(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdAudioCache(int argc, const char **argv) {
+	Audio::AudioCache &cache = Audio::AudioCache::instance();
+
+	if (argc == 1) {
+		const Audio::AudioCache::Stats stats = cache.getStats();
+		debugPrintf("Clips: %u, %u of %u KB used\n", stats.entries, stats.size / 1024, stats.maxSize / 1024);
+		debugPrintf("Hits: %u, misses: %u, evictions: %u, too long: %u\n", stats.hits, stats.misses, stats.evictions, stats.rejected);
+	} else if (!strcmp(argv[1], "reset")) {
+		cache.resetStats();
+		debugPrintf("Audio cache statistics reset\n");
+	} else if (!strcmp(argv[1], "clear")) {
+		cache.clear();
+		debugPrintf("Audio cache cleared\n");
+	} else {
+		debugPrintf("Usage: %s [reset | clear]\n", argv[0]);
+		debugPrintf("Without arguments, shows the statistics of the audio cache\n");
+	}
+
+	return true;
+}
+
+#ifdef ENABLE_PROFILER
+bool Debugger::cmdProfile(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc == 1) {
+		Common::Array<Common::Profiler::ZoneCounters> zones;
+		profiler.getCounters(zones);
+
+		if (zones.empty()) {
+			debugPrintf("No profiling zone has been entered yet\n");
+			return true;
+		}
+
+		debugPrintf("%-40s %8s %10s %10s %10s %10s\n", "Zone", "Calls", "Total ms", "Mean us", "Last us", "Max us");
+		for (uint i = 0; i < zones.size(); i++) {
+			const Common::Profiler::ZoneCounters &zone = zones[i];
+			debugPrintf("%-40s %8u %10u %10u %10u %10u\n", zone.name, zone.calls,
+				(uint)(zone.totalTime / 1000), zone.calls ? (uint)(zone.totalTime / zone.calls) : 0,
+				zone.lastTime, zone.maxTime);
+		}
+		if (profiler.isTracing())
+			debugPrintf("A trace is being recorded\n");
+	} else if (!strcmp(argv[1], "reset")) {
+		profiler.resetCounters();
+		debugPrintf("Profiling counters reset\n");
+	} else if (!strcmp(argv[1], "start") && argc == 3) {
+		profiler.startTrace(argv[2]);
+		debugPrintf("Recording a trace to '%s'\n", argv[2]);
+	} else if (!strcmp(argv[1], "stop")) {
+		if (profiler.stopTrace())
+			debugPrintf("Trace written\n");
+		else
+			debugPrintf("No trace was written\n");
+	} else {
+		debugPrintf("Usage: %s [reset | start <file> | stop]\n", argv[0]);
+		debugPrintf("Without arguments, shows the counters of the profiling zones\n");
+	}
+
+	return true;
+}
+#endif
+
 bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	if (argc < 2) {
 		debugPrintf("debugflag_disable [<flag> | all]\n");
@@ -20,9 +20,14 @@
  */
 
 #include "common/system.h"
+#include "common/algorithm.h"
+#include "common/config-manager.h"
 #include "common/file.h"
+#include "common/fs.h"
 #include "common/language.h"
+#include "common/list.h"
 #include "common/platform.h"
+#include "common/ptr.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
 
@@ -399,6 +404,168 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 
 #pragma mark -
 
+/**
+ * Decodes and scales grid thumbnails. The grid loads a few of them on every
+ * tickle, so that the GUI stays responsive while they are being loaded.
+ *
+ * Scaled thumbnails are also written to a cache in the cache path, keyed by
+ * the source file and the target size, so that later runs can skip both
+ * the PNG decoding and the scaling.
+ */
+class GridThumbnailLoader {
+public:
+	static const Graphics::ManagedSurface *loadThumbnail(const Common::String &path, const Common::Path &cacheDir, int width, int height);
+
+private:
+	enum {
+		kCacheVersion = 1
+	};
+
+	static Graphics::ManagedSurface *readCachedThumbnail(const Common::FSNode &node, uint32 sourceSize);
+	static void writeCachedThumbnail(const Common::FSNode &node, uint32 sourceSize, const Graphics::ManagedSurface &surf);
+};
+
+const Graphics::ManagedSurface *GridThumbnailLoader::loadThumbnail(const Common::String &path, const Common::Path &cacheDir, int width, int height) {
+	uint32 sourceSize = 0;
+
+	g_gui.lockIconsSet();
+	Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(Common::Path(path));
+	if (stream)
+		sourceSize = stream->size();
+	delete stream;
+	g_gui.unlockIconsSet();
+
+	if (!sourceSize)
+		return nullptr;
+
+	// The cache is keyed by the name of the source and the target size, and
+	// checked against the size of the source in case the icons were updated
+	Common::FSNode cacheNode;
+	if (!cacheDir.empty()) {
+		Common::String name = path;
+		size_t pos = name.findLastOf('/');
+		if (pos != Common::String::npos)
+			name = name.substr(pos + 1);
+		pos = name.findLastOf('.');
+		if (pos != Common::String::npos)
+			name = name.substr(0, pos);
+
+		cacheNode = Common::FSNode(cacheDir).getChild(Common::String::format("%s-%dx%d.thumb", name.c_str(), width, height));
+
+		Graphics::ManagedSurface *cached = readCachedThumbnail(cacheNode, sourceSize);
+		if (cached)
+			return cached;
+	}
+
+	Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
+	if (!surf)
+		return nullptr;
+
+	const Graphics::ManagedSurface *scSurf = scaleGfx(surf, width, height, true);
+	if (surf != scSurf) {
+		surf->free();
+		delete surf;
+	}
+
+	if (!cacheDir.empty()) {
+		// The cache path itself may not have been created yet either
+		Common::FSNode dir(cacheDir);
+		Common::FSNode parent = dir.getParent();
+		if (dir.exists() || ((parent.exists() || parent.createDirectory()) && dir.createDirectory()))
+			writeCachedThumbnail(cacheNode, sourceSize, *scSurf);
+	}
+
+	return scSurf;
+}
+
+Graphics::ManagedSurface *GridThumbnailLoader::readCachedThumbnail(const Common::FSNode &node, uint32 sourceSize) {
+	if (!node.exists())
+		return nullptr;
+
+	Common::ScopedPtr<Common::SeekableReadStream> in(node.createReadStream());
+	if (!in)
+		return nullptr;
+
+	if (in->readUint32BE() != MKTAG('G', 'T', 'H', 'M') || in->readUint16LE() != kCacheVersion ||
+		in->readUint32LE() != sourceSize)
+		return nullptr;
+
+	const int w = in->readUint16LE();
+	const int h = in->readUint16LE();
+
+	byte bpp = in->readByte();
+	byte rBits = in->readByte(), gBits = in->readByte(), bBits = in->readByte(), aBits = in->readByte();
+	byte rShift = in->readByte(), gShift = in->readByte(), bShift = in->readByte(), aShift = in->readByte();
+
+	if (in->err() || in->eos() || (bpp != 2 && bpp != 4) || !w || !h ||
+		in->size() - in->pos() != (int64)w * h * bpp)
+		return nullptr;
+
+	const Graphics::PixelFormat format(bpp, rBits, gBits, bBits, aBits, rShift, gShift, bShift, aShift);
+	Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(w, h, format);
+
+	for (int y = 0; y < h; ++y) {
+		if (bpp == 2) {
+			uint16 *dst = (uint16 *)surf->getBasePtr(0, y);
+			for (int x = 0; x < w; ++x)
+				dst[x] = in->readUint16LE();
+		} else {
+			uint32 *dst = (uint32 *)surf->getBasePtr(0, y);
+			for (int x = 0; x < w; ++x)
+				dst[x] = in->readUint32LE();
+		}
+	}
+
+	if (in->err()) {
+		delete surf;
+		return nullptr;
+	}
+
+	return surf;
+}
+
+void GridThumbnailLoader::writeCachedThumbnail(const Common::FSNode &node, uint32 sourceSize, const Graphics::ManagedSurface &surf) {
+	const Graphics::PixelFormat &format = surf.format;
+	if (format.bytesPerPixel != 2 && format.bytesPerPixel != 4)
+		return;
+
+	Common::ScopedPtr<Common::SeekableWriteStream> out(node.createWriteStream());
+	if (!out)
+		return;
+
+	out->writeUint32BE(MKTAG('G', 'T', 'H', 'M'));
+	out->writeUint16LE(kCacheVersion);
+	out->writeUint32LE(sourceSize);
+	out->writeUint16LE(surf.w);
+	out->writeUint16LE(surf.h);
+
+	out->writeByte(format.bytesPerPixel);
+	out->writeByte(format.rBits());
+	out->writeByte(format.gBits());
+	out->writeByte(format.bBits());
+	out->writeByte(format.aBits());
+	out->writeByte(format.rShift);
+	out->writeByte(format.gShift);
+	out->writeByte(format.bShift);
+	out->writeByte(format.aShift);
+
+	for (int y = 0; y < surf.h; ++y) {
+		if (format.bytesPerPixel == 2) {
+			const uint16 *src = (const uint16 *)surf.getBasePtr(0, y);
+			for (int x = 0; x < surf.w; ++x)
+				out->writeUint16LE(src[x]);
+		} else {
+			const uint32 *src = (const uint32 *)surf.getBasePtr(0, y);
+			for (int x = 0; x < surf.w; ++x)
+				out->writeUint32LE(src[x]);
+		}
+	}
+
+	out->finalize();
+}
+
+#pragma mark -
+
 GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 	: ContainerWidget(boss, name), CommandSender(boss) {
 
@@ -444,13 +611,18 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 
 	_selectedEntry = nullptr;
 	_isGridInvalid = true;
+
+	_loadedSurfacesSize = 0;
+	_thumbnailUseCounter = 0;
+
+	setFlags(WIDGET_WANT_TICKLE);
 }
 
 GridWidget::~GridWidget() {
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
 	unloadSurfaces(_extraIcons);
-	unloadSurfaces(_loadedSurfaces);
+	unloadThumbnails();
 	delete _disabledIconOverlay;
 	_gridItems.clear();
 	_dataEntryList.clear();
@@ -470,10 +642,19 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 	surfaces.clear();
 }
 
+void GridWidget::unloadThumbnails() {
+	unloadSurfaces(_loadedSurfaces);
+	_thumbnailQueue.clear();
+	_pendingThumbnails.clear();
+	_thumbnailLastUse.clear();
+	_loadedSurfacesSize = 0;
+}
+
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+	// Thumbnails which are still being loaded are not in the map yet
+	return _loadedSurfaces.getValOrDefault(name, nullptr);
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode, Graphics::AlphaType &alphaType) {
@@ -697,42 +878,102 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
-	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
-	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+	// Entries which scrolled out of view before being loaded are not needed anymore
+	_thumbnailQueue.clear();
+	_pendingThumbnails.clear();
+
+	++_thumbnailUseCounter;
+
 	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
 		GridItemInfo *entry = *iter;
 		if (entry->thumbPath.empty())
 			continue;
 
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			_loadedSurfaces[entry->thumbPath] = nullptr;
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				if (!_loadedSurfaces.contains(path)) {
-					surf = loadSurfaceFromFile(path);
-				} else {
-					const Graphics::ManagedSurface *scSurf = _loadedSurfaces[path];
-					_loadedSurfaces[entry->thumbPath] = new Graphics::ManagedSurface(*scSurf);
-				}
-			}
+		_thumbnailLastUse[entry->thumbPath] = _thumbnailUseCounter;
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, thumbnailWidth, thumbnailHeight, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
+		if (_loadedSurfaces.contains(entry->thumbPath) || _pendingThumbnails.contains(entry->thumbPath))
+			continue;
 
-				if (path != entry->thumbPath) {
-					_loadedSurfaces[path] = new Graphics::ManagedSurface(*scSurf);
-				}
+		// The title is drawn in place of the thumbnail until it is loaded
+		_pendingThumbnails[entry->thumbPath] = true;
+		ThumbnailRequest request;
+		request.path = entry->thumbPath;
+		request.fallbackPath = Common::String::format("icons/%s.png", entry->engineid.c_str());
+		_thumbnailQueue.push_back(request);
+	}
 
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			}
+	if (!_thumbnailQueue.empty())
+		((GUI::Dialog *)_boss)->setTickleWidget(this);
+
+	evictThumbnails();
+}
+
+void GridWidget::handleTickle() {
+	const int thumbnailWidth = MAX(_thumbnailWidth - 2 * _thumbnailMargin, 0);
+	const int thumbnailHeight = MAX(_thumbnailHeight - 2 * _thumbnailMargin, 0);
+
+	// Without a cache path, scaled thumbnails are only kept in memory
+	Common::Path cacheDir = ConfMan.getPath("cachepath");
+	if (!cacheDir.empty())
+		cacheDir = cacheDir.join("thumbnails");
+
+	// Load thumbnails until the time budget is used up, at least one per tickle
+	const uint32 start = g_system->getMillis();
+	while (!_thumbnailQueue.empty() && g_system->getMillis() - start < kThumbnailTimeBudget) {
+		ThumbnailRequest request = _thumbnailQueue.front();
+		_thumbnailQueue.pop_front();
+		_pendingThumbnails.erase(request.path);
+
+		if (_loadedSurfaces.contains(request.path))
+			continue;
+
+		const Graphics::ManagedSurface *surf = GridThumbnailLoader::loadThumbnail(request.path, cacheDir, thumbnailWidth, thumbnailHeight);
+		if (!surf && !request.fallbackPath.empty())
+			surf = GridThumbnailLoader::loadThumbnail(request.fallbackPath, cacheDir, thumbnailWidth, thumbnailHeight);
+
+		_loadedSurfaces[request.path] = surf;
+		if (surf)
+			_loadedSurfacesSize += surf->pitch * surf->h;
+		if (!_thumbnailLastUse.contains(request.path))
+			_thumbnailLastUse[request.path] = _thumbnailUseCounter;
+
+		// The grid items are assigned in the order of the visible entries
+		for (uint k = 0; k < _visibleEntryList.size() && k < _gridItems.size(); ++k) {
+			if (_visibleEntryList[k]->thumbPath == request.path)
+				_gridItems[k]->update();
 		}
 	}
+
+	if (_thumbnailQueue.empty() && ((GUI::Dialog *)_boss)->getTickleWidget() == this)
+		((GUI::Dialog *)_boss)->unSetTickleWidget();
+
+	evictThumbnails();
+}
+
+void GridWidget::evictThumbnails() {
+	if (_loadedSurfacesSize <= kMaxLoadedThumbnailsSize)
+		return;
+
+	// Evict the least recently visible thumbnails first. The visible ones
+	// carry the current counter and are always kept.
+	Common::Array<Common::Pair<uint32, Common::String> > candidates;
+	for (Common::HashMap<Common::String, const Graphics::ManagedSurface *>::const_iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+		uint32 lastUse = _thumbnailLastUse.getValOrDefault(i->_key, 0);
+		if (i->_value && lastUse != _thumbnailUseCounter)
+			candidates.push_back(Common::Pair<uint32, Common::String>(lastUse, i->_key));
+	}
+
+	Common::sort(candidates.begin(), candidates.end(), [](const Common::Pair<uint32, Common::String> &a, const Common::Pair<uint32, Common::String> &b) {
+		return a.first < b.first;
+	});
+
+	for (uint i = 0; i < candidates.size() && _loadedSurfacesSize > kMaxLoadedThumbnailsSize; ++i) {
+		const Graphics::ManagedSurface *surf = _loadedSurfaces[candidates[i].second];
+		_loadedSurfacesSize -= surf->pitch * surf->h;
+		delete surf;
+		_loadedSurfaces.erase(candidates[i].second);
+		_thumbnailLastUse.erase(candidates[i].second);
+	}
 }
 
 void GridWidget::loadFlagIcons() {
@@ -1066,7 +1307,7 @@ void GridWidget::reflowLayout() {
 		unloadSurfaces(_extraIcons);
 		unloadSurfaces(_platformIcons);
 		unloadSurfaces(_languageIcons);
-		unloadSurfaces(_loadedSurfaces);
+		unloadThumbnails();
 		_platformIconsAlpha.clear();
 		_languageIconsAlpha.clear();
 		_extraIconsAlpha.clear();
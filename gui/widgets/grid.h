@@ -24,6 +24,7 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/scrollbar.h"
+#include "common/list.h"
 #include "common/str.h"
 
 #include "image/bmp.h"
@@ -46,6 +47,13 @@ enum {
 	kItemSizeCmd = 'SIZE'
 };
 
+enum {
+	// Memory used by the thumbnails which are not visible before they get evicted
+	kMaxLoadedThumbnailsSize = 32 * 1024 * 1024,
+	// Maximum time spent loading thumbnails in one tickle, in ms
+	kThumbnailTimeBudget = 5
+};
+
 /* GridItemInfo */
 struct GridItemInfo {
 	bool		isHeader, validEntry;
@@ -108,6 +116,17 @@ protected:
 	Graphics::ManagedSurface *_disabledIconOverlay;
 	// Images are mapped by filename -> surface.
 	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
+	// Thumbnails which are waiting to be loaded in handleTickle(), in order.
+	struct ThumbnailRequest {
+		Common::String path;
+		Common::String fallbackPath;
+	};
+	Common::List<ThumbnailRequest> _thumbnailQueue;
+	Common::HashMap<Common::String, bool> _pendingThumbnails;
+	// Value of _thumbnailUseCounter when a thumbnail was last visible.
+	Common::HashMap<Common::String, uint32> _thumbnailLastUse;
+	uint32			_thumbnailUseCounter;
+	uint32			_loadedSurfacesSize;
 
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_headerEntryList;
@@ -198,6 +217,8 @@ public:
 	void saveClosedGroups(const Common::U32String &groupName);
 
 	void reloadThumbnails();
+	void unloadThumbnails();
+	void evictThumbnails();
 	void loadFlagIcons();
 	void loadPlatformIcons();
 	void loadExtraIcons();
@@ -219,6 +240,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 	void reflowLayout() override;
 
 	bool wantsFocus() override { return true; }
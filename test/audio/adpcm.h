@@ -0,0 +1,199 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/adpcm_intern.h"
+#include "audio/audiostream.h"
+#include "common/memstream.h"
+
+class ADPCMTestSuite : public CxxTest::TestSuite {
+	static void fillRandom(byte *data, uint32 size, uint32 seed) {
+		for (uint32 i = 0; i < size; i++) {
+			seed = seed * 1103515245 + 12345;
+			data[i] = seed >> 24;
+		}
+	}
+
+	// Straightforward decoders, one nibble at a time, to check the block
+	// decoders against
+
+	static int16 refDecodeIMA(int32 &last, int32 &stepIndex, byte code) {
+		int32 E = (2 * (code & 0x7) + 1) * Audio::Ima_ADPCMStream::_imaTable[stepIndex] / 8;
+		last = CLIP<int32>(last + ((code & 0x08) ? -E : E), -32768, 32767);
+		stepIndex = CLIP<int32>(stepIndex + Audio::ADPCMStream::_stepAdjustTable[code], 0, 88);
+		return last;
+	}
+
+	static void refDecodeMSIma(const byte *data, uint32 size, int channels, uint32 blockAlign, Common::Array<int16> &out) {
+		int32 last[2], stepIndex[2];
+		for (uint32 block = 0; block < size; block += blockAlign) {
+			const byte *src = data + block;
+			for (int i = 0; i < channels; i++) {
+				last[i] = (int16)READ_LE_UINT16(src + i * 4);
+				stepIndex[i] = READ_LE_UINT16(src + i * 4 + 2);
+			}
+			for (uint32 pos = channels * 4; pos < blockAlign; pos += channels * 4) {
+				int16 samples[2][8];
+				for (int i = 0; i < channels; i++) {
+					for (int j = 0; j < 4; j++) {
+						byte b = src[pos + i * 4 + j];
+						samples[i][j * 2] = refDecodeIMA(last[i], stepIndex[i], b & 0x0f);
+						samples[i][j * 2 + 1] = refDecodeIMA(last[i], stepIndex[i], b >> 4);
+					}
+				}
+				for (int j = 0; j < 8; j++)
+					for (int i = 0; i < channels; i++)
+						out.push_back(samples[i][j]);
+			}
+		}
+	}
+
+	static void refDecodeMS(const byte *data, uint32 size, int channels, uint32 blockAlign, Common::Array<int16> &out) {
+		static const int coeff1[] = { 256, 512, 0, 192, 240, 460, 392 };
+		static const int coeff2[] = { 0, -256, 0, 64, 0, -208, -232 };
+		static const int adaptation[] = { 230, 230, 230, 230, 307, 409, 512, 614, 768, 614, 512, 409, 307, 230, 230, 230 };
+
+		for (uint32 block = 0; block < size; block += blockAlign) {
+			const byte *src = data + block;
+			// The decoder keeps its state in 16 bits, so the delta can wrap around
+			int c1[2], c2[2];
+			int16 delta[2], s1[2], s2[2];
+			for (int i = 0; i < channels; i++) {
+				int predictor = MIN<int>(src[i], 6);
+				c1[i] = coeff1[predictor];
+				c2[i] = coeff2[predictor];
+				delta[i] = (int16)READ_LE_UINT16(src + channels + i * 2);
+				s1[i] = (int16)READ_LE_UINT16(src + channels * 3 + i * 2);
+				s2[i] = (int16)READ_LE_UINT16(src + channels * 5 + i * 2);
+			}
+			for (int i = 0; i < channels; i++)
+				out.push_back(s2[i]);
+			for (int i = 0; i < channels; i++)
+				out.push_back(s1[i]);
+
+			for (uint32 pos = channels * 7; pos < blockAlign; pos++) {
+				for (int n = 0; n < 2; n++) {
+					const int i = (n == 0) ? 0 : channels - 1;
+					const byte code = (n == 0) ? (src[pos] >> 4) : (src[pos] & 0x0f);
+					int32 predictor = (s1[i] * c1[i] + s2[i] * c2[i]) / 256;
+					predictor += ((code & 0x08) ? (code - 0x10) : code) * delta[i];
+					predictor = CLIP<int32>(predictor, -32768, 32767);
+					s2[i] = s1[i];
+					s1[i] = predictor;
+					delta[i] = (adaptation[code] * delta[i]) >> 8;
+					if (delta[i] < 16)
+						delta[i] = 16;
+					out.push_back(predictor);
+				}
+			}
+		}
+	}
+
+	static void decodeStream(Audio::ADPCMType type, const byte *data, uint32 size, int channels, uint32 blockAlign, int chunk, Common::Array<int16> &out) {
+		// There is no backend to query the CPU features from
+		Audio::setInterleaveStereoSIMD(false);
+
+		Common::MemoryReadStream *stream = new Common::MemoryReadStream(data, size);
+		Audio::RewindableAudioStream *audio = Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+
+		int16 buffer[256];
+		while (!audio->endOfData()) {
+			const int count = audio->readBuffer(buffer, chunk);
+			if (count <= 0)
+				break;
+			for (int i = 0; i < count; i++)
+				out.push_back(buffer[i]);
+		}
+
+		delete audio;
+	}
+
+	static bool areEqual(const Common::Array<int16> &a, const Common::Array<int16> &b) {
+		return a.size() == b.size() && (a.empty() || !memcmp(a.data(), b.data(), a.size() * sizeof(int16)));
+	}
+
+public:
+	void test_ms_ima_blocks() {
+		const uint32 blockAlign = 256;
+		const uint32 size = blockAlign * 5;
+		byte data[size];
+
+		for (int channels = 1; channels <= 2; channels++) {
+			fillRandom(data, size, 0x1234 + channels);
+			// Keep the step indices of the headers valid
+			for (uint32 block = 0; block < size; block += blockAlign) {
+				for (int i = 0; i < channels; i++) {
+					data[block + i * 4 + 2] %= 89;
+					data[block + i * 4 + 3] = 0;
+				}
+			}
+
+			Common::Array<int16> reference;
+			refDecodeMSIma(data, size, channels, blockAlign, reference);
+
+			// Read in chunks which do not line up with the blocks
+			const int chunks[] = { 2, 30, 254 };
+			for (uint i = 0; i < ARRAYSIZE(chunks); i++) {
+				Common::Array<int16> decoded;
+				decodeStream(Audio::kADPCMMSIma, data, size, channels, blockAlign, chunks[i], decoded);
+				TS_ASSERT(areEqual(reference, decoded));
+			}
+		}
+	}
+
+	void test_ms_blocks() {
+		const uint32 blockAlign = 256;
+		const uint32 size = blockAlign * 5;
+		byte data[size];
+
+		for (int channels = 1; channels <= 2; channels++) {
+			fillRandom(data, size, 0x5678 + channels);
+			Common::Array<int16> reference;
+			refDecodeMS(data, size, channels, blockAlign, reference);
+
+			const int chunks[] = { 1, 31, 255 };
+			for (uint i = 0; i < ARRAYSIZE(chunks); i++) {
+				Common::Array<int16> decoded;
+				decodeStream(Audio::kADPCMMS, data, size, channels, blockAlign, chunks[i], decoded);
+				TS_ASSERT(areEqual(reference, decoded));
+			}
+		}
+	}
+
+	void test_ms_rewind() {
+		const uint32 blockAlign = 128;
+		const uint32 size = blockAlign * 3;
+		byte data[size];
+		fillRandom(data, size, 0x9abc);
+
+		Common::MemoryReadStream *stream = new Common::MemoryReadStream(data, size);
+		Audio::RewindableAudioStream *audio = Audio::makeADPCMStream(stream, DisposeAfterUse::YES, size, Audio::kADPCMMS, 22050, 2, blockAlign);
+
+		int16 first[100], second[100];
+		TS_ASSERT_EQUALS(audio->readBuffer(first, 100), 100);
+		// Rewinding in the middle of a block must drop the rest of it
+		TS_ASSERT(audio->rewind());
+		TS_ASSERT_EQUALS(audio->readBuffer(second, 100), 100);
+		TS_ASSERT_EQUALS(memcmp(first, second, sizeof(first)), 0);
+
+		delete audio;
+	}
+
+	void test_interleave_simd() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() < 2)
+			return;
+
+		int16 left[37], right[37];
+		int16 reference[74], simd[74];
+		for (int i = 0; i < 37; i++) {
+			left[i] = i * 3 - 100;
+			right[i] = 20000 - i * 7;
+		}
+
+		Audio::interleaveStereo(left, right, reference, 37);
+		Audio::interleaveStereoSSE2(left, right, simd, 37);
+		TS_ASSERT_EQUALS(memcmp(reference, simd, sizeof(simd)), 0);
+#endif
+	}
+};
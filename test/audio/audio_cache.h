@@ -0,0 +1,130 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/audio_cache.h"
+#include "audio/audiostream.h"
+
+#include "common/config-manager.h"
+
+#include "helper.h"
+
+class AudioCacheTestSuite : public CxxTest::TestSuite {
+	static bool readsSamples(Audio::SeekableAudioStream *s, const int16 *samples, int numSamples) {
+		int16 *buffer = new int16[numSamples];
+		const bool equal = s->readBuffer(buffer, numSamples) == numSamples && s->endOfData() &&
+			!memcmp(buffer, samples, numSamples * sizeof(int16));
+		delete[] buffer;
+		return equal;
+	}
+
+public:
+	void setUp() {
+		Audio::AudioCache &cache = Audio::AudioCache::instance();
+		cache.clear();
+		cache.resetStats();
+		cache.setMaxSize(1024 * 1024);
+	}
+
+	void test_hit_and_miss() {
+		Audio::AudioCache &cache = Audio::AudioCache::instance();
+		const Common::String key = Audio::AudioCache::makeKey("Sounds/Click.wav", "test");
+		TS_ASSERT_EQUALS(key, Audio::AudioCache::makeKey("sounds/click.WAV", "test"));
+		TS_ASSERT_DIFFERS(key, Audio::AudioCache::makeKey("sounds/click.wav", "other"));
+
+		TS_ASSERT(!cache.open(key));
+
+		int16 *sine;
+		Audio::SeekableAudioStream *s = cache.add(key, createSineStream<int16>(11025, 1, &sine, true, true));
+		TS_ASSERT(readsSamples(s, sine, 11025 * 2));
+
+		// The cached stream can be rewound, and every open gets its own position
+		Audio::SeekableAudioStream *s2 = cache.open(key);
+		TS_ASSERT(s2);
+		TS_ASSERT(s->rewind());
+		TS_ASSERT(readsSamples(s, sine, 11025 * 2));
+		TS_ASSERT(readsSamples(s2, sine, 11025 * 2));
+		TS_ASSERT_EQUALS(s2->getLength().msecs(), 1000);
+		TS_ASSERT(s2->isStereo());
+		TS_ASSERT_EQUALS(s2->getRate(), 11025);
+
+		// Streams stay valid when the clip is dropped
+		cache.clear();
+		TS_ASSERT(s2->rewind());
+		TS_ASSERT(readsSamples(s2, sine, 11025 * 2));
+
+		const Audio::AudioCache::Stats stats = cache.getStats();
+		TS_ASSERT_EQUALS(stats.hits, 1U);
+		TS_ASSERT_EQUALS(stats.misses, 1U);
+		TS_ASSERT_EQUALS(stats.entries, 0U);
+		TS_ASSERT_EQUALS(stats.size, 0U);
+
+		delete s;
+		delete s2;
+		delete[] sine;
+	}
+
+	void test_lru_eviction() {
+		Audio::AudioCache &cache = Audio::AudioCache::instance();
+		// Room for two clips of one second
+		cache.setMaxSize(11025 * sizeof(int16) * 2);
+
+		delete cache.add("a", createSineStream<int16>(11025, 1, nullptr, true, false));
+		delete cache.add("b", createSineStream<int16>(11025, 1, nullptr, true, false));
+		delete cache.open("a");
+		delete cache.add("c", createSineStream<int16>(11025, 1, nullptr, true, false));
+
+		Audio::SeekableAudioStream *s;
+		TS_ASSERT(s = cache.open("a"));
+		delete s;
+		TS_ASSERT(s = cache.open("c"));
+		delete s;
+		TS_ASSERT(!cache.open("b"));
+
+		const Audio::AudioCache::Stats stats = cache.getStats();
+		TS_ASSERT_EQUALS(stats.evictions, 1U);
+		TS_ASSERT_EQUALS(stats.entries, 2U);
+		TS_ASSERT_EQUALS(stats.size, 11025U * sizeof(int16) * 2);
+	}
+
+	void test_long_clip() {
+		Audio::AudioCache &cache = Audio::AudioCache::instance();
+		cache.setMaxSize(11025 * sizeof(int16));
+
+		// Too long for the cache, the original stream is played instead
+		int16 *sine;
+		Audio::SeekableAudioStream *s = cache.add("long", createSineStream<int16>(11025, 2, &sine, true, false));
+		TS_ASSERT(readsSamples(s, sine, 11025 * 2));
+		TS_ASSERT(!cache.open("long"));
+		TS_ASSERT_EQUALS(cache.getStats().rejected, 1U);
+
+		delete s;
+		delete[] sine;
+	}
+
+	void test_disabled() {
+		Audio::AudioCache &cache = Audio::AudioCache::instance();
+		cache.setMaxSize(0);
+
+		Audio::SeekableAudioStream *s = cache.add("short", createSineStream<int16>(11025, 1, nullptr, true, false));
+		TS_ASSERT(s);
+		TS_ASSERT(!cache.open("short"));
+		delete s;
+	}
+
+	void test_config_size() {
+		Audio::AudioCache &cache = Audio::AudioCache::instance();
+
+		// The registered default is used, and changes are picked up on the next lookup
+		ConfMan.registerDefault("audio_cache_size", 64);
+		TS_ASSERT(!cache.open("none"));
+		TS_ASSERT_EQUALS(cache.getStats().maxSize, 64U * 1024);
+
+		// A size set explicitly is kept until the setting changes again
+		cache.setMaxSize(1024);
+		TS_ASSERT(!cache.open("none"));
+		TS_ASSERT_EQUALS(cache.getStats().maxSize, 1024U);
+
+		ConfMan.registerDefault("audio_cache_size", 0);
+		TS_ASSERT(!cache.open("none"));
+		TS_ASSERT_EQUALS(cache.getStats().maxSize, 0U);
+	}
+};
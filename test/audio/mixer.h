@@ -0,0 +1,142 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+#include "audio/decoders/raw.h"
+
+#include "../null_osystem.h"
+
+class MixerTestSuite : public CxxTest::TestSuite {
+	enum {
+		kRate = 22050,
+		kFrames = 256
+	};
+
+	int16 _output[kFrames * 2];
+
+	void playConstant(Audio::Mixer &mixer, Audio::Mixer::SoundType type, int16 left, int16 right) {
+		const uint32 size = kFrames * 2 * sizeof(int16);
+		byte *data = (byte *)malloc(size);
+		for (int i = 0; i < kFrames; i++) {
+			WRITE_LE_INT16(data + i * 4, left);
+			WRITE_LE_INT16(data + i * 4 + 2, right);
+		}
+
+		Audio::SoundHandle handle;
+		mixer.playStream(type, &handle, Audio::makeRawStream(data, size, kRate, Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN));
+	}
+
+	// Play a stereo stream whose level steps from one value to another
+	void playStep(Audio::Mixer &mixer, int frames, int16 level, int stepFrame, int16 stepLevel) {
+		const uint32 size = frames * 2 * sizeof(int16);
+		byte *data = (byte *)malloc(size);
+		for (int i = 0; i < frames; i++) {
+			const int16 value = (i < stepFrame) ? level : stepLevel;
+			WRITE_LE_INT16(data + i * 4, value);
+			WRITE_LE_INT16(data + i * 4 + 2, value);
+		}
+
+		Audio::SoundHandle handle;
+		mixer.playStream(Audio::Mixer::kSFXSoundType, &handle, Audio::makeRawStream(data, size, kRate, Audio::FLAG_16BITS | Audio::FLAG_STEREO | Audio::FLAG_LITTLE_ENDIAN));
+	}
+
+	void mix(Audio::MixerImpl &mixer, int frames) {
+		mixer.mixCallback((byte *)_output, frames * 2 * sizeof(int16));
+	}
+
+public:
+	void test_sound_type_volume() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(kRate);
+		mixer.setReady(true);
+		mixer.setVolumeForSoundType(Audio::Mixer::kSFXSoundType, Audio::Mixer::kMaxMixerVolume / 2);
+
+		playConstant(mixer, Audio::Mixer::kMusicSoundType, 1000, -1000);
+		playConstant(mixer, Audio::Mixer::kSFXSoundType, 2000, 2000);
+		mix(mixer, 64);
+
+		TS_ASSERT_EQUALS(_output[0], 2000);
+		TS_ASSERT_EQUALS(_output[1], 0);
+#endif
+	}
+
+	void test_limiter_keeps_balance() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(kRate);
+		mixer.setReady(true);
+
+		// Four loud channels overload the left side of the output
+		for (int i = 0; i < 4; i++)
+			playConstant(mixer, Audio::Mixer::kSFXSoundType, 20000, 10000);
+		mix(mixer, 64);
+
+		// Instead of clipping, both sides are attenuated equally, give or
+		// take the dither
+		int left = _output[126];
+		int right = _output[127];
+		TS_ASSERT_LESS_THAN_EQUALS(left, 32767);
+		TS_ASSERT_LESS_THAN(32000, left);
+		TS_ASSERT_LESS_THAN_EQUALS(ABS(left - 2 * right), 3);
+#endif
+	}
+
+	void test_limiter_attack_ramp() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(kRate);
+		mixer.setReady(true);
+
+		// Two channels become loud enough to clip half way through
+		playStep(mixer, kFrames, 10000, kFrames / 2, 30000);
+		playStep(mixer, kFrames, 10000, kFrames / 2, 30000);
+		mix(mixer, kFrames);
+
+		// The gain fades down before the peak instead of dropping at once
+		TS_ASSERT_LESS_THAN(20000 - _output[0], 200);
+		for (int i = 1; i < kFrames / 2; i++) {
+			TS_ASSERT_LESS_THAN_EQUALS(_output[i * 2], _output[(i - 1) * 2] + 1);
+			TS_ASSERT_LESS_THAN(_output[(i - 1) * 2] - _output[i * 2], 200);
+		}
+		TS_ASSERT_LESS_THAN(_output[kFrames - 2], 11000);
+
+		for (int i = kFrames / 2; i < kFrames; i++) {
+			TS_ASSERT_LESS_THAN(32700, _output[i * 2]);
+			TS_ASSERT_LESS_THAN_EQUALS(_output[i * 2], 32767);
+		}
+#endif
+	}
+
+	void test_limiter_release() {
+#if NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Audio::MixerImpl mixer(kRate);
+		mixer.setReady(true);
+
+		// A loud buffer, followed by a long quiet part
+		const int frames = kFrames * 32;
+		playStep(mixer, frames, 30000, kFrames, 1000);
+		playStep(mixer, frames, 30000, kFrames, 1000);
+		mix(mixer, kFrames);
+
+		// The gain recovers smoothly and never overshoots. The dither may
+		// move each sample by one step.
+		int last = 0;
+		for (int buffer = 1; buffer < 32; buffer++) {
+			mix(mixer, kFrames);
+			for (int i = 0; i < kFrames; i++) {
+				TS_ASSERT_LESS_THAN_EQUALS(_output[i * 2], 2001);
+				TS_ASSERT_LESS_THAN_EQUALS(last - 2, _output[i * 2]);
+				last = _output[i * 2];
+			}
+		}
+
+		// Full volume is restored within the release time
+		TS_ASSERT_EQUALS(_output[kFrames * 2 - 2], 2000);
+#endif
+	}
+};
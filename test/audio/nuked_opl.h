@@ -0,0 +1,96 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/softsynth/opl/nuked.h"
+
+class NukedOPLTestSuite : public CxxTest::TestSuite {
+#ifndef DISABLE_NUKED_OPL
+	enum {
+		kMaxChunk = 700
+	};
+
+	uint32 _seed;
+
+	uint32 nextRandom() {
+		_seed = _seed * 1103515245 + 12345;
+		return _seed >> 8;
+	}
+
+	void writeBoth(OPL::NUKED::opl3_chip *a, OPL::NUKED::opl3_chip *b, uint16 reg, uint8 val) {
+		OPL::NUKED::OPL3_WriteRegBuffered(a, reg, val);
+		OPL::NUKED::OPL3_WriteRegBuffered(b, reg, val);
+	}
+
+	void writeRandomRegisters(OPL::NUKED::opl3_chip *a, OPL::NUKED::opl3_chip *b, bool opl3) {
+		static const uint8 bases[] = { 0x20, 0x40, 0x60, 0x80, 0xA0, 0xB0, 0xC0, 0xE0 };
+
+		int count = nextRandom() % 24;
+		for (int i = 0; i < count; i++) {
+			uint16 reg = bases[nextRandom() % ARRAYSIZE(bases)] + nextRandom() % 0x16;
+			if (opl3 && (nextRandom() & 1))
+				reg |= 0x100;
+
+			uint8 val = nextRandom();
+			// Favour fast envelopes so that slots reach the idle state
+			if ((reg & 0xE0) == 0x60 || (reg & 0xE0) == 0x80)
+				val |= 0x0F;
+			writeBoth(a, b, reg, val);
+		}
+	}
+
+	void compareStreams(uint32 rate, bool opl3, bool rhythm) {
+		OPL::NUKED::opl3_chip *reference = new OPL::NUKED::opl3_chip;
+		OPL::NUKED::opl3_chip *block = new OPL::NUKED::opl3_chip;
+		int16 *referenceBuf = new int16[kMaxChunk * 2];
+		int16 *blockBuf = new int16[kMaxChunk * 2];
+
+		OPL::NUKED::OPL3_Reset(reference, rate);
+		OPL::NUKED::OPL3_Reset(block, rate);
+		_seed = rate + (opl3 ? 1 : 0) + (rhythm ? 2 : 0);
+
+		writeBoth(reference, block, 0x01, 0x20);
+		if (opl3)
+			writeBoth(reference, block, 0x105, 0x01);
+
+		bool equal = true;
+		for (int chunk = 0; chunk < 200 && equal; chunk++) {
+			writeRandomRegisters(reference, block, opl3);
+			if (rhythm)
+				writeBoth(reference, block, 0xBD, 0x20 | (nextRandom() & 0xDF));
+
+			uint32 length = 1 + nextRandom() % kMaxChunk;
+			OPL::NUKED::OPL3_GenerateStream(reference, referenceBuf, length);
+			OPL::NUKED::OPL3_GenerateStreamBlock(block, blockBuf, length);
+			equal = (memcmp(referenceBuf, blockBuf, length * 2 * sizeof(int16)) == 0);
+		}
+
+		TS_ASSERT(equal);
+
+		delete[] referenceBuf;
+		delete[] blockBuf;
+		delete reference;
+		delete block;
+	}
+#endif
+
+public:
+	void test_block_stream_matches_opl2() {
+#ifndef DISABLE_NUKED_OPL
+		compareStreams(44100, false, false);
+		compareStreams(22050, false, false);
+#endif
+	}
+
+	void test_block_stream_matches_opl3() {
+#ifndef DISABLE_NUKED_OPL
+		compareStreams(44100, true, false);
+		compareStreams(48000, true, false);
+#endif
+	}
+
+	void test_block_stream_matches_rhythm() {
+#ifndef DISABLE_NUKED_OPL
+		compareStreams(44100, false, true);
+		compareStreams(11025, true, true);
+#endif
+	}
+};
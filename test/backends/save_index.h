@@ -0,0 +1,96 @@
+#include <cxxtest/TestSuite.h>
+
+#include "backends/saves/default/save-index.h"
+
+#include "common/memstream.h"
+
+class SaveIndexTestSuite : public CxxTest::TestSuite {
+	static Common::Array<byte> makeMetadata(byte value, uint size) {
+		Common::Array<byte> metadata;
+		metadata.resize(size);
+		for (uint i = 0; i < size; i++)
+			metadata[i] = value + i;
+		return metadata;
+	}
+
+	static bool reload(SaveIndex &from, SaveIndex &to, int truncate = 0) {
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		from.save(out);
+		Common::MemoryReadStream in(out.getData(), out.size() - truncate);
+		return to.load(in);
+	}
+
+public:
+	void test_round_trip() {
+		SaveIndex index;
+		TS_ASSERT(index.empty());
+		TS_ASSERT(!index.isDirty());
+
+		index.set("game.000", 1234, 1700000000, makeMetadata(1, 16));
+		index.set("game.001", 0x123456789LL, 1700000100, makeMetadata(50, 0));
+		TS_ASSERT(index.isDirty());
+
+		SaveIndex loaded;
+		TS_ASSERT(reload(index, loaded));
+		TS_ASSERT(!index.isDirty());
+		TS_ASSERT(!loaded.isDirty());
+
+		Common::Array<byte> metadata;
+		TS_ASSERT(loaded.get("game.000", 1234, 1700000000, metadata));
+		TS_ASSERT(metadata == makeMetadata(1, 16));
+		TS_ASSERT(loaded.get("GAME.001", 0x123456789LL, 1700000100, metadata));
+		TS_ASSERT(metadata.empty());
+		TS_ASSERT(!loaded.get("game.002", 1234, 1700000000, metadata));
+	}
+
+	void test_invalidation() {
+		SaveIndex index;
+		index.set("game.000", 1234, 1700000000, makeMetadata(1, 16));
+
+		// Files changed behind our back no longer match their entry
+		Common::Array<byte> metadata;
+		TS_ASSERT(!index.get("game.000", 1235, 1700000000, metadata));
+		TS_ASSERT(!index.get("game.000", 1234, 1700000001, metadata));
+		TS_ASSERT(index.get("game.000", 1234, 1700000000, metadata));
+
+		// Storing the metadata again updates the entry
+		index.set("game.000", 1235, 1700000001, makeMetadata(2, 8));
+		TS_ASSERT(index.get("game.000", 1235, 1700000001, metadata));
+		TS_ASSERT(metadata == makeMetadata(2, 8));
+		TS_ASSERT(!index.get("game.000", 1234, 1700000000, metadata));
+
+		SaveIndex loaded;
+		TS_ASSERT(reload(index, loaded));
+		TS_ASSERT(loaded.remove("game.000"));
+		TS_ASSERT(loaded.isDirty());
+		TS_ASSERT(!loaded.remove("game.000"));
+		TS_ASSERT(!loaded.get("game.000", 1235, 1700000001, metadata));
+		TS_ASSERT(loaded.empty());
+	}
+
+	void test_broken_index() {
+		SaveIndex index;
+		index.set("game.000", 1234, 1700000000, makeMetadata(1, 16));
+		index.set("game.001", 5678, 1700000100, makeMetadata(2, 16));
+
+		// A truncated index is dropped as a whole
+		SaveIndex loaded;
+		TS_ASSERT(!reload(index, loaded, 1));
+		TS_ASSERT(loaded.empty());
+
+		const byte garbage[] = { 'S', 'I', 'D', 'X', 1, 0, 0, 0, 0, 0 };
+		Common::MemoryReadStream in(garbage, sizeof(garbage));
+		TS_ASSERT(!loaded.load(in));
+		TS_ASSERT(loaded.empty());
+
+		// Names which do not fit the index are not stored
+		Common::String longName;
+		for (int i = 0; i < 0x100; i++)
+			longName += 'x';
+		index.set(longName, 1, 1, makeMetadata(3, 4));
+		TS_ASSERT(reload(index, loaded));
+		Common::Array<byte> metadata;
+		TS_ASSERT(!loaded.get(longName, 1, 1, metadata));
+		TS_ASSERT(loaded.get("game.001", 5678, 1700000100, metadata));
+	}
+};
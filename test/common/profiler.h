@@ -0,0 +1,65 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/profiler.h"
+
+#include "../null_osystem.h"
+
+class ProfilerTestSuite : public CxxTest::TestSuite {
+#ifdef ENABLE_PROFILER
+	static void outerZone(int innerCalls) {
+		PROFILE_ZONE("test::outer");
+		for (int i = 0; i < innerCalls; i++)
+			innerZone();
+	}
+
+	static void innerZone() {
+		PROFILE_ZONE_TRACK("test::inner", "test");
+	}
+
+	static const Common::Profiler::ZoneCounters *findZone(const Common::Array<Common::Profiler::ZoneCounters> &zones, const char *name) {
+		for (uint i = 0; i < zones.size(); i++) {
+			if (!strcmp(zones[i].name, name))
+				return &zones[i];
+		}
+		return nullptr;
+	}
+#endif
+
+public:
+	void test_zone_counters() {
+#if defined(ENABLE_PROFILER) && NULL_OSYSTEM_IS_AVAILABLE
+		Common::install_null_g_system();
+
+		Common::Profiler &profiler = Common::Profiler::instance();
+		profiler.resetCounters();
+
+		outerZone(3);
+		outerZone(2);
+
+		Common::Array<Common::Profiler::ZoneCounters> zones;
+		profiler.getCounters(zones);
+
+		const Common::Profiler::ZoneCounters *outer = findZone(zones, "test::outer");
+		const Common::Profiler::ZoneCounters *inner = findZone(zones, "test::inner");
+		TS_ASSERT(outer != nullptr);
+		TS_ASSERT(inner != nullptr);
+		if (!outer || !inner)
+			return;
+
+		TS_ASSERT_EQUALS(outer->calls, 2U);
+		TS_ASSERT_EQUALS(inner->calls, 5U);
+		TS_ASSERT_EQUALS(strcmp(outer->track, "main"), 0);
+		TS_ASSERT_EQUALS(strcmp(inner->track, "test"), 0);
+		TS_ASSERT(outer->maxTime <= outer->totalTime);
+
+		profiler.resetCounters();
+		profiler.getCounters(zones);
+		outer = findZone(zones, "test::outer");
+		TS_ASSERT(outer != nullptr);
+		if (outer) {
+			TS_ASSERT_EQUALS(outer->calls, 0U);
+			TS_ASSERT_EQUALS(outer->totalTime, 0U);
+		}
+#endif
+	}
+};
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+#include "test/instrset_detect.h"
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	// The width is not a multiple of eight so that the table path is used for the remainder
+	enum {
+		kWidth = 70,
+		kHeight = 10,
+		kYPitch = 72,
+		kUVPitch = 72
+	};
+
+	byte _y[kYPitch * kHeight];
+	byte _u[kUVPitch * kHeight];
+	byte _v[kUVPitch * kHeight];
+	byte _a[kYPitch * kHeight];
+
+	void fillPlanes() {
+		uint32 seed = 0x1234567;
+		for (int i = 0; i < kYPitch * kHeight; i++) {
+			seed = seed * 1103515245 + 12345;
+			_y[i] = seed >> 24;
+			_a[i] = seed >> 16;
+		}
+		for (int i = 0; i < kUVPitch * kHeight; i++) {
+			seed = seed * 1103515245 + 12345;
+			_u[i] = seed >> 24;
+			_v[i] = seed >> 16;
+		}
+
+		// Include the extreme values so that clipping is covered
+		_y[0] = 0; _u[0] = 0; _v[0] = 255;
+		_y[1] = 255; _u[1] = 255; _v[1] = 0;
+	}
+
+	static bool areSurfacesEqual(const Graphics::Surface &a, const Graphics::Surface &b) {
+		for (int y = 0; y < a.h; y++) {
+			if (memcmp(a.getBasePtr(0, y), b.getBasePtr(0, y), a.w * a.format.bytesPerPixel) != 0)
+				return false;
+		}
+		return true;
+	}
+
+	void compareConversions(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		Graphics::Surface reference, simd;
+		reference.create(kWidth, kHeight, format);
+		simd.create(kWidth, kHeight, format);
+
+		for (int mode = 0; mode < 4; mode++) {
+			for (int pass = 0; pass < 2; pass++) {
+				Graphics::Surface &dst = (pass == 0) ? reference : simd;
+				YUVToRGBMan.setSIMDEnabled(pass == 1);
+
+				switch (mode) {
+				case 0:
+					YUVToRGBMan.convert444(&dst, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+					break;
+				case 1:
+					YUVToRGBMan.convert422(&dst, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+					break;
+				case 2:
+					YUVToRGBMan.convert420(&dst, scale, _y, _u, _v, kWidth, kHeight, kYPitch, kUVPitch);
+					break;
+				default:
+					YUVToRGBMan.convert420Alpha(&dst, scale, _y, _u, _v, _a, kWidth, kHeight, kYPitch, kUVPitch);
+					break;
+				}
+			}
+
+			TS_ASSERT(areSurfacesEqual(reference, simd));
+		}
+
+		reference.free();
+		simd.free();
+	}
+
+public:
+	void tearDown() {
+		YUVToRGBMan.resetSIMDEnabled();
+	}
+
+	void test_simd_matches_lookup() {
+#ifdef SCUMMVM_SSE2
+		if (instrset_detect() < 2)
+			return;
+
+		fillPlanes();
+
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 5, 5, 5, 1, 10, 5, 0, 15),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0)
+		};
+
+		for (uint i = 0; i < ARRAYSIZE(formats); i++) {
+			compareConversions(formats[i], Graphics::YUVToRGBManager::kScaleFull);
+			compareConversions(formats[i], Graphics::YUVToRGBManager::kScaleITU);
+		}
+#endif
+	}
+};
@@ -0,0 +1,143 @@
+#include <cxxtest/TestSuite.h>
+
+#include "video/video_decoder.h"
+
+#include "graphics/surface.h"
+
+class VideoDecoderTestSuite : public CxxTest::TestSuite {
+	static const int kFrameCount = 8;
+	static const int kFrameRate = 10;
+
+	class TestVideoDecoder : public Video::VideoDecoder {
+	public:
+		bool loadStream(Common::SeekableReadStream *stream) override {
+			addTrack(new TestVideoTrack());
+			return true;
+		}
+
+	private:
+		// Every frame is filled with its own frame number
+		class TestVideoTrack : public Video::VideoDecoder::FixedRateVideoTrack {
+		public:
+			TestVideoTrack() : _curFrame(-1) { _surface.create(4, 4, Graphics::PixelFormat::createFormatCLUT8()); }
+			~TestVideoTrack() { _surface.free(); }
+
+			bool endOfTrack() const override { return _curFrame >= kFrameCount - 1; }
+			uint16 getWidth() const override { return _surface.w; }
+			uint16 getHeight() const override { return _surface.h; }
+			Graphics::PixelFormat getPixelFormat() const override { return _surface.format; }
+			int getCurFrame() const override { return _curFrame; }
+			int getFrameCount() const override { return kFrameCount; }
+
+			const Graphics::Surface *decodeNextFrame() override {
+				_curFrame++;
+				_surface.fillRect(Common::Rect(_surface.w, _surface.h), _curFrame);
+				return &_surface;
+			}
+
+		protected:
+			Common::Rational getFrameRate() const override { return Common::Rational(kFrameRate); }
+
+		private:
+			Graphics::Surface _surface;
+			int _curFrame;
+		};
+	};
+
+	static void startFrozen(TestVideoDecoder &video, uint lookAhead) {
+		video.loadStream(nullptr);
+		TS_ASSERT(video.setLookAhead(lookAhead));
+		video.start();
+
+		// Keep the playback time from moving while the frames are checked
+		video.pauseVideo(true);
+	}
+
+	static uint32 frameTime(int frame) {
+		return frame * 1000 / kFrameRate;
+	}
+
+public:
+	void test_frame_order() {
+		TestVideoDecoder plain, ahead;
+		startFrozen(plain, 0);
+		startFrozen(ahead, 4);
+		TS_ASSERT_EQUALS(ahead.getLookAhead(), 4u);
+
+		// Nothing is decoded ahead of a frame which is already due
+		TS_ASSERT(ahead.needsUpdate());
+		TS_ASSERT(!ahead.decodeAhead());
+		TS_ASSERT(!plain.decodeAhead());
+
+		for (int i = 0; i < kFrameCount; i++) {
+			// Fill the queue while waiting for the next frame
+			if (i > 0) {
+				while (ahead.decodeAhead())
+					;
+				TS_ASSERT_EQUALS(ahead.getCurFrame(), i - 1);
+			}
+
+			TS_ASSERT(!plain.endOfVideo());
+			TS_ASSERT(!ahead.endOfVideo());
+
+			const Graphics::Surface *plainFrame = plain.decodeNextFrame();
+			const Graphics::Surface *aheadFrame = ahead.decodeNextFrame();
+			TS_ASSERT(plainFrame && aheadFrame);
+			TS_ASSERT_EQUALS(*(const byte *)plainFrame->getPixels(), i);
+			TS_ASSERT_EQUALS(*(const byte *)aheadFrame->getPixels(), i);
+
+			TS_ASSERT_EQUALS(plain.getCurFrame(), i);
+			TS_ASSERT_EQUALS(ahead.getCurFrame(), i);
+
+			// The next frame is due at the same time either way
+			if (i < kFrameCount - 1) {
+				TS_ASSERT_EQUALS(plain.getTime() + plain.getTimeToNextFrame(), frameTime(i + 1));
+				TS_ASSERT_EQUALS(ahead.getTime() + ahead.getTimeToNextFrame(), frameTime(i + 1));
+				TS_ASSERT(!plain.needsUpdate());
+				TS_ASSERT(!ahead.needsUpdate());
+			}
+		}
+
+		TS_ASSERT(plain.endOfVideo());
+		TS_ASSERT(ahead.endOfVideo());
+		TS_ASSERT(!ahead.decodeAhead());
+
+		// Only the first frame had to be decoded when it was due
+		Video::VideoDecoder::LookAheadStats stats = ahead.getLookAheadStats();
+		TS_ASSERT_EQUALS(stats.framesQueued, (uint32)kFrameCount - 1);
+		TS_ASSERT_EQUALS(stats.lateFrames, 1u);
+		TS_ASSERT_EQUALS(stats.droppedFrames, 0u);
+		TS_ASSERT_EQUALS(stats.maxQueueDepth, 4u);
+		TS_ASSERT_EQUALS(stats.queueDepth, 0u);
+	}
+
+	void test_queue_runs_dry() {
+		TestVideoDecoder video;
+		startFrozen(video, 2);
+
+		TS_ASSERT(video.decodeNextFrame());
+		TS_ASSERT(video.decodeAhead());
+		TS_ASSERT(video.decodeAhead());
+		TS_ASSERT(!video.decodeAhead());
+		TS_ASSERT_EQUALS(video.getLookAheadStats().queueDepth, 2u);
+
+		// Frames are handed out in order, and decoded on demand once the
+		// queue is empty
+		for (int i = 1; i < 4; i++) {
+			const Graphics::Surface *frame = video.decodeNextFrame();
+			TS_ASSERT(frame);
+			TS_ASSERT_EQUALS(*(const byte *)frame->getPixels(), i);
+			TS_ASSERT_EQUALS(video.getCurFrame(), i);
+			TS_ASSERT_EQUALS(video.getTime() + video.getTimeToNextFrame(), frameTime(i + 1));
+		}
+
+		TS_ASSERT_EQUALS(video.getLookAheadStats().lateFrames, 2u);
+
+		// Disabling look-ahead leaves the decoder playing normally
+		TS_ASSERT(video.setLookAhead(0));
+		TS_ASSERT(!video.decodeAhead());
+		const Graphics::Surface *frame = video.decodeNextFrame();
+		TS_ASSERT(frame);
+		TS_ASSERT_EQUALS(*(const byte *)frame->getPixels(), 4);
+	}
+};
@@ -162,6 +162,14 @@ void PacoDecoder::copyDirtyRectsToBuffer(uint8 *dst, uint pitch) {
 }
 
 const byte* PacoDecoder::getPalette(){
+	// With look-ahead decoding, the track's palette may already belong to a
+	// queued frame, so use the one handed out with the displayed frame
+	if (getLookAhead()) {
+		const byte *palette = VideoDecoder::getPalette();
+		if (palette)
+			return palette;
+	}
+
 	Track *track = getTrack(0);
 
 	if (track)
@@ -26,6 +26,7 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 namespace Video {
@@ -47,12 +48,25 @@ VideoDecoder::VideoDecoder() {
 	_mainAudioTrack = 0;
 	_canSetDither = true;
 	_canSetDefaultFormat = true;
+
+	_lookAheadSize = 0;
+	_lookAheadHead = 0;
+	_lookAheadCount = 0;
+	_lookAheadCurFrame = -1;
+	memset(&_lookAheadStats, 0, sizeof(_lookAheadStats));
+}
+
+VideoDecoder::~VideoDecoder() {
+	freeLookAhead();
 }
 
 void VideoDecoder::close() {
 	if (isPlaying())
 		stop();
 
+	freeLookAhead();
+	_lookAheadSize = 0;
+
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		delete *it;
 
@@ -105,7 +119,10 @@ bool VideoDecoder::needsUpdate() const {
 		}
 	}
 	if (hasVideo) {
-		return hasFramesLeft() && getTimeToNextFrame() == 0;
+		if (!hasFramesLeft())
+			return false;
+
+		return getTimeToNextFrame() == 0;
 	} else if (hasAudio) {
 		return !endOfVideo();
 	}
@@ -200,10 +217,19 @@ Graphics::PixelFormat VideoDecoder::getPixelFormat() const {
 }
 
 const Graphics::Surface *VideoDecoder::decodeNextFrame() {
+	PROFILE_ZONE("VideoDecoder::decodeNextFrame");
+
 	_needsUpdate = false;
 	_canSetDither = false;
 	_canSetDefaultFormat = false;
 
+	if (_lookAheadCount)
+		return popLookAheadFrame();
+
+	// The queue ran dry, so this frame has to be decoded now
+	if (_lookAheadSize)
+		_lookAheadStats.lateFrames++;
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -229,6 +255,10 @@ bool VideoDecoder::setReverse(bool reverse) {
 	if (reverse && hasAudio())
 		return false;
 
+	// Look-ahead decoding only works forward
+	if (reverse && _lookAheadSize)
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -249,6 +279,10 @@ const byte *VideoDecoder::getPalette() {
 }
 
 int VideoDecoder::getCurFrame() const {
+	// The tracks are already past the frames decoded ahead
+	if (_lookAheadCount)
+		return _lookAheadCurFrame;
+
 	int32 frame = -1;
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
@@ -290,7 +324,17 @@ uint32 VideoDecoder::getTime() const {
 }
 
 uint32 VideoDecoder::getTimeToNextFrame() const {
-	if (endOfVideo() || _needsUpdate || !_nextVideoTrack)
+	if (endOfVideo() || _needsUpdate)
+		return 0;
+
+	// Frames decoded ahead are shown before the ones left in the tracks
+	if (_lookAheadCount) {
+		uint32 queuedTime = getTime();
+		uint32 queuedStartTime = _lookAheadQueue[_lookAheadHead].startTime;
+		return (queuedStartTime > queuedTime) ? queuedStartTime - queuedTime : 0;
+	}
+
+	if (!_nextVideoTrack)
 		return 0;
 
 	uint32 currentTime = getTime();
@@ -312,6 +356,10 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 }
 
 bool VideoDecoder::endOfVideo() const {
+	// Frames still waiting in the look-ahead queue have yet to be shown
+	if (_lookAheadCount)
+		return false;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
@@ -339,6 +387,9 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	// The queued frames are no longer valid
+	clearLookAhead();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -373,6 +424,9 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	// The queued frames are no longer valid
+	clearLookAhead();
+
 	// Stop all tracks so they can be seek'ed
 	if (isPlaying())
 		stopAudio();
@@ -1009,6 +1063,9 @@ bool VideoDecoder::hasFramesLeft() const {
 	// This is similar to endOfVideo(), except it doesn't take Audio into account (and returns true if not the end of the video)
 	// This is only used for needsUpdate() atm so that setEndTime() works properly
 	// And unlike endOfVideoTracks(), this takes into account _endTime
+	if (_lookAheadCount)
+		return true;
+
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
 			continue;
@@ -1049,4 +1106,156 @@ void VideoDecoder::eraseTrack(Track *track) {
 	}
 }
 
+bool VideoDecoder::setLookAhead(uint frames) {
+	if (frames == _lookAheadSize)
+		return true;
+
+	// The tracks have already moved past the queued frames, so these can
+	// only be thrown away if the tracks can be taken back to the first one.
+	if (_lookAheadCount && !seek(Audio::Timestamp(_lookAheadQueue[_lookAheadHead].startTime, 1000)))
+		return false;
+
+	freeLookAhead();
+	_lookAheadSize = 0;
+
+	if (frames == 0)
+		return true;
+
+	// Only videos with a single video track played forward are supported
+	VideoTrack *videoTrack = 0;
+	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+		if ((*it)->getTrackType() != Track::kTrackTypeVideo)
+			continue;
+
+		if (videoTrack || ((VideoTrack *)*it)->isReversed())
+			return false;
+
+		videoTrack = (VideoTrack *)*it;
+	}
+
+	if (!videoTrack)
+		return false;
+
+	_lookAheadSize = frames;
+	_lookAheadQueue.resize(frames);
+	for (uint i = 0; i < frames; i++) {
+		_lookAheadQueue[i].startTime = 0;
+		_lookAheadQueue[i].frame = -1;
+		_lookAheadQueue[i].dirtyPalette = false;
+	}
+
+	memset(&_lookAheadStats, 0, sizeof(_lookAheadStats));
+	return true;
+}
+
+VideoDecoder::LookAheadStats VideoDecoder::getLookAheadStats() const {
+	LookAheadStats stats = _lookAheadStats;
+	stats.queueDepth = _lookAheadCount;
+	return stats;
+}
+
+void VideoDecoder::clearLookAhead() {
+	_lookAheadHead = 0;
+	_lookAheadCount = 0;
+}
+
+void VideoDecoder::freeLookAhead() {
+	clearLookAhead();
+
+	for (uint i = 0; i < _lookAheadQueue.size(); i++)
+		_lookAheadQueue[i].surface.free();
+
+	_lookAheadQueue.clear();
+	_lookAheadSurface.free();
+}
+
+bool VideoDecoder::decodeAhead() {
+	// A frame which is already due has to be shown, not queued
+	if (!_lookAheadSize || needsUpdate())
+		return false;
+
+	return decodeLookAheadFrame();
+}
+
+bool VideoDecoder::decodeLookAheadFrame() {
+	if (!isPlaying() || _lookAheadCount >= _lookAheadSize)
+		return false;
+
+	VideoTrack *track = _nextVideoTrack;
+	if (!track || track->endOfTrack())
+		return false;
+
+	uint32 startTime = track->getNextFrameStartTime();
+	if (_endTimeSet && startTime >= (uint)_endTime.msecs())
+		return false;
+
+	// Remember the displayed frame before the tracks move past it
+	if (!_lookAheadCount)
+		_lookAheadCurFrame = getCurFrame();
+
+	readNextPacket();
+
+	const Graphics::Surface *frame = track->decodeNextFrame();
+	if (!frame)
+		return false;
+
+	LookAheadFrame &entry = _lookAheadQueue[(_lookAheadHead + _lookAheadCount) % _lookAheadSize];
+
+	if (entry.surface.w != frame->w || entry.surface.h != frame->h || entry.surface.format != frame->format) {
+		entry.surface.free();
+		entry.surface.create(frame->w, frame->h, frame->format);
+	}
+	entry.surface.copyRectToSurface(*frame, 0, 0, Common::Rect(frame->w, frame->h));
+
+	entry.startTime = startTime;
+	entry.frame = track->getCurFrame();
+	entry.dirtyPalette = track->hasDirtyPalette();
+	if (entry.dirtyPalette)
+		memcpy(entry.palette, track->getPalette(), sizeof(entry.palette));
+
+	findNextVideoTrack();
+
+	_lookAheadCount++;
+	_lookAheadStats.framesQueued++;
+	_lookAheadStats.maxQueueDepth = MAX(_lookAheadStats.maxQueueDepth, _lookAheadCount);
+	return true;
+}
+
+const Graphics::Surface *VideoDecoder::popLookAheadFrame() {
+	uint32 time = getTime();
+
+	// Skip frames which have already been superseded by the next one
+	while (_lookAheadCount > 1 && _lookAheadQueue[(_lookAheadHead + 1) % _lookAheadSize].startTime <= time) {
+		LookAheadFrame &dropped = _lookAheadQueue[_lookAheadHead];
+
+		// Don't lose palette changes along with the frame
+		if (dropped.dirtyPalette) {
+			memcpy(_lookAheadPalette, dropped.palette, sizeof(_lookAheadPalette));
+			_palette = _lookAheadPalette;
+			_dirtyPalette = true;
+		}
+
+		_lookAheadHead = (_lookAheadHead + 1) % _lookAheadSize;
+		_lookAheadCount--;
+		_lookAheadStats.droppedFrames++;
+	}
+
+	LookAheadFrame &entry = _lookAheadQueue[_lookAheadHead];
+
+	// Hand out the queued surface and recycle the previously displayed one
+	SWAP(entry.surface, _lookAheadSurface);
+
+	if (entry.dirtyPalette) {
+		memcpy(_lookAheadPalette, entry.palette, sizeof(_lookAheadPalette));
+		_palette = _lookAheadPalette;
+		_dirtyPalette = true;
+	}
+
+	_lookAheadCurFrame = entry.frame;
+	_lookAheadHead = (_lookAheadHead + 1) % _lookAheadSize;
+	_lookAheadCount--;
+
+	return &_lookAheadSurface;
+}
+
 } // End of namespace Video
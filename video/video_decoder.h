@@ -29,6 +29,7 @@
 #include "common/rational.h"
 #include "common/str.h"
 #include "graphics/pixelformat.h"
+#include "graphics/surface.h"
 
 namespace Audio {
 class AudioStream;
@@ -40,10 +41,6 @@ namespace Common {
 class SeekableReadStream;
 }
 
-namespace Graphics {
-struct Surface;
-}
-
 namespace Video {
 
 /**
@@ -52,7 +49,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -400,6 +397,65 @@ public:
 	 */
 	bool setOutputPixelFormat(const Graphics::PixelFormat &format);
 
+	/////////////////////////////////////////
+	// Look-Ahead Decoding
+	/////////////////////////////////////////
+
+	/**
+	 * Statistics of the look-ahead frame queue.
+	 */
+	struct LookAheadStats {
+		uint queueDepth;      ///< Number of frames currently waiting in the queue
+		uint maxQueueDepth;   ///< Highest number of frames queued at once
+		uint32 framesQueued;  ///< Number of frames decoded ahead of time
+		uint32 lateFrames;    ///< Number of frames that had to be decoded synchronously
+		uint32 droppedFrames; ///< Number of frames skipped because playback was behind
+	};
+
+	/**
+	 * Decode frames ahead of playback time.
+	 *
+	 * When enabled, callers can use the time between frames to decode frames
+	 * into a bounded queue by calling decodeAhead() while they wait for the
+	 * next frame. decodeNextFrame() then only hands out the next queued
+	 * frame. If playback falls behind, frames whose successor is already due
+	 * are dropped.
+	 *
+	 * Look-ahead decoding is only available for videos with exactly one video
+	 * track played forward, and for decoders which do not need to access
+	 * their tracks from decodeNextFrame() after calling this class'
+	 * implementation.
+	 *
+	 * Frames already queued are kept when playback is stopped. Changing the
+	 * queue size while frames are queued requires the video to be seekable.
+	 *
+	 * @param frames  the number of frames to decode ahead, or 0 to disable
+	 * @return true on success, false otherwise
+	 */
+	bool setLookAhead(uint frames);
+
+	/**
+	 * Return the number of frames decoded ahead, or 0 when look-ahead
+	 * decoding is disabled.
+	 */
+	uint getLookAhead() const { return _lookAheadSize; }
+
+	/**
+	 * Decode one frame into the look-ahead queue.
+	 *
+	 * Nothing is decoded if look-ahead decoding is disabled, the queue is
+	 * full or the next frame is already due. This is meant to be called
+	 * while needsUpdate() returns false, and decodes on the calling thread.
+	 *
+	 * @return true if a frame was queued, false otherwise
+	 */
+	bool decodeAhead();
+
+	/**
+	 * Return the statistics of the look-ahead frame queue.
+	 */
+	LookAheadStats getLookAheadStats() const;
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -1005,6 +1061,29 @@ private:
 	Audio::Mixer::SoundType _soundType;
 
 	AudioTrack *_mainAudioTrack;
+
+	// Look-ahead decoding
+	struct LookAheadFrame {
+		Graphics::Surface surface;
+		uint32 startTime;
+		int frame;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+	};
+
+	const Graphics::Surface *popLookAheadFrame();
+	bool decodeLookAheadFrame();
+	void clearLookAhead();
+	void freeLookAhead();
+
+	Common::Array<LookAheadFrame> _lookAheadQueue;
+	uint _lookAheadSize;
+	uint _lookAheadHead;
+	uint _lookAheadCount;
+	int _lookAheadCurFrame;
+	Graphics::Surface _lookAheadSurface;
+	byte _lookAheadPalette[256 * 3];
+	LookAheadStats _lookAheadStats;
 };
 
 } // End of namespace Video